@@ -16,9 +16,11 @@ namespace lgr {
 
 template <class Ordinal>
 class CrsLinearProblem {
- private:
+ public:
   typedef Kokkos::View<Scalar *, MemSpace>          Vector;
+  // one right-hand side (or solution) per row
   typedef Kokkos::View<Scalar **, Kokkos::LayoutRight, MemSpace>         MultiVector;
+ private:
   typedef CrsMatrix<Ordinal, int> Matrix;
 
   Matrix _A;
@@ -2,11 +2,15 @@
 
 namespace lgr {
 
-// For CrsMatrix A, sets b := Ax
+// b := Ax for a matrix of BlockSize x BlockSize blocks.  With the block size
+// known at compile time the per-block loops are fully unrolled, the segment of
+// x that a block multiplies and the partial sums of the block row both stay in
+// registers, and the dense block product can be vectorized.
 template <
+    int BlockSize,
     class Ordinal,
     class RowMapEntryType>
-void ApplyCrsMatrix(
+static void ApplyBlockCrsMatrix(
     const CrsMatrix<Ordinal, RowMapEntryType> A,
     const typename CrsMatrix<
         Ordinal,
@@ -15,24 +19,97 @@ void ApplyCrsMatrix(
         Ordinal,
         RowMapEntryType>::ScalarVector b) {
   auto rowMap = A.rowMap();
-  auto numRows = rowMap.size() - 1;
+  auto numBlockRows = rowMap.size() - 1;
   auto columnIndices = A.columnIndices();
   auto entries = A.entries();
   Kokkos::parallel_for(
-      Kokkos::RangePolicy<int>(0, numRows),
-      LAMBDA_EXPRESSION(int rowOrdinal) {
-        auto   rowStart = rowMap(rowOrdinal);
-        auto   rowEnd = rowMap(rowOrdinal + 1);
-        Scalar sum = 0.0;
+      Kokkos::RangePolicy<int>(0, numBlockRows),
+      LAMBDA_EXPRESSION(int blockRowOrdinal) {
+        auto   rowStart = rowMap(blockRowOrdinal);
+        auto   rowEnd = rowMap(blockRowOrdinal + 1);
+        Scalar sum[BlockSize];
+        for (int i = 0; i < BlockSize; i++) sum[i] = 0.0;
         for (auto entryIndex = rowStart; entryIndex < rowEnd; entryIndex++) {
-          auto columnIndex = columnIndices(entryIndex);
-          sum += entries(entryIndex) * x(columnIndex);
+          auto   columnOffset = BlockSize * columnIndices(entryIndex);
+          auto   blockOffset = BlockSize * BlockSize * entryIndex;
+          Scalar xBlock[BlockSize];
+          for (int j = 0; j < BlockSize; j++) xBlock[j] = x(columnOffset + j);
+          for (int i = 0; i < BlockSize; i++) {
+            for (int j = 0; j < BlockSize; j++) {
+              sum[i] += entries(blockOffset + i * BlockSize + j) * xBlock[j];
+            }
+          }
         }
-        b(rowOrdinal) = sum;
+        auto rowOffset = BlockSize * blockRowOrdinal;
+        for (int i = 0; i < BlockSize; i++) b(rowOffset + i) = sum[i];
       },
       "CrsMatrix Apply()");
 }
 
+// b := Ax for any block shape; blocks are stored row-major
+template <
+    class Ordinal,
+    class RowMapEntryType>
+static void ApplyGeneralBlockCrsMatrix(
+    const CrsMatrix<Ordinal, RowMapEntryType> A,
+    const typename CrsMatrix<
+        Ordinal,
+        RowMapEntryType>::ScalarVector x,
+    const typename CrsMatrix<
+        Ordinal,
+        RowMapEntryType>::ScalarVector b) {
+  auto rowMap = A.rowMap();
+  auto numBlockRows = rowMap.size() - 1;
+  auto columnIndices = A.columnIndices();
+  auto entries = A.entries();
+  const int blockSizeRow = A.blockSizeRow();
+  const int blockSizeCol = A.blockSizeCol();
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<int>(0, numBlockRows),
+      LAMBDA_EXPRESSION(int blockRowOrdinal) {
+        auto rowStart = rowMap(blockRowOrdinal);
+        auto rowEnd = rowMap(blockRowOrdinal + 1);
+        for (int i = 0; i < blockSizeRow; i++) {
+          Scalar sum = 0.0;
+          for (auto entryIndex = rowStart; entryIndex < rowEnd; entryIndex++) {
+            auto columnOffset = blockSizeCol * columnIndices(entryIndex);
+            auto blockOffset = (blockSizeRow * entryIndex + i) * blockSizeCol;
+            for (int j = 0; j < blockSizeCol; j++) {
+              sum += entries(blockOffset + j) * x(columnOffset + j);
+            }
+          }
+          b(blockSizeRow * blockRowOrdinal + i) = sum;
+        }
+      },
+      "CrsMatrix Apply()");
+}
+
+// For CrsMatrix A, sets b := Ax
+template <
+    class Ordinal,
+    class RowMapEntryType>
+void ApplyCrsMatrix(
+    const CrsMatrix<Ordinal, RowMapEntryType> A,
+    const typename CrsMatrix<
+        Ordinal,
+        RowMapEntryType>::ScalarVector x,
+    const typename CrsMatrix<
+        Ordinal,
+        RowMapEntryType>::ScalarVector b) {
+  if (A.blockSizeRow() == A.blockSizeCol()) {
+    switch (A.blockSizeRow()) {
+      case 1: ApplyBlockCrsMatrix<1>(A, x, b); return;
+      case 2: ApplyBlockCrsMatrix<2>(A, x, b); return;
+      case 3: ApplyBlockCrsMatrix<3>(A, x, b); return;
+      case 4: ApplyBlockCrsMatrix<4>(A, x, b); return;
+      case 5: ApplyBlockCrsMatrix<5>(A, x, b); return;
+      case 6: ApplyBlockCrsMatrix<6>(A, x, b); return;
+      default: break;
+    }
+  }
+  ApplyGeneralBlockCrsMatrix(A, x, b);
+}
+
 #define LGR_EXPL_INST(Ordinal, RowMapEntryType) \
 template \
 void ApplyCrsMatrix( \
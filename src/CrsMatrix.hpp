@@ -50,9 +50,9 @@ class CrsMatrix {
   bool _isBlockMatrix;
 
  public:
-  decltype(_isBlockMatrix) isBlockMatrix(){return _isBlockMatrix;}
-  decltype(_blockSizeRow)  blockSizeRow(){return _blockSizeRow;}
-  decltype(_blockSizeCol)  blockSizeCol(){return _blockSizeCol;}
+  decltype(_isBlockMatrix) isBlockMatrix() const {return _isBlockMatrix;}
+  decltype(_blockSizeRow)  blockSizeRow() const {return _blockSizeRow;}
+  decltype(_blockSizeCol)  blockSizeCol() const {return _blockSizeCol;}
 
   CrsMatrix() {}
 
@@ -76,6 +76,8 @@ class CrsMatrix {
   }
   KOKKOS_INLINE_FUNCTION const ScalarVector entries() const { return _entries; }
 
+  // b := Ax; block matrices are applied block by block, with kernels
+  // specialized for square blocks of size 1 through 6
   void Apply(const ScalarVector x, const ScalarVector b) {
     ApplyCrsMatrix<Ordinal, RowMapEntryType>(
         *this, x, b);
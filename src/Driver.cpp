@@ -458,6 +458,7 @@ void run(
   }
 
   Scalar lastEMSolveTime = -1e12;
+  PerformanceData runPerformance;
   while ((cycle < max_num_steps) && (current_time < terminationTime)) {
 
     //cycle the states
@@ -465,13 +466,14 @@ void run(
     ++next_state;
     next_state %= NumStates;
 
-    lagrangianStep.advanceTime(
+    auto stepPerformance = lagrangianStep.advanceTime(
         accel_contribs,
         internal_force_contribs,
         current_time,
         dt,
         current_state,
         next_state);
+    runPerformance.add(stepPerformance);
 
     check_densities(
         machine, *mesh_fields, next_state, min_mass_density_allowed,
@@ -725,6 +727,8 @@ void run(
 
   }  //end while ( (step<max_num_steps) && (current_time<terminationTime) )
 
+  if (0 == comm::rank(machine)) runPerformance.print(std::cout);
+
   if (problem.isSublist("Scatterplots")) {
     auto &sps_pl = problem.sublist("Scatterplots");
     for (auto it = sps_pl.begin(), end = sps_pl.end(); it != end; ++it) {
@@ -9,6 +9,7 @@
 #include "ApplyConstraints.hpp"
 
 #include "CrsMatrix.hpp"
+#include "NativeSparseLinearProblem.hpp"
 
 #ifdef HAVE_VIENNA_CL
 #include "ViennaSparseLinearProblem.hpp"
@@ -69,7 +70,14 @@ void ElastostaticSolve<SpaceDim>::initialize()
     auto mesh = m_meshFields->femesh.omega_h_mesh;
 
     Plato::RowMapEntryType numRows;
-    if(m_useBlockMatrix)
+    if(m_matrixFree)
+    {
+        Plato::CellColoring coloring = m_coloredAssembly ? Plato::CellColoring(*mesh) : Plato::CellColoring();
+        m_matrixFreeStiffness = Teuchos::rcp(
+                new Plato::MatrixFreeStiffness<SpaceDim>(mesh, m_materialModel->getStiffnessMatrix(), coloring));
+        numRows = m_matrixFreeStiffness->numDofs();
+    }
+    else if(m_useBlockMatrix)
     {
         m_matrix = Plato::CreateBlockMatrix<CrsMatrixType, SpaceDim>(mesh);
         numRows = SpaceDim * (m_matrix->rowMap().size() - 1);
@@ -92,9 +100,16 @@ ElastostaticSolve<SpaceDim>::ElastostaticSolve(Teuchos::ParameterList const& par
                                                lgr::comm::Machine machine) :
         m_machine(machine),
         m_meshFields(meshFields),
-        m_useBlockMatrix(paramList.get<bool>("Use Block Matrix"))
+        m_useBlockMatrix(paramList.get<bool>("Use Block Matrix")),
+        m_matrixFree(paramList.isParameter("Matrix Free") ? paramList.get<bool>("Matrix Free") : false),
+        m_coloredAssembly(paramList.isParameter("Colored Assembly") ? paramList.get<bool>("Colored Assembly") : false)
 /******************************************************************************/
 {
+    if(paramList.isSublist("Linear Solver"))
+    {
+        m_solverParams = paramList.sublist("Linear Solver");
+    }
+
     m_bcDofs = Plato::LocalOrdinalVector("BC dofs", 0);
     m_bcValues = Plato::ScalarVector("BC values", 0);
 
@@ -107,7 +122,13 @@ template<int SpaceDim>
 void ElastostaticSolve<SpaceDim>::assemble()
 /******************************************************************************/
 {
-    if(m_useBlockMatrix)
+    if(m_matrixFree)
+    {
+        m_matrixFreeStiffness->setConstraints(m_bcDofs);
+        m_matrixFreeStiffness->liftConstraints(m_rhs, m_bcDofs, m_bcValues);
+        m_matrix = m_matrixFreeStiffness->diagonalBlocks();
+    }
+    else if(m_useBlockMatrix)
     {
         computeGlobalStiffness<BlockMatrixEntryOrdinal>();
         Plato::applyBlockConstraints<SpaceDim>(m_matrix, m_rhs, m_bcDofs, m_bcValues);
@@ -182,19 +203,17 @@ typedef lgr::CrsLinearProblem<Plato::OrdinalType> CrsLinearSolver;
 
 template<int spaceDim>
 Teuchos::RCP<CrsLinearSolver>
-#if defined HAVE_AMGX
 ElastostaticSolve<spaceDim>::getDefaultSolver(double tol, int maxIters)
-#elif defined HAVE_TPETRA
-ElastostaticSolve<spaceDim>::getDefaultSolver(double /*tol*/, int /*maxIters*/)
-#elif defined HAVE_VIENNA_CL
-ElastostaticSolve<spaceDim>::getDefaultSolver(double tol, int maxIters)
-#else
-ElastostaticSolve<spaceDim>::getDefaultSolver(double /*tol*/, int /*maxIters*/)
-#endif
 {
     Teuchos::RCP<CrsLinearSolver> solver;
 
+    // the built-in solver is used when the input asks for it,
+    // or when lgr was built without any of the solver packages
+    // (the matrix-free operator only works with the built-in solver)
+    const bool useNativeSolver = m_matrixFree || (m_solverParams.get<std::string>("Package", "") == "native");
+
 #ifdef HAVE_AMGX
+    if (!useNativeSolver)
     {
 
         std::string configString;
@@ -232,7 +251,7 @@ ElastostaticSolve<spaceDim>::getDefaultSolver(double /*tol*/, int /*maxIters*/)
 #endif
     
 #ifdef HAVE_TPETRA
-    if (solver == Teuchos::null)
+    if (solver == Teuchos::null && !useNativeSolver)
     {
         typedef TpetraSparseLinearProblem<Scalar, Ordinal, DefaultLayout, Space> TpetraSolver;
 
@@ -243,7 +262,7 @@ ElastostaticSolve<spaceDim>::getDefaultSolver(double /*tol*/, int /*maxIters*/)
 #endif
     
 #ifdef HAVE_VIENNA_CL
-    if (solver == Teuchos::null)
+    if (solver == Teuchos::null && !useNativeSolver)
     {
         typedef ViennaSparseLinearProblem<Scalar, OrdinalType, DefaultLayout, DefaultSpace> ViennaSolver;
         auto viennaSolver = new ViennaSolver(*m_matrix,m_lhs,m_rhs);
@@ -255,8 +274,25 @@ ElastostaticSolve<spaceDim>::getDefaultSolver(double /*tol*/, int /*maxIters*/)
 
     if(solver == Teuchos::null)
     {
-        std::cout
-                << "WARNING: it looks like lgr was built without any compatible solvers (AmgX, ViennaCL).  Returning a null solver...\n";
+        typedef lgr::NativeSparseLinearProblem<Plato::OrdinalType> NativeSolver;
+        // elasticity is symmetric positive definite, so CG with the nodal
+        // blocks inverted is a good default; the sublist can override it
+        Teuchos::ParameterList params;
+        params.set("Tolerance", tol);
+        params.set("Maximum Iterations", maxIters);
+        params.set("Preconditioner", std::string(m_useBlockMatrix ? "Block Jacobi" : "Jacobi"));
+        params.setParameters(m_solverParams);
+        params.remove("Package", false);
+        auto nativeSolver = Teuchos::rcp(new NativeSolver(*m_matrix, m_lhs, m_rhs, params));
+        if(m_matrixFree)
+        {
+            auto stiffness = m_matrixFreeStiffness;
+            nativeSolver->setOperator([stiffness](const Plato::ScalarVector x, const Plato::ScalarVector y)
+            {
+                stiffness->applyConstrained(x, y);
+            });
+        }
+        solver = nativeSolver;
     }
     return solver;
 
@@ -15,6 +15,7 @@
 
 #include "ImplicitFunctors.hpp"
 #include "LinearElasticMaterial.hpp"
+#include "MatrixFreeStiffness.hpp"
 
 namespace Plato {
 
@@ -32,6 +33,10 @@ namespace LinearElastostatics {
       \sigma = C \epsilon\\
       \epsilon = \nabla_s u
     \f}
+
+    With "Matrix Free" set, the stiffness is not assembled: the solver applies
+    it element by element (see MatrixFreeStiffness) and only its nodal diagonal
+    blocks are assembled, for the preconditioner.  This needs the native solver.
   */
   template<int SpatialDim>
   class ElastostaticSolve
@@ -53,6 +58,8 @@ namespace LinearElastostatics {
     Plato::ScalarVector       m_bcValues;
 
     Teuchos::RCP<Plato::LinearElasticMaterial<SpatialDim>> m_materialModel;
+
+    Teuchos::RCP<Plato::MatrixFreeStiffness<SpatialDim>> m_matrixFreeStiffness;
     
   public:
 
@@ -70,6 +77,11 @@ namespace LinearElastostatics {
     Teuchos::RCP<DefaultFields> m_meshFields;
 
     const bool m_useBlockMatrix;
+    const bool m_matrixFree;
+    const bool m_coloredAssembly; // matrix-free scatter by cell color instead of atomics
+
+    // optional "Linear Solver" sublist, see NativeSparseLinearProblem
+    Teuchos::ParameterList m_solverParams;
     
   public:
     ElastostaticSolve(Teuchos::ParameterList const& paramList,
@@ -99,11 +111,16 @@ namespace LinearElastostatics {
     // ! Returns the constrained values
     decltype(m_bcValues)& getConstrainedValues(){ return m_bcValues; }
 
-    // ! Returns the stiffness matrix as const
+    // ! Returns the stiffness matrix as const (its diagonal blocks, when matrix free)
     const Plato::CrsMatrixType& getMatrix() const {return *m_matrix;}
 
-    // ! Returns the stiffness matrix
+    // ! Returns the stiffness matrix (its diagonal blocks, when matrix free)
     Plato::CrsMatrixType getMatrix() {return *m_matrix;}
+
+    // ! Returns the matrix-free stiffness; null unless "Matrix Free" is set
+    Teuchos::RCP<Plato::MatrixFreeStiffness<SpatialDim>> getMatrixFreeStiffness() {return m_matrixFreeStiffness;}
+
+    bool isMatrixFree() const {return m_matrixFree;}
     
     // ! returns the solution vector
     decltype(m_lhs)& getLHS() {return m_lhs;}
@@ -810,17 +810,20 @@ void GRAD<SpatialDim>::apply(
 
 template <int SpatialDim>
 internal_force<SpatialDim>::internal_force(
-        const Fields &mesh_fields, const int arg_state0, const int arg_state1)
+        const Fields &mesh_fields, const int arg_state0, const int arg_state1,
+        const bool arg_fused)
         : elem_node_connectivity(mesh_fields.femesh.elem_node_ids)
 	, updatedCoordinates(Coordinates<Fields>())
 	, elem_mass(ElementMass<Fields>())
 	, stress(Stress<Fields>())
 	, element_force(ElementForce<Fields>())
+	, nodal_force(InternalForce<Fields>())
 	, vel_grad(VelocityGradient<Fields>())
 	, pprime(FineScalePressure<Fields>())
 	, nodal_pressure(NodalPressure<Fields>())
 	, state0(arg_state0)
 	, state1(arg_state1)
+	, fused(arg_fused)
 	, artificialViscosityModel(mesh_fields) 
 	, mhd(mesh_fields)
 {
@@ -830,12 +833,24 @@ internal_force<SpatialDim>::internal_force(
 
 template <int SpatialDim>
 void internal_force<SpatialDim>::apply(
-        const Fields &mesh_fields, const int arg_state0, const int arg_state1) {
-    internal_force op_force(mesh_fields, arg_state0, arg_state1);
+        const Fields &mesh_fields, const int arg_state0, const int arg_state1,
+        const bool arg_fused) {
+    internal_force op_force(mesh_fields, arg_state0, arg_state1, arg_fused);
 
+    if (arg_fused) Kokkos::deep_copy(op_force.nodal_force, Scalar(0));
     Kokkos::parallel_for(mesh_fields.femesh.nelems, op_force);
 }
 
+template <int SpatialDim>
+void internal_force<SpatialDim>::apply(
+        const Fields &mesh_fields, const int arg_state0, const int arg_state1,
+        const Kokkos::View<int*, execution_space> elems) {
+    internal_force op_force(mesh_fields, arg_state0, arg_state1, true);
+
+    auto subset = LAMBDA_EXPRESSION(int i) { op_force(elems(i)); };
+    Kokkos::parallel_for(int(elems.extent(0)), subset);
+}
+
 template <int SpatialDim>
 KOKKOS_INLINE_FUNCTION
 void internal_force<SpatialDim>::comp_force(
@@ -851,8 +866,14 @@ void internal_force<SpatialDim>::comp_force(
          tensorOps::symmTimesVector<SpatialDim>(algoStress,
                  grad_x[inode], grad_y[inode], grad_z[inode], force);
 
-         for(int d = 0; d < SpatialDim; ++d)
-             element_force(ielem, d, inode) = force[d];
+         if (fused) {
+             const int n = elem_node_connectivity(ielem, inode);
+             for(int d = 0; d < SpatialDim; ++d)
+                 Kokkos::atomic_add(&nodal_force(n, d), force[d]);
+         } else {
+             for(int d = 0; d < SpatialDim; ++d)
+                 element_force(ielem, d, inode) = force[d];
+         }
 
     }
 }
@@ -368,6 +368,7 @@ struct internal_force {
     const typename Fields::array_type                 elem_volume;
     const typename Fields::elem_sym_tensor_state_type stress;
     const typename Fields::elem_node_geom_type        element_force;
+    const typename Fields::geom_array_type            nodal_force;
     const typename Fields::elem_tensor_type           vel_grad;
     const typename Fields::array_type                 pprime;
     const typename Fields::array_type                 nodal_pressure;
@@ -376,13 +377,24 @@ struct internal_force {
     const int state0;
     const int state1;
 
+    // when fused, element forces are scattered straight into the
+    // nodal internal force with atomics and assemble_forces is skipped
+    const bool fused;
+
     const ArtificialViscosity<SpatialDim> artificialViscosityModel;
 
     const MHD<SpatialDim> mhd;
 
-    internal_force(const Fields &mesh_fields, const int arg_state0, const int arg_state1);
+    internal_force(const Fields &mesh_fields, const int arg_state0, const int arg_state1,
+                   const bool arg_fused = false);
+
+    static void apply(const Fields &mesh_fields, const int arg_state0, const int arg_state1,
+                      const bool arg_fused = false);
 
-    static void apply(const Fields &mesh_fields, const int arg_state0, const int arg_state1);
+    // fused scatter from a subset of the elements; the nodal internal
+    // force is not zeroed, so the caller does that before the first subset
+    static void apply(const Fields &mesh_fields, const int arg_state0, const int arg_state1,
+                      const Kokkos::View<int*, execution_space> elems);
 
     KOKKOS_INLINE_FUNCTION
     void comp_force( int ielem,
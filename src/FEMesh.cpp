@@ -113,11 +113,28 @@ void FEMesh<SpatialDim>::resetSizes() {
   nelems = omega_h_mesh->nelems();
   nnodes = omega_h_mesh->nverts();
   nfaces = Omega_h::FACE <= omega_h_mesh->dim() ? omega_h_mesh->nfaces() : 0;
-  auto      spaceDim = omega_h_mesh->dim();
-  const int dimensions[] = {static_cast<int>(nnodes), spaceDim};
-  const int order[] = {1, 0};
+  geom_layout = geomLayout(nnodes);
+}
+
+template <int SpatialDim>
+Kokkos::LayoutStride FEMesh<SpatialDim>::geomLayout(size_t count) const {
+  const int dimensions[] = {static_cast<int>(count), SpatialDim};
+  const int interleaved[] = {1, 0};
+  const int blocked[] = {0, 1};
   const int rank = 2;
-  geom_layout = Kokkos::LayoutStride::order_dimensions(rank, order, dimensions);
+  return Kokkos::LayoutStride::order_dimensions(rank,
+      (geom_order == GeomOrder::Blocked) ? blocked : interleaved, dimensions);
+}
+
+template <int SpatialDim>
+Kokkos::LayoutStride FEMesh<SpatialDim>::geomStateLayout(
+    size_t count, int numStates) const {
+  const int dimensions[] = {static_cast<int>(count), SpatialDim, numStates};
+  const int interleaved[] = {1, 0, 2};
+  const int blocked[] = {0, 1, 2};
+  const int rank = 3;
+  return Kokkos::LayoutStride::order_dimensions(rank,
+      (geom_order == GeomOrder::Blocked) ? blocked : interleaved, dimensions);
 }
 
 template <int SpatialDim>
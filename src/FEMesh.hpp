@@ -55,6 +55,12 @@ class Mesh;
 
 namespace lgr {
 
+// memory order of the components of nodal vector data.
+// Interleaved stores each node's components together (x0 y0 z0 x1 ...),
+// Blocked stores one component for all nodes after another (x0 x1 ... y0 ...),
+// which lets loops over nodes use unit-stride vector loads.
+enum class GeomOrder { Interleaved, Blocked };
+
 template <int SpatialDim>
 struct FEMesh {
 
@@ -97,9 +103,12 @@ struct FEMesh {
   Omega_h::Mesh* omega_h_mesh;
   static constexpr int  numDim = SpatialDim;
 
+  GeomOrder            geom_order = GeomOrder::Interleaved;
   Kokkos::LayoutStride geom_layout;
 
   void resetSizes();
+  Kokkos::LayoutStride geomLayout(size_t count) const;
+  Kokkos::LayoutStride geomStateLayout(size_t count, int numStates) const;
   void reAlloc();
   void reportTags() const;
   void updateMesh();
@@ -45,6 +45,8 @@
 #include "FieldDB.hpp"
 #include "LGRLambda.hpp"
 #include "FieldsEnum.hpp"
+#include "ErrorHandling.hpp"
+#include "NodalExchange.hpp"
 #include <Omega_h_mesh.hpp>
 
 namespace lgr {
@@ -52,6 +54,17 @@ namespace lgr {
 template <int SpatialDim>
 Fields<SpatialDim>::Fields(const FEMesh& mesh, Teuchos::ParameterList& data)
     : femesh(mesh), fieldData(data) {
+  auto const layout =
+      fieldData.get<std::string>("nodal vector layout", "interleaved");
+  LGR_THROW_IF(layout != "interleaved" && layout != "blocked",
+      "unknown nodal vector layout \"" << layout
+      << "\", should be \"interleaved\" or \"blocked\"\n");
+  if (layout == "blocked") {
+    femesh.geom_order = GeomOrder::Blocked;
+    femesh.resetSizes();
+    femesh.reAlloc();
+    femesh.updateMesh();
+  }
   allocate_and_resize_fields();
 }
 
@@ -61,6 +74,7 @@ void Fields<SpatialDim>::resize() {
   femesh.reAlloc();
   femesh.updateMesh();
   allocate_and_resize_fields();
+  nodalExchangePtr.reset();
 }
 
 template <int SpatialDim>
@@ -114,8 +128,12 @@ void Fields<SpatialDim>::allocate_and_resize_fields() {
       FieldDB<elem_tensor_type>::Self()["save the deformation gradient"],
       femesh.nelems);
 
+  // the fused force scatter never stores per-element node forces
+  const bool fusedForceScatter =
+      fieldData.get<bool>("fused force scatter", false);
   Kokkos::realloc(
-      FieldDB<elem_node_geom_type>::Self()["element force"], femesh.nelems);
+      FieldDB<elem_node_geom_type>::Self()["element force"],
+      fusedForceScatter ? 0 : femesh.nelems);
 
   Kokkos::realloc(
       FieldDB<elem_vector_state_type>::Self()["fine scale displacement"],
@@ -129,12 +147,8 @@ void Fields<SpatialDim>::allocate_and_resize_fields() {
       FieldDB<elem_sym_tensor_state_type>::Self()["stress"], femesh.nelems);
 
   {
-    const int dimensions[] = {static_cast<int>(femesh.nnodes), SpatialDim,
-                              NumStates};
-    const int order[] = {1, 0, 2};
-    const int rank = 3;
     const Kokkos::LayoutStride layout =
-        Kokkos::LayoutStride::order_dimensions(rank, order, dimensions);
+        femesh.geomStateLayout(femesh.nnodes, NumStates);
     Kokkos::realloc(FieldDB<geom_state_array_type>::Self()["velocity"], layout);
     Kokkos::realloc(
         FieldDB<geom_state_array_type>::Self()["spatial coordinates"], layout);
@@ -149,10 +163,7 @@ void Fields<SpatialDim>::allocate_and_resize_fields() {
         layout);  // for error indicator
   }
   {
-    const int dimensions[] = {static_cast<int>(femesh.nelems), SpatialDim};
-    const int order[] = {1, 0};
-    const Kokkos::LayoutStride layout =
-        Kokkos::LayoutStride::order_dimensions(2, order, dimensions);
+    const Kokkos::LayoutStride layout = femesh.geomLayout(femesh.nelems);
     Kokkos::realloc(
         FieldDB<geom_array_type>::Self()["element momentum"], layout);
   }
@@ -291,6 +302,14 @@ void Fields<SpatialDim>::conformGeom(
   femesh.omega_h_mesh->remove_tag(0, name);
 }
 
+template <int SpatialDim>
+NodalExchange<SpatialDim>& Fields<SpatialDim>::nodalExchange() {
+  if (!nodalExchangePtr) {
+    nodalExchangePtr = std::make_shared<NodalExchange<SpatialDim>>(femesh);
+  }
+  return *nodalExchangePtr;
+}
+
 template <int SpatialDim>
 void Fields<SpatialDim>::conform(
     char const* name, array_type a) {
@@ -48,9 +48,13 @@
 #include "FEMesh.hpp"
 #include <Teuchos_ParameterList.hpp>
 #include <Omega_h_mesh.hpp>
+#include <memory>
 
 namespace lgr {
 
+template <int SpatialDim>
+class NodalExchange;
+
 template <int SpatialDim>
 struct Fields {
   static const int NumStates = 2;
@@ -156,6 +160,11 @@ struct Fields {
   void conformGeom(char const* name, geom_array_type a);
   void conform(char const* name, array_type a);
 
+  // Non-blocking nodal synchronization, built on first use
+  // and rebuilt after the mesh changes
+  std::shared_ptr<NodalExchange<SpatialDim>> nodalExchangePtr;
+  NodalExchange<SpatialDim>& nodalExchange();
+
   void copyTagsFromMesh(
       Omega_h::TagSet const& tags,
       int                    state,
@@ -531,6 +531,51 @@ class BlockMatrixEntryOrdinal
 };
 /******************************************************************************/
 
+/******************************************************************************/
+/*!
+  \brief Same map as BlockMatrixEntryOrdinal, precomputed for every (cell, i, j)
+
+  Lookups are a single load instead of a search through the block row, so
+  the table pays for itself when the same graph is assembled repeatedly.
+*/
+template<Plato::OrdinalType SpaceDim, Plato::OrdinalType DofsPerNode_I, Plato::OrdinalType DofsPerNode_J=DofsPerNode_I>
+class BlockMatrixEntryOrdinalTable
+{
+  private:
+    static constexpr Plato::OrdinalType m_numNodesPerCell = SpaceDim+1;
+    static constexpr Plato::OrdinalType m_numRowsPerCell = m_numNodesPerCell*DofsPerNode_I;
+    static constexpr Plato::OrdinalType m_numColumnsPerCell = m_numNodesPerCell*DofsPerNode_J;
+
+    Kokkos::View<Plato::OrdinalType***, Kokkos::LayoutRight, Plato::MemSpace> m_entryOrdinals;
+
+  public:
+    BlockMatrixEntryOrdinalTable() { }
+
+    BlockMatrixEntryOrdinalTable(Teuchos::RCP<Plato::CrsMatrixType> aMatrix, Omega_h::Mesh* aMesh ) :
+      m_entryOrdinals("entry ordinals", aMesh->nelems(), m_numRowsPerCell, m_numColumnsPerCell)
+    {
+        Plato::BlockMatrixEntryOrdinal<SpaceDim, DofsPerNode_I, DofsPerNode_J> tEntryOrdinal(aMatrix, aMesh);
+        auto tEntryOrdinals = m_entryOrdinals;
+        Kokkos::parallel_for(Kokkos::RangePolicy<>(0, aMesh->nelems()), LAMBDA_EXPRESSION(const Plato::OrdinalType & aCellOrdinal)
+        {
+            for(Plato::OrdinalType tRowIndex = 0; tRowIndex < m_numRowsPerCell; tRowIndex++){
+              for(Plato::OrdinalType tColumnIndex = 0; tColumnIndex < m_numColumnsPerCell; tColumnIndex++){
+                tEntryOrdinals(aCellOrdinal, tRowIndex, tColumnIndex) = tEntryOrdinal(aCellOrdinal, tRowIndex, tColumnIndex);
+              }
+            }
+        }, "BlockMatrixEntryOrdinalTable");
+    }
+
+    DEVICE_TYPE
+    inline
+    Plato::OrdinalType
+    operator()(Plato::OrdinalType cellOrdinal, Plato::OrdinalType icellDof, Plato::OrdinalType jcellDof) const
+    {
+        return m_entryOrdinals(cellOrdinal, icellDof, jcellDof);
+    }
+};
+/******************************************************************************/
+
 /******************************************************************************/
 template<Plato::OrdinalType SpaceDim, Plato::OrdinalType DofsPerNode, Plato::OrdinalType DofsPerNode_J=DofsPerNode>
 class MatrixEntryOrdinal
@@ -47,7 +47,12 @@
 #include "LagrangianFineScale.hpp"
 #include "FieldDB.hpp"
 #include "LGRLambda.hpp"
+#include "ErrorHandling.hpp"
+#include "NodalExchange.hpp"
 #include <Kokkos_Timer.hpp>
+#include <Omega_h_scalar.hpp>
+#include <cmath>
+#include <ostream>
 
 namespace lgr {
 
@@ -57,7 +62,8 @@ PerformanceData::PerformanceData()
     , internal_force_time(0)
     , midpoint(0)
     , comm_time(0)
-    , number_of_steps(0) {}
+    , number_of_steps(0)
+    , number_of_iterations(0) {}
 
 void PerformanceData::best(const PerformanceData &rhs) {
   if (rhs.mesh_time < mesh_time) mesh_time = rhs.mesh_time;
@@ -68,6 +74,83 @@ void PerformanceData::best(const PerformanceData &rhs) {
   if (rhs.comm_time < comm_time) comm_time = rhs.comm_time;
 }
 
+void PerformanceData::add(const PerformanceData &rhs) {
+  mesh_time += rhs.mesh_time;
+  init_time += rhs.init_time;
+  internal_force_time += rhs.internal_force_time;
+  midpoint += rhs.midpoint;
+  comm_time += rhs.comm_time;
+  number_of_steps += rhs.number_of_steps;
+  number_of_iterations += rhs.number_of_iterations;
+}
+
+void PerformanceData::print(std::ostream &os) const {
+  if (number_of_steps == 0) return;
+  os << "Steps: " << number_of_steps
+     << ", predictor-corrector iterations: " << number_of_iterations << " ("
+     << double(number_of_iterations) / double(number_of_steps)
+     << " per step)\n";
+  os << "Internal force time: " << internal_force_time
+     << " s, communication time: " << comm_time << " s\n";
+}
+
+//largest change of a nodal field from its previous iterate, relative to
+//the largest magnitude of the field.  the previous iterate is then
+//overwritten with the current one.
+template <class CurrentView, class PreviousView>
+static Scalar relative_geom_change(
+    const comm::Machine &machine,
+    const CurrentView    current,
+    const PreviousView   previous,
+    const int            nnodes) {
+  const int ncomps = int(previous.extent(1));
+  Scalar change = 0.0;
+  auto measureChange = LAMBDA_EXPRESSION(int inode, Scalar &update) {
+    for (int slot = 0; slot < ncomps; ++slot) {
+      update = Omega_h::max2(
+          update, std::abs(current(inode, slot) - previous(inode, slot)));
+    }
+  };  //end lambda measureChange
+  Kokkos::parallel_reduce(nnodes, measureChange,
+      Kokkos::Max<Scalar, Kokkos::DefaultExecutionSpace>(change));
+  Scalar magnitude = 0.0;
+  auto measureMagnitude = LAMBDA_EXPRESSION(int inode, Scalar &update) {
+    for (int slot = 0; slot < ncomps; ++slot) {
+      update = Omega_h::max2(update, std::abs(current(inode, slot)));
+      previous(inode, slot) = current(inode, slot);
+    }
+  };  //end lambda measureMagnitude
+  Kokkos::parallel_reduce(nnodes, measureMagnitude,
+      Kokkos::Max<Scalar, Kokkos::DefaultExecutionSpace>(magnitude));
+  change = comm::max(machine, change);
+  magnitude = comm::max(machine, magnitude);
+  return (magnitude > 0.0) ? (change / magnitude) : change;
+}
+
+template <class CurrentView, class PreviousView>
+static Scalar relative_scalar_change(
+    const comm::Machine &machine,
+    const CurrentView    current,
+    const PreviousView   previous,
+    const int            nnodes) {
+  Scalar change = 0.0;
+  auto measureChange = LAMBDA_EXPRESSION(int inode, Scalar &update) {
+    update = Omega_h::max2(update, std::abs(current(inode) - previous(inode)));
+  };  //end lambda measureChange
+  Kokkos::parallel_reduce(nnodes, measureChange,
+      Kokkos::Max<Scalar, Kokkos::DefaultExecutionSpace>(change));
+  Scalar magnitude = 0.0;
+  auto measureMagnitude = LAMBDA_EXPRESSION(int inode, Scalar &update) {
+    update = Omega_h::max2(update, std::abs(current(inode)));
+    previous(inode) = current(inode);
+  };  //end lambda measureMagnitude
+  Kokkos::parallel_reduce(nnodes, measureMagnitude,
+      Kokkos::Max<Scalar, Kokkos::DefaultExecutionSpace>(magnitude));
+  change = comm::max(machine, change);
+  magnitude = comm::max(machine, magnitude);
+  return (magnitude > 0.0) ? (change / magnitude) : change;
+}
+
 template <int SpatialDim>
 LagrangianStep<SpatialDim>::LagrangianStep(
       std::list<std::shared_ptr<
@@ -135,9 +218,50 @@ PerformanceData LagrangianStep<SpatialDim>::advanceTime(
     lnp.computeNodalPressure();
   }
 
+  //the fixed point iteration stops early once neither the nodal velocity
+  //nor the nodal pressure change by more than the relative tolerance.
+  //with no tolerance, every step runs the maximum number of iterations.
+  const Scalar iterationTolerance =
+      fieldData.get<double>("predictor-corrector tolerance", 0.0);
+  const int maxIterations =
+      fieldData.get<int>("maximum predictor-corrector iterations", 2);
+  LGR_THROW_IF(maxIterations < 1,
+      "maximum predictor-corrector iterations must be at least one\n");
+  const bool checkingConvergence = (iterationTolerance > 0.0);
+  const int nnodes = meshFields_.femesh.nnodes;
+  if (checkingConvergence) {
+    if (int(previousVelocity_.extent(0)) != nnodes) {
+      previousVelocity_ = Kokkos::View<Scalar**, execution_space>(
+          "previous velocity", nnodes, SpatialDim);
+      previousNodalPressure_ = Kokkos::View<Scalar*, execution_space>(
+          "previous nodal pressure", nnodes);
+    }
+  }
+
+  //scatter element forces straight into the nodal internal force
+  //instead of storing them per element and gathering them afterwards
+  const bool fusedForceScatter =
+      fieldData.get<bool>("fused force scatter", false);
+  //with more than one rank, compute the forces of elements next to
+  //other ranks first and exchange their nodes while the interior
+  //elements are computed.  this relies on the fused scatter.
+  const bool overlapRequested =
+      fieldData.get<bool>("overlap nodal exchange", false);
+  LGR_THROW_IF(overlapRequested && !fusedForceScatter,
+      "overlap nodal exchange requires the fused force scatter\n");
+  const bool overlappingExchange =
+      overlapRequested && comm::size(machine_) > 1;
+  //the owned shared nodal forces as they are sent to the other ranks
+  typename Fields::geom_array_type sendForce;
+  if (overlappingExchange) {
+    sendForce = Kokkos::View<Scalar * [SpatialDim], execution_space>(
+        "overlap send force", InternalForce<Fields>().extent(0));
+  }
+
   perfData.internal_force_time = 0.0;
   perfData.comm_time = 0.0;
-  for (int iterationCount = 0; iterationCount < 2; ++iterationCount) {
+  int iterationCount = 0;
+  while (iterationCount < maxIterations) {
     //volume, gradient, velocity gradient, mid-configuration x_{n+1/2}.
     //the artificial viscosity uses the velocity gradient.
     {
@@ -146,28 +270,63 @@ PerformanceData LagrangianStep<SpatialDim>::advanceTime(
           meshFields_, current_state, next_state, alpha);
     }
 
-    //calculate and store internal forces for each element.
-    {
-      const double t0 = wall_clock.seconds();
-      internal_force<SpatialDim>::apply(
-          meshFields_, current_state, next_state);
-      const double t1 = wall_clock.seconds();
-      perfData.internal_force_time += comm::max(machine_, t1 - t0);
-    }
-    execution_space::fence();
-
-    //Assemble element contributions to nodal force into a nodal force vector.
-    assemble_forces<SpatialDim>::apply(meshFields_);
-
-    // Apply force-based boundary conditions
-    internal_force_contribs.add_to(InternalForce<Fields>());
+    if (overlappingExchange) {
+      auto &exchange = meshFields_.nodalExchange();
+      const typename Fields::geom_array_type force(InternalForce<Fields>());
 
-    //mpi swap and add nodal forces
-    {
+      //the timings are only reduced at the end so that no collective
+      //sits between posting the messages and the interior work
       const double t0 = wall_clock.seconds();
-      meshFields_.conformGeom("force", InternalForce<Fields>());
+      //forces of the elements touching nodes that other ranks copy
+      Kokkos::deep_copy(force, 0.0);
+      internal_force<SpatialDim>::apply(
+          meshFields_, current_state, next_state, exchange.boundaryElems());
+      //the force-based boundary conditions must see the complete element
+      //forces, and some of them assign rather than add, so they are applied
+      //once to all nodes after the interior elements.  the sent nodes are
+      //already complete, so a copy with the contributions applied is what
+      //goes to the other ranks, and their copies match the plain path.
+      Kokkos::deep_copy(sendForce, force);
+      internal_force_contribs.add_to(sendForce);
       const double t1 = wall_clock.seconds();
-      perfData.comm_time += comm::max(machine_, t1 - t0);
+      //send the finished shared nodes, then do the interior elements
+      exchange.start(sendForce);
+      const double t2 = wall_clock.seconds();
+      internal_force<SpatialDim>::apply(
+          meshFields_, current_state, next_state, exchange.interiorElems());
+      // Apply force-based boundary conditions
+      internal_force_contribs.add_to(force);
+      execution_space::fence();
+      const double t3 = wall_clock.seconds();
+      exchange.finish(force);
+      const double t4 = wall_clock.seconds();
+      perfData.internal_force_time +=
+          comm::max(machine_, (t1 - t0) + (t3 - t2));
+      perfData.comm_time += comm::max(machine_, (t2 - t1) + (t4 - t3));
+    } else {
+      //calculate and store internal forces for each element.
+      {
+        const double t0 = wall_clock.seconds();
+        internal_force<SpatialDim>::apply(
+            meshFields_, current_state, next_state, fusedForceScatter);
+        const double t1 = wall_clock.seconds();
+        perfData.internal_force_time += comm::max(machine_, t1 - t0);
+      }
+      execution_space::fence();
+
+      //Assemble element contributions to nodal force into a nodal force vector.
+      if (!fusedForceScatter) assemble_forces<SpatialDim>::apply(meshFields_);
+
+      // Apply force-based boundary conditions
+      internal_force_contribs.add_to(InternalForce<Fields>());
+
+      //mpi swap and add nodal forces
+      {
+        const double t0 = wall_clock.seconds();
+        meshFields_.conformGeom("force", InternalForce<Fields>());
+        const double t1 = wall_clock.seconds();
+        perfData.comm_time += comm::max(machine_, t1 - t0);
+      }
     }
 
     //compute acceleration
@@ -180,7 +339,7 @@ PerformanceData LagrangianStep<SpatialDim>::advanceTime(
       auto updateAcceleration =
           LAMBDA_EXPRESSION(int inode) {
         const Scalar m = nodal_mass(inode);
-        for (int slot = 0; slot < 3; ++slot)
+        for (int slot = 0; slot < SpatialDim; ++slot)
           acceleration(inode, slot) = -(internal_force(inode, slot) / m);
       };  //end lambda updateAcceleration
       Kokkos::parallel_for(meshFields_.femesh.nnodes, updateAcceleration);
@@ -199,7 +358,7 @@ PerformanceData LagrangianStep<SpatialDim>::advanceTime(
           Acceleration<Fields>());
       auto updateVelocity = LAMBDA_EXPRESSION(int inode) {
         const Scalar dt_vel = dt;
-        for (int slot = 0; slot < 3; ++slot) {
+        for (int slot = 0; slot < SpatialDim; ++slot) {
           next_vel(inode, slot) =
               cur_vel(inode, slot) + dt_vel * acceleration(inode, slot);
         }
@@ -210,8 +369,15 @@ PerformanceData LagrangianStep<SpatialDim>::advanceTime(
     //mpi conform nodal velocity
     {
       const double t0 = wall_clock.seconds();
-      meshFields_.conformGeom(
-          "vel", Fields::getGeomFromSA(Velocity<Fields>(), next_state));
+      const typename Fields::geom_array_type next_vel(
+          Fields::getGeomFromSA(Velocity<Fields>(), next_state));
+      if (overlappingExchange) {
+        auto &exchange = meshFields_.nodalExchange();
+        exchange.start(next_vel);
+        exchange.finish(next_vel);
+      } else {
+        meshFields_.conformGeom("vel", next_vel);
+      }
       const double t1 = wall_clock.seconds();
       perfData.comm_time += comm::max(machine_, t1 - t0);
     }
@@ -233,7 +399,7 @@ PerformanceData LagrangianStep<SpatialDim>::advanceTime(
       const typename Fields::geom_array_type cur_disp(Displacement<Fields>());
       auto updateCoordinates = LAMBDA_EXPRESSION(int inode) {
         const Scalar dt_disp = dt;
-        for (int slot = 0; slot < 3; ++slot) {
+        for (int slot = 0; slot < SpatialDim; ++slot) {
           const Scalar vel =
               0.5 * (cur_vel(inode, slot) + next_vel(inode, slot));
           cur_disp(inode, slot) = dt_disp * vel;
@@ -296,11 +462,27 @@ PerformanceData LagrangianStep<SpatialDim>::advanceTime(
     }
 
     execution_space::fence();
-  }  //end for (int iterationCount=0; iterationCount<2; ++iterationCount)
+    ++iterationCount;
+
+    if (checkingConvergence && iterationCount < maxIterations) {
+      //this also stores the current iterate as the previous one.  the
+      //first pass only seeds it: its change is the predictor increment
+      //over the step, not a change between corrector iterates.
+      const Scalar velocityChange = relative_geom_change(machine_,
+          Fields::getGeomFromSA(Velocity<Fields>(), next_state),
+          previousVelocity_, nnodes);
+      const Scalar pressureChange = relative_scalar_change(machine_,
+          NodalPressure<Fields>(), previousNodalPressure_, nnodes);
+      if (iterationCount > 1 &&
+          Omega_h::max2(velocityChange, pressureChange) < iterationTolerance)
+        break;
+    }
+  }  //end while (iterationCount < maxIterations)
 
   perfData.midpoint = comm::max(machine_, wall_clock.seconds());
 
   perfData.number_of_steps = 1;
+  perfData.number_of_iterations = size_t(iterationCount);
   return perfData;
 }  //end function advanceTime
 
@@ -48,6 +48,7 @@
 #include "Fields.hpp"
 #include "MaterialModels.hpp"
 #include "VectorContribution.hpp"
+#include <iosfwd>
 #include <list>
 
 namespace lgr {
@@ -59,10 +60,14 @@ struct PerformanceData {
   double midpoint;
   double comm_time;
   size_t number_of_steps;
+  size_t number_of_iterations;
 
   PerformanceData();
 
   void best(const PerformanceData &rhs);
+  //sums the times and counts of another step into this one
+  void add(const PerformanceData &rhs);
+  void print(std::ostream &os) const;
 };  //end struct PerformanceData
 
 template <int SpatialDim>
@@ -79,6 +84,10 @@ class LagrangianStep {
   Fields &       meshFields_;
   comm::Machine  machine_;
   Omega_h::Mesh *mesh_;
+  //previous predictor-corrector iterates, only kept when a
+  //convergence tolerance is given
+  mutable Kokkos::View<Scalar**, execution_space> previousVelocity_;
+  mutable Kokkos::View<Scalar*, execution_space>  previousNodalPressure_;
 
  public:
   LagrangianStep(
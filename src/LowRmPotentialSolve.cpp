@@ -9,6 +9,8 @@
 #include <Cubature.hpp>
 #include <ErrorHandling.hpp>
 
+#include "NativeSparseLinearProblem.hpp"
+
 #ifdef HAVE_VIENNA_CL
 #include "ViennaSparseLinearProblem.hpp"
 #endif
@@ -28,12 +30,21 @@ Omega_h::Write<T> getArray_Omega_h(std::string name, int entryCount) {
 
 template <int SpatialDim>
 LowRmPotentialSolve<SpatialDim>::LowRmPotentialSolve(
-    Teuchos::ParameterList const &,
+    Teuchos::ParameterList const &paramList,
     Teuchos::RCP<DefaultFields>   meshFields,
     comm::Machine                 machine)
     : _machine(machine), _meshFields(meshFields) {
-  _numConductors =
-      0;  // TODO: parse paramList to see what caller says about the conductor count
+  if (paramList.isSublist("Linear Solver")) {
+    _solverParams = paramList.sublist("Linear Solver");
+  }
+  // each conductor adds a right-hand side next to the particular solve;
+  // its row of getRHS() is filled by the caller after assemble()
+  _numConductors = paramList.isType<int>("Number of Conductors")
+                       ? paramList.get<int>("Number of Conductors")
+                       : 0;
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      _numConductors < 0, std::invalid_argument,
+      "\"Number of Conductors\" must not be negative, got " << _numConductors);
   _spaceDim = _meshFields->femesh.omega_h_mesh->dim();
 
   // I *think* Kokkos won't like it if we resize() these arrays before we initialize them.
@@ -223,6 +234,7 @@ void LowRmPotentialSolve<SpatialDim>::assemble(
    One way to go is to simply search for the column index inside the CrsMatrix columnIndices, within the row entries.
    I've now asked Dan about this, and he suggests that this might not be too bad, though there is something more sophisticated
    we could try later -- using edge information from Omega_h.
+   The search is now done once per graph, in computeEntryOrdinals(); assembly just reads the resulting table.
    
    Note that some solvers (ViennaCL is one) do require that the matrix be strictly SPD: no asymmetries from BCs, and no symmetric negative definite matrices.
    
@@ -236,26 +248,7 @@ void LowRmPotentialSolve<SpatialDim>::assemble(
    
    */
 
-  auto rowMap = _matrix.rowMap();
-  auto columnIndices = _matrix.columnIndices();
-  auto entryOrdinalLookup =
-      LAMBDA_EXPRESSION(int cellOrdinal, int iNode, int jNode) {
-        DefaultLocalOrdinal iLocalOrdinal = cells2nodes[cellOrdinal * nodesPerCell + iNode];
-        DefaultLocalOrdinal jLocalOrdinal = cells2nodes[cellOrdinal * nodesPerCell + jNode];
-        RowMapEntryType rowStart = rowMap(iLocalOrdinal);
-        RowMapEntryType rowEnd = rowMap(iLocalOrdinal + 1);
-        for (RowMapEntryType entryOrdinal = rowStart; entryOrdinal < rowEnd; entryOrdinal++) {
-          if (columnIndices(entryOrdinal) == jLocalOrdinal) {
-            return entryOrdinal;
-          }
-        }
-        //    cout << "Entry for (" << cellOrdinal << ", " << iNode << ", " << jNode << ") not found.  ";
-        //    cout << "iLocalOrdinal " << iLocalOrdinal << "; ";
-        //    cout << "jLocalOrdinal " << jLocalOrdinal << "; ";
-        //    cout << "rowStart "      << rowStart      << "; ";
-        //    cout << "rowEnd "        << rowEnd        << "; " << endl;
-        return RowMapEntryType(-1);
-      };
+  auto entryOrdinals = _entryOrdinals;
 
   ScalarVector matrixEntries = _matrix.entries();
   Scalar quadratureWeight = 1.0;  // for a 1-point quadrature rule for simplices
@@ -279,8 +272,8 @@ void LowRmPotentialSolve<SpatialDim>::assemble(
             }
             Scalar integral = (iGradient * jGradient) * cellVolume;
 
-            auto entryOrdinal = entryOrdinalLookup(cellOrdinal, iNode, jNode);
-            if (entryOrdinal < RowMapEntryType(entriesLength)) {
+            auto entryOrdinal = entryOrdinals(cellOrdinal, iNode, jNode);
+            if (entryOrdinal >= 0 && entryOrdinal < RowMapEntryType(entriesLength)) {
               Kokkos::atomic_add(&matrixEntries(entryOrdinal), integral);
             }
           }
@@ -296,7 +289,7 @@ void LowRmPotentialSolve<SpatialDim>::assemble(
   //      {
   //        for (int jNode=0; jNode<nodesPerCell; jNode++)
   //        {
-  //          auto entryOrdinal = entryOrdinalLookup(cellOrdinal,iNode,jNode);
+  //          auto entryOrdinal = entryOrdinals(cellOrdinal,iNode,jNode);
   //          cout << "K(" << cellOrdinal << "," << iNode << "," << jNode << ") = " << matrixEntries(entryOrdinal) << endl;
   //        }
   //      }
@@ -405,6 +398,8 @@ void LowRmPotentialSolve<SpatialDim>::assemble(
    effort here to maintain symmetry while imposing BCs.
    */
   int  numBCs = _bcNodes.size();
+  auto rowMap = _matrix.rowMap();
+  auto columnIndices = _matrix.columnIndices();
   auto rhs = _rhs;
   auto bcNodes = _bcNodes;
   auto bcValues = _bcValues;
@@ -455,24 +450,7 @@ void LowRmPotentialSolve<spaceDim>::fusedAssemble() {
 
   int numCells = _meshFields->femesh.nelems;
 
-  auto rowMap = _matrix.rowMap();
-  auto columnIndices = _matrix.columnIndices();
-  auto entryOrdinalLookup =
-      LAMBDA_EXPRESSION(int cellOrdinal, int iNode, int jNode) {
-    DefaultLocalOrdinal iLocalOrdinal =
-        cells2nodes[cellOrdinal * nodesPerCell + iNode];
-    DefaultLocalOrdinal jLocalOrdinal =
-        cells2nodes[cellOrdinal * nodesPerCell + jNode];
-    RowMapEntryType rowStart = rowMap(iLocalOrdinal);
-    RowMapEntryType rowEnd = rowMap(iLocalOrdinal + 1);
-    for (RowMapEntryType entryOrdinal = rowStart; entryOrdinal < rowEnd;
-         entryOrdinal++) {
-      if (columnIndices(entryOrdinal) == jLocalOrdinal) {
-        return entryOrdinal;
-      }
-    }
-    return RowMapEntryType(-1);
-  };
+  auto entryOrdinals = _entryOrdinals;
 
   //  cout << "\n\n**** fusedAssemble ****\n\n";
 
@@ -565,8 +543,8 @@ void LowRmPotentialSolve<spaceDim>::fusedAssemble() {
 
             //        cout << "integral = " << integral << endl;
 
-            RowMapEntryType entryOrdinal = entryOrdinalLookup(cellOrdinal, iNode, jNode);
-            if (entryOrdinal < RowMapEntryType(entriesLength)) {
+            RowMapEntryType entryOrdinal = entryOrdinals(cellOrdinal, iNode, jNode);
+            if (entryOrdinal >= 0 && entryOrdinal < RowMapEntryType(entriesLength)) {
               Kokkos::atomic_add(&matrixEntries(entryOrdinal), integral);
             }
           }
@@ -708,6 +686,8 @@ void LowRmPotentialSolve<spaceDim>::fusedAssemble() {
    effort here to maintain symmetry while imposing BCs.
    */
   int  numBCs = _bcNodes.size();
+  auto rowMap = _matrix.rowMap();
+  auto columnIndices = _matrix.columnIndices();
   auto rhs = _rhs;
   auto bcNodes = _bcNodes;
   auto bcValues = _bcValues;
@@ -764,21 +744,22 @@ template <int spaceDim>
 Teuchos::RCP<CrsLinearSolver> LowRmPotentialSolve<spaceDim>::getDefaultSolver( double tol, 
 									       int maxIters) {
   Teuchos::RCP<CrsLinearSolver> solver;
+  // the built-in solver is used when the input asks for it,
+  // or when lgr was built without any of the solver packages
+  const bool useNativeSolver =
+      (_solverParams.get<std::string>("Package", "") == "native");
 #ifdef HAVE_AMGX
-  {
+  if (!useNativeSolver) {
     typedef AmgXSparseLinearProblem<DefaultLocalOrdinal> AmgXLinearProblem;
     std::string configString = AmgXLinearProblem::configurationString(
         AmgXLinearProblem::EAF, tol, maxIters);
 
     solver = Teuchos::rcp(new AmgXLinearProblem(_matrix, _lhs, _rhs));
   }
-#else
-  (void)tol;
-  (void)maxIters;
 #endif
 
 #ifdef HAVE_TPETRA
-  if (solver == Teuchos::null) {
+  if (solver == Teuchos::null && !useNativeSolver) {
     typedef TpetraSparseLinearProblem<Scalar, Ordinal, Layout, Space> TpetraSolver;
 
     auto tpetraSolver = new TpetraSolver(_matrix, _lhs, _rhs);
@@ -788,7 +769,7 @@ Teuchos::RCP<CrsLinearSolver> LowRmPotentialSolve<spaceDim>::getDefaultSolver( d
 #endif
 
 #ifdef HAVE_VIENNA_CL
-  if (solver == Teuchos::null) {
+  if (solver == Teuchos::null && !useNativeSolver) {
     typedef ViennaSparseLinearProblem<DefaultLocalOrdinal> ViennaSolver;
     auto viennaSolver = new ViennaSolver(_matrix, _lhs, _rhs);
     viennaSolver->setTolerance(tol);
@@ -797,9 +778,15 @@ Teuchos::RCP<CrsLinearSolver> LowRmPotentialSolve<spaceDim>::getDefaultSolver( d
   }
 #endif
   if (solver == Teuchos::null) {
-    std::cout << "WARNING: it looks like lgr was built without any "
-                 "compatible solvers (AmgX, ViennaCL).  Returning a null "
-                 "solver...\n";
+    // all _numConductors + 1 right-hand sides share one preconditioner and,
+    // with CG, one matrix pass per iteration
+    typedef NativeSparseLinearProblem<DefaultLocalOrdinal> NativeSolver;
+    Teuchos::ParameterList params;
+    params.set("Tolerance", tol);
+    params.set("Maximum Iterations", maxIters);
+    params.setParameters(_solverParams);
+    params.remove("Package", false);
+    solver = Teuchos::rcp(new NativeSolver(_matrix, _lhs, _rhs, params));
   }
   return solver;
 }
@@ -986,6 +973,12 @@ CrsMatrixType LowRmPotentialSolve<spaceDim>::getMatrix() {
   return _matrix;
 }
 
+template <int spaceDim>
+typename LowRmPotentialSolve<spaceDim>::EntryOrdinalTable
+LowRmPotentialSolve<spaceDim>::getEntryOrdinals() {
+  return _entryOrdinals;
+}
+
 template <int spaceDim>
 typename LowRmPotentialSolve<spaceDim>::ConductivityType
 LowRmPotentialSolve<spaceDim>::getConstantConductivity(
@@ -1122,12 +1115,59 @@ void LowRmPotentialSolve<spaceDim>::initialize() {
   //  cout << "]\n";
 
   _matrix = CrsMatrixType(rowMap, columnIndices, entries);
+  computeEntryOrdinals();
 
   int numSolves = _numConductors + 1;  // +1 : particular solve
   _lhs = ScalarMultiVector("solution", numSolves, numRows);
   _rhs = ScalarMultiVector("load", numSolves, numRows);
 }
 
+template <int spaceDim>
+void LowRmPotentialSolve<spaceDim>::computeEntryOrdinals() {
+  // the row scan that assembly used to do for every entry of every cell, done once per graph
+  constexpr int nodesPerCell = spaceDim + 1;
+
+  auto mesh = _meshFields->femesh.omega_h_mesh;
+  auto cells2nodes = mesh->ask_elem_verts();
+  int  numCells = _meshFields->femesh.nelems;
+
+  _entryOrdinals = EntryOrdinalTable("entry ordinals", numCells, nodesPerCell, nodesPerCell);
+
+  auto entryOrdinals = _entryOrdinals;
+  auto rowMap = _matrix.rowMap();
+  auto columnIndices = _matrix.columnIndices();
+  int  numMissing = 0;
+  Kokkos::parallel_reduce(
+      Kokkos::RangePolicy<int>(0, numCells),
+      LAMBDA_EXPRESSION(int cellOrdinal, int &missing) {
+        for (int iNode = 0; iNode < nodesPerCell; iNode++) {
+          DefaultLocalOrdinal iLocalOrdinal =
+              cells2nodes[cellOrdinal * nodesPerCell + iNode];
+          RowMapEntryType rowStart = rowMap(iLocalOrdinal);
+          RowMapEntryType rowEnd = rowMap(iLocalOrdinal + 1);
+          for (int jNode = 0; jNode < nodesPerCell; jNode++) {
+            DefaultLocalOrdinal jLocalOrdinal =
+                cells2nodes[cellOrdinal * nodesPerCell + jNode];
+            RowMapEntryType found = -1;
+            for (RowMapEntryType entryOrdinal = rowStart; entryOrdinal < rowEnd;
+                 entryOrdinal++) {
+              if (columnIndices(entryOrdinal) == jLocalOrdinal) {
+                found = entryOrdinal;
+                break;
+              }
+            }
+            entryOrdinals(cellOrdinal, iNode, jNode) = found;
+            if (found < 0) missing++;
+          }
+        }
+      },
+      numMissing);
+
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      numMissing != 0, std::logic_error,
+      numMissing << " cell-local entries have no matching matrix entry");
+}
+
 template <int spaceDim>
 void LowRmPotentialSolve<spaceDim>::initializeCellWorkset(
     CellWorkset &cellWorkset) {
@@ -83,6 +83,9 @@ class LowRmPotentialSolve {
       ScalarMultiVector;
   typedef Kokkos::View<Scalar ***, DefaultLayout, MemSpace>
       CellWorkset;
+  // (cell, iNode, jNode) -> ordinal of the matrix entry (cells2nodes(iNode), cells2nodes(jNode))
+  typedef Kokkos::View<RowMapEntryType ***, DefaultLayout, MemSpace>
+      EntryOrdinalTable;
 
   typedef CrsLinearProblem<
       DefaultLocalOrdinal>
@@ -91,6 +94,7 @@ class LowRmPotentialSolve {
       array_type;  // scalar-valued for now (could generalize to tensor-valued in future)
  private:
   CrsMatrixType     _matrix;
+  EntryOrdinalTable _entryOrdinals;  // rebuilt with the matrix graph in initialize()
   ScalarMultiVector _lhs, _rhs;
   int               _mSeries = 1;    // the "m" for m-fold series symmetry
   int               _mParallel = 1;  // the "m" for m-fold parallel symmetry
@@ -110,6 +114,9 @@ class LowRmPotentialSolve {
 
   void initializeCellWorkset(CellWorkset &cellWorkset);
 
+  // ! Find the matrix entry for every (cell, iNode, jNode) once per graph, so that assembly is a straight scatter
+  void computeEntryOrdinals();
+
   // ! Accumulate into the stiffness matrix and RHSes -- new version meant to eliminate nearly all temporary allocations on device
   void fusedAssemble();
 
@@ -119,6 +126,9 @@ class LowRmPotentialSolve {
   int                         _numConductors;
   int                         _spaceDim;
 
+  // optional "Linear Solver" sublist, see NativeSparseLinearProblem
+  Teuchos::ParameterList _solverParams;
+
   int         _quadratureDegreeForForcing;
   std::string _forcingFunctionExpr = "";
 
@@ -194,6 +204,9 @@ class LowRmPotentialSolve {
   // ! Returns the stiffness matrix
   CrsMatrixType getMatrix();
 
+  // ! Returns the (cell, iNode, jNode) -> matrix entry ordinal map; valid after initialize()
+  EntryOrdinalTable getEntryOrdinals();
+
   // ! returns the solution vector
   ScalarMultiVector getLHS();
 
@@ -0,0 +1,266 @@
+#ifndef MATRIX_FREE_STIFFNESS_HPP
+#define MATRIX_FREE_STIFFNESS_HPP
+
+#include <Teuchos_RCP.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_matrix.hpp>
+
+#include "plato/PlatoStaticsTypes.hpp"
+#include "plato/CellColoring.hpp"
+
+#include "ImplicitFunctors.hpp"
+
+namespace Plato {
+
+/******************************************************************************/
+/*!
+  \brief Small strain elastic stiffness of linear simplices, applied element by
+  element instead of being assembled.
+
+  Nothing is stored per cell: every application recomputes the cell gradients
+  from the node coordinates (ComputeGradient, ComputeGradientMatrix), forms the
+  stress from the Voigt cell stiffness and scatters the cell forces.  Dirichlet
+  dofs are treated as applyConstraints() treats the assembled matrix: their rows
+  and columns become those of the identity.  The nodal diagonal blocks can be
+  assembled on their own so that the native solver can build Jacobi, block
+  Jacobi or Chebyshev preconditioners from them.
+*/
+template<int SpaceDim>
+class MatrixFreeStiffness
+/******************************************************************************/
+{
+  private:
+    static constexpr int m_numNodesPerCell = SpaceDim+1;
+    static constexpr int m_numDofsPerCell  = SpaceDim*m_numNodesPerCell;
+    static constexpr int m_numVoigtTerms   = (SpaceDim == 3) ? 6 :
+                                            ((SpaceDim == 2) ? 3 :
+                                           (((SpaceDim == 1) ? 1 : 0)));
+
+    Omega_h::Mesh* m_mesh;
+    const Omega_h::Matrix<m_numVoigtTerms,m_numVoigtTerms> m_cellStiffness;
+    const Plato::CellColoring m_coloring;
+
+    Plato::OrdinalType  m_numDofs;
+    Plato::ScalarVector m_freeDofs; // 1 for free dofs, 0 for constrained ones
+
+  public:
+    /*!
+      \brief Constructor
+
+      \param aMesh mesh the operator is applied on
+      \param aCellStiffness Voigt stiffness of the material
+      \param aColoring cell coloring for the scatter; empty means atomic updates
+    */
+    MatrixFreeStiffness(Omega_h::Mesh* aMesh,
+                        const Omega_h::Matrix<m_numVoigtTerms,m_numVoigtTerms>& aCellStiffness,
+                        const Plato::CellColoring& aColoring = Plato::CellColoring()) :
+            m_mesh(aMesh),
+            m_cellStiffness(aCellStiffness),
+            m_coloring(aColoring),
+            m_numDofs(SpaceDim*aMesh->nverts()),
+            m_freeDofs("free dofs", m_numDofs)
+    {
+        Kokkos::deep_copy(m_freeDofs, 1.0);
+    }
+
+    // ! number of rows (and columns) of the operator
+    Plato::OrdinalType numDofs() const { return m_numDofs; }
+
+    // ! bytes of device memory held by the operator (the mesh is not counted)
+    size_t storageBytes() const
+    {
+        return m_freeDofs.size()*sizeof(Plato::Scalar) + m_coloring.cells().size()*sizeof(Plato::OrdinalType);
+    }
+
+    /*!
+      \brief Set the constrained dofs; all others are free.
+    */
+    void setConstraints(const Plato::LocalOrdinalVector aDirichletDofs)
+    {
+        Kokkos::deep_copy(m_freeDofs, 1.0);
+        auto freeDofs = m_freeDofs;
+        Kokkos::parallel_for(Kokkos::RangePolicy<int>(0, aDirichletDofs.size()), LAMBDA_EXPRESSION(int bcOrdinal)
+        {
+            freeDofs(aDirichletDofs(bcOrdinal)) = 0.0;
+        }, "matrix-free constrained dofs");
+    }
+
+    // ! y := K x, ignoring the constraints
+    void apply(const Plato::ScalarVector x, const Plato::ScalarVector y) const
+    {
+        applyStiffness(x, y, /*constrained=*/false);
+    }
+
+    // ! y := K x with the rows and columns of constrained dofs replaced by the identity
+    void applyConstrained(const Plato::ScalarVector x, const Plato::ScalarVector y) const
+    {
+        applyStiffness(x, y, /*constrained=*/true);
+    }
+
+    /*!
+      \brief Cell by cell application of the stiffness.  Public only because it
+      defines device lambdas.
+    */
+    void applyStiffness(const Plato::ScalarVector x, const Plato::ScalarVector y, bool constrained) const
+    {
+        auto freeDofs = m_freeDofs;
+        Kokkos::parallel_for(Kokkos::RangePolicy<int>(0, m_numDofs), LAMBDA_EXPRESSION(int dofOrdinal)
+        {
+            y(dofOrdinal) = constrained ? (1.0 - freeDofs(dofOrdinal))*x(dofOrdinal) : 0.0;
+        }, "matrix-free stiffness identity");
+
+        Scalar quadratureWeight = 1.0; // for a 1-point quadrature rule for simplices
+        for(int d = 2; d <= SpaceDim; d++)
+        {
+            quadratureWeight /= Scalar(d);
+        }
+
+        Plato::NodeCoordinate<SpaceDim> nodeCoordinate(m_mesh);
+        Plato::ComputeGradient<SpaceDim> computeGradient(nodeCoordinate);
+        Plato::ComputeGradientMatrix<SpaceDim> computeGradientMatrix;
+        auto cellStiffness = m_cellStiffness;
+        auto cells2nodes = m_mesh->ask_elem_verts();
+        const bool atomic = m_coloring.empty();
+
+        m_coloring.for_each_cell(m_mesh->nelems(), LAMBDA_EXPRESSION(const Plato::OrdinalType & cellOrdinal)
+        {
+            Scalar cellVolume;
+            Omega_h::Vector<SpaceDim> gradients[m_numNodesPerCell];
+            computeGradient(cellOrdinal, gradients, cellVolume);
+            cellVolume *= quadratureWeight;
+
+            Omega_h::Vector<m_numVoigtTerms> gradientMatrix[m_numDofsPerCell];
+            computeGradientMatrix(gradients, gradientMatrix);
+
+            Plato::OrdinalType dofOrdinals[m_numDofsPerCell];
+            Plato::Scalar mask[m_numDofsPerCell];
+            for(int iNode = 0; iNode < m_numNodesPerCell; iNode++)
+            {
+                auto nodeOrdinal = cells2nodes[cellOrdinal*m_numNodesPerCell + iNode];
+                for(int iDim = 0; iDim < SpaceDim; iDim++)
+                {
+                    auto dofOrdinal = SpaceDim*nodeOrdinal + iDim;
+                    dofOrdinals[SpaceDim*iNode + iDim] = dofOrdinal;
+                    mask[SpaceDim*iNode + iDim] = constrained ? freeDofs(dofOrdinal) : 1.0;
+                }
+            }
+
+            Omega_h::Vector<m_numVoigtTerms> strain = Omega_h::zero_vector<m_numVoigtTerms>();
+            for(int iDof = 0; iDof < m_numDofsPerCell; iDof++)
+            {
+                strain = strain + gradientMatrix[iDof] * (mask[iDof]*x(dofOrdinals[iDof]));
+            }
+            Omega_h::Vector<m_numVoigtTerms> stress = cellStiffness * strain;
+
+            for(int iDof = 0; iDof < m_numDofsPerCell; iDof++)
+            {
+                Plato::Scalar force = mask[iDof] * (gradientMatrix[iDof] * stress) * cellVolume;
+                Plato::assemble_add(atomic, y(dofOrdinals[iDof]), force);
+            }
+        }, "matrix-free stiffness");
+    }
+
+    /*!
+      \brief The right hand side that goes with applyConstrained(): on free dofs
+      b - K u, with u the Dirichlet values, and the Dirichlet values on
+      constrained dofs.  Call setConstraints() first.
+    */
+    void liftConstraints(const Plato::ScalarVector aRhs,
+                         const Plato::LocalOrdinalVector aDirichletDofs,
+                         const Plato::ScalarVector aDirichletValues) const
+    {
+        Plato::ScalarVector dirichlet("Dirichlet values", m_numDofs);
+        Plato::ScalarVector dirichletForce("Dirichlet force", m_numDofs);
+        Kokkos::parallel_for(Kokkos::RangePolicy<int>(0, aDirichletDofs.size()), LAMBDA_EXPRESSION(int bcOrdinal)
+        {
+            dirichlet(aDirichletDofs(bcOrdinal)) = aDirichletValues(bcOrdinal);
+        }, "matrix-free Dirichlet values");
+
+        this->apply(dirichlet, dirichletForce);
+
+        auto freeDofs = m_freeDofs;
+        Kokkos::parallel_for(Kokkos::RangePolicy<int>(0, m_numDofs), LAMBDA_EXPRESSION(int dofOrdinal)
+        {
+            aRhs(dofOrdinal) = freeDofs(dofOrdinal) * (aRhs(dofOrdinal) - dirichletForce(dofOrdinal))
+                             + (1.0 - freeDofs(dofOrdinal)) * dirichlet(dofOrdinal);
+        }, "matrix-free Dirichlet lift");
+    }
+
+    /*!
+      \brief Assemble only the SpaceDim x SpaceDim diagonal blocks, with the
+      constraints applied, as a block diagonal matrix.
+    */
+    Teuchos::RCP<Plato::CrsMatrixType> diagonalBlocks() const
+    {
+        constexpr int blockEntries = SpaceDim*SpaceDim;
+        const Plato::OrdinalType numNodes = m_mesh->nverts();
+
+        Plato::CrsMatrixType::RowMapVector  rowMap("diagonal row map", numNodes + 1);
+        Plato::CrsMatrixType::OrdinalVector columnIndices("diagonal column indices", numNodes);
+        Plato::CrsMatrixType::ScalarVector  entries("diagonal entries", numNodes*blockEntries);
+        Kokkos::parallel_for(Kokkos::RangePolicy<int>(0, numNodes + 1), LAMBDA_EXPRESSION(int nodeOrdinal)
+        {
+            rowMap(nodeOrdinal) = nodeOrdinal;
+            if(nodeOrdinal < numNodes) columnIndices(nodeOrdinal) = nodeOrdinal;
+        }, "diagonal graph");
+
+        Scalar quadratureWeight = 1.0; // for a 1-point quadrature rule for simplices
+        for(int d = 2; d <= SpaceDim; d++)
+        {
+            quadratureWeight /= Scalar(d);
+        }
+
+        Plato::NodeCoordinate<SpaceDim> nodeCoordinate(m_mesh);
+        Plato::ComputeGradient<SpaceDim> computeGradient(nodeCoordinate);
+        Plato::ComputeGradientMatrix<SpaceDim> computeGradientMatrix;
+        auto cellStiffness = m_cellStiffness;
+        auto cells2nodes = m_mesh->ask_elem_verts();
+        const bool atomic = m_coloring.empty();
+
+        m_coloring.for_each_cell(m_mesh->nelems(), LAMBDA_EXPRESSION(const Plato::OrdinalType & cellOrdinal)
+        {
+            Scalar cellVolume;
+            Omega_h::Vector<SpaceDim> gradients[m_numNodesPerCell];
+            computeGradient(cellOrdinal, gradients, cellVolume);
+            cellVolume *= quadratureWeight;
+
+            Omega_h::Vector<m_numVoigtTerms> gradientMatrix[m_numDofsPerCell];
+            computeGradientMatrix(gradients, gradientMatrix);
+
+            for(int iNode = 0; iNode < m_numNodesPerCell; iNode++)
+            {
+                auto nodeOrdinal = cells2nodes[cellOrdinal*m_numNodesPerCell + iNode];
+                for(int iDim = 0; iDim < SpaceDim; iDim++)
+                {
+                    for(int jDim = 0; jDim < SpaceDim; jDim++)
+                    {
+                        Plato::Scalar integral = (gradientMatrix[SpaceDim*iNode + iDim] *
+                                                 (cellStiffness * gradientMatrix[SpaceDim*iNode + jDim])) * cellVolume;
+                        Plato::assemble_add(atomic, entries(nodeOrdinal*blockEntries + iDim*SpaceDim + jDim), integral);
+                    }
+                }
+            }
+        }, "matrix-free diagonal blocks");
+
+        // identity rows and columns for constrained dofs, as in applyBlockConstraints()
+        auto freeDofs = m_freeDofs;
+        Kokkos::parallel_for(Kokkos::RangePolicy<int>(0, m_numDofs), LAMBDA_EXPRESSION(int dofOrdinal)
+        {
+            if(freeDofs(dofOrdinal) != 0.0) return;
+            auto nodeOrdinal = dofOrdinal / SpaceDim;
+            auto iDim = dofOrdinal % SpaceDim;
+            for(int jDim = 0; jDim < SpaceDim; jDim++)
+            {
+                entries(nodeOrdinal*blockEntries + iDim*SpaceDim + jDim) = 0.0;
+                entries(nodeOrdinal*blockEntries + jDim*SpaceDim + iDim) = 0.0;
+            }
+            entries(nodeOrdinal*blockEntries + iDim*SpaceDim + iDim) = 1.0;
+        }, "matrix-free diagonal constraints");
+
+        return Teuchos::rcp(new Plato::CrsMatrixType(rowMap, columnIndices, entries, SpaceDim, SpaceDim));
+    }
+};
+
+} // namespace Plato
+
+#endif
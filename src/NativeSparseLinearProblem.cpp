@@ -0,0 +1,866 @@
+#include "NativeSparseLinearProblem.hpp"
+#include "ErrorHandling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace lgr {
+
+typedef Kokkos::View<Scalar*, MemSpace> NativeVector;
+
+static Scalar dot(const NativeVector a, const NativeVector b)
+{
+  Scalar result = 0.0;
+  Kokkos::parallel_reduce(
+      "native solver dot", Kokkos::RangePolicy<int>(0, a.size()),
+      LAMBDA_EXPRESSION(int i, Scalar &sum) { sum += a(i) * b(i); }, result);
+  return result;
+}
+
+static Scalar norm(const NativeVector a) { return std::sqrt(dot(a, a)); }
+
+// y := alpha * x + beta * y
+static void axpby(Scalar alpha, const NativeVector x, Scalar beta, const NativeVector y)
+{
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<int>(0, x.size()),
+      LAMBDA_EXPRESSION(int i) { y(i) = alpha * x(i) + beta * y(i); },
+      "native solver axpby");
+}
+
+// r := b - A x
+template <class Problem>
+static void residual(Problem &problem, const NativeVector x, const NativeVector b,
+                     const NativeVector r)
+{
+  problem.applyMatrix(x, r);
+  axpby(1.0, b, -1.0, r);
+}
+
+typedef Kokkos::View<Scalar**, Kokkos::LayoutRight, MemSpace> NativeMultiVector;
+typedef Kokkos::View<int*, MemSpace>                          NativeColumnList;
+
+// dots(i * numB + j) := a(columnsA(i), :) . b(columnsB(j), :), all in one pass
+struct BlockDot {
+  typedef ExecSpace                      execution_space;
+  typedef Scalar                         value_type[];
+  typedef NativeMultiVector::size_type   size_type;
+
+  const NativeMultiVector a, b;
+  const NativeColumnList  columnsA, columnsB;
+  const int               numA, numB;
+  const size_type         value_count;
+
+  BlockDot(const NativeMultiVector a_, const NativeColumnList columnsA_, int numA_,
+           const NativeMultiVector b_, const NativeColumnList columnsB_, int numB_)
+      : a(a_), b(b_), columnsA(columnsA_), columnsB(columnsB_),
+        numA(numA_), numB(numB_), value_count(numA_ * numB_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(int row, value_type dots) const {
+    for (int i = 0; i < numA; i++) {
+      const Scalar ai = a(columnsA(i), row);
+      for (int j = 0; j < numB; j++) dots[i * numB + j] += ai * b(columnsB(j), row);
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(value_type dots) const {
+    for (size_type i = 0; i < value_count; i++) dots[i] = 0.0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(volatile value_type update, const volatile value_type source) const {
+    for (size_type i = 0; i < value_count; i++) update[i] += source[i];
+  }
+};
+
+static std::vector<Scalar> blockDot(const NativeMultiVector a, const NativeColumnList columnsA, int numA,
+                                    const NativeMultiVector b, const NativeColumnList columnsB, int numB)
+{
+  std::vector<Scalar> dots(numA * numB, 0.0);
+  Kokkos::parallel_reduce("native solver block dot", Kokkos::RangePolicy<int>(0, int(a.extent(1))),
+                          BlockDot(a, columnsA, numA, b, columnsB, numB), dots.data());
+  return dots;
+}
+
+// y(columnsY(j), :) := beta * y(columnsY(j), :) + z(columnsY(j), :)
+//                      + sum_i x(columnsX(i), :) * coefficients(i, j)
+// y may not be x.  Pass an empty z to leave it out.
+static void blockUpdate(const NativeMultiVector x, const NativeColumnList columnsX, int numX,
+                        const NativeMultiVector coefficients,
+                        Scalar beta, const NativeMultiVector y, const NativeColumnList columnsY, int numY,
+                        const NativeMultiVector z = NativeMultiVector())
+{
+  const bool haveZ = (z.extent(1) > 0);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<int>(0, int(y.extent(1))),
+      LAMBDA_EXPRESSION(int row) {
+        for (int j = 0; j < numY; j++) {
+          const int column = columnsY(j);
+          Scalar sum = (beta == 0.0) ? 0.0 : beta * y(column, row);
+          if (haveZ) sum += z(column, row);
+          for (int i = 0; i < numX; i++) sum += x(columnsX(i), row) * coefficients(i, j);
+          y(column, row) = sum;
+        }
+      },
+      "native solver block update");
+}
+
+// solves the n x n system G Y = C for the n x m matrix Y, by Gaussian
+// elimination with partial pivoting; both are row-major and overwritten.
+// Returns false if G is numerically singular.
+static bool solveSmallSystem(std::vector<Scalar> &G, int n, std::vector<Scalar> &C, int m)
+{
+  Scalar scale = 0.0;
+  for (int i = 0; i < n; i++) scale = std::max(scale, std::abs(G[i * n + i]));
+  const Scalar singularTol = 1e-13 * scale;
+  for (int k = 0; k < n; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < n; i++) {
+      if (std::abs(G[i * n + k]) > std::abs(G[pivot * n + k])) pivot = i;
+    }
+    if (!(std::abs(G[pivot * n + k]) > singularTol)) return false;
+    for (int j = 0; j < n; j++) std::swap(G[k * n + j], G[pivot * n + j]);
+    for (int j = 0; j < m; j++) std::swap(C[k * m + j], C[pivot * m + j]);
+    for (int i = k + 1; i < n; i++) {
+      const Scalar factor = G[i * n + k] / G[k * n + k];
+      for (int j = k; j < n; j++) G[i * n + j] -= factor * G[k * n + j];
+      for (int j = 0; j < m; j++) C[i * m + j] -= factor * C[k * m + j];
+    }
+  }
+  for (int k = n - 1; k >= 0; k--) {
+    for (int j = 0; j < m; j++) {
+      Scalar sum = C[k * m + j];
+      for (int l = k + 1; l < n; l++) sum -= G[k * n + l] * C[l * m + j];
+      C[k * m + j] = sum / G[k * n + k];
+    }
+  }
+  return true;
+}
+
+template <class Ordinal>
+typename NativeSparseLinearProblem<Ordinal>::SolverType
+NativeSparseLinearProblem<Ordinal>::solverType(std::string const& name)
+{
+  if (name == "CG") return CG;
+  if (name == "GMRES") return GMRES;
+  LGR_THROW_IF(true, "unknown native solver \"" << name
+      << "\", should be \"CG\" or \"GMRES\"\n");
+  return CG;
+}
+
+template <class Ordinal>
+typename NativeSparseLinearProblem<Ordinal>::PreconditionerType
+NativeSparseLinearProblem<Ordinal>::preconditionerType(std::string const& name)
+{
+  if (name == "None") return NO_PRECONDITIONER;
+  if (name == "Jacobi") return JACOBI;
+  if (name == "Block Jacobi") return BLOCK_JACOBI;
+  if (name == "Chebyshev") return CHEBYSHEV;
+  LGR_THROW_IF(true, "unknown native preconditioner \"" << name
+      << "\", should be \"None\", \"Jacobi\", \"Block Jacobi\" or \"Chebyshev\"\n");
+  return NO_PRECONDITIONER;
+}
+
+template <class Ordinal>
+NativeSparseLinearProblem<Ordinal>::NativeSparseLinearProblem(
+    const Matrix &A, Vector x, const Vector b)
+    : CrsLinearProblem<Ordinal>(A, x, b)
+{
+  auto &matrix = this->A();
+  LGR_THROW_IF(matrix.blockSizeRow() != matrix.blockSizeCol(),
+      "native solver needs square blocks\n");
+  _blockSize = matrix.blockSizeRow();
+  _numRows = (int(matrix.rowMap().size()) - 1) * _blockSize;
+  LGR_THROW_IF(int(x.size()) != _numRows || int(b.size()) != _numRows,
+      "matrix size and vector lengths do not match\n");
+}
+
+template <class Ordinal>
+NativeSparseLinearProblem<Ordinal>::NativeSparseLinearProblem(
+    const Matrix &A, Vector x, const Vector b, Teuchos::ParameterList const& params)
+    : NativeSparseLinearProblem(A, x, b)
+{
+  Teuchos::ParameterList pl(params);
+  _solverType = solverType(pl.get<std::string>("Solver", "CG"));
+  _preconditionerType = preconditionerType(pl.get<std::string>("Preconditioner", "Jacobi"));
+  _tol = pl.get<double>("Tolerance", _tol);
+  _maxIters = pl.get<int>("Maximum Iterations", _maxIters);
+  _krylovDimension = pl.get<int>("Krylov Dimension", _krylovDimension);
+  _chebyshevDegree = pl.get<int>("Chebyshev Degree", _chebyshevDegree);
+  LGR_THROW_IF(_krylovDimension < 1, "Krylov Dimension must be positive\n");
+  LGR_THROW_IF(_chebyshevDegree < 1, "Chebyshev Degree must be positive\n");
+}
+
+template <class Ordinal>
+NativeSparseLinearProblem<Ordinal>::NativeSparseLinearProblem(
+    const Matrix &A, MultiVector x, const MultiVector b, Teuchos::ParameterList const& params)
+    : NativeSparseLinearProblem(A, Vector(Kokkos::subview(x, 0, Kokkos::ALL())),
+                                Vector(Kokkos::subview(b, 0, Kokkos::ALL())), params)
+{
+  LGR_THROW_IF(x.extent(0) != b.extent(0),
+      "solution and right hand side counts do not match\n");
+  LGR_THROW_IF(int(x.extent(1)) != _numRows || int(b.extent(1)) != _numRows,
+      "matrix size and vector lengths do not match\n");
+  _X = x;
+  _B = b;
+  _numRHS = int(x.extent(0));
+}
+
+template <class Ordinal>
+void NativeSparseLinearProblem<Ordinal>::applyMatrix(const Vector x, const Vector y)
+{
+  if (_operator) {
+    _operator(x, y);
+    return;
+  }
+  this->A().Apply(x, y);
+}
+
+// one pass over the matrix for all the listed columns
+template <class Ordinal>
+void NativeSparseLinearProblem<Ordinal>::applyMatrix(const MultiVector X, const MultiVector Y,
+                                                     const ColumnList columns, int numColumns)
+{
+  if (_operator) {
+    auto columnsHost = Kokkos::create_mirror_view(columns);
+    Kokkos::deep_copy(columnsHost, columns);
+    for (int c = 0; c < numColumns; c++) {
+      _operator(Vector(Kokkos::subview(X, columnsHost(c), Kokkos::ALL())),
+                Vector(Kokkos::subview(Y, columnsHost(c), Kokkos::ALL())));
+    }
+    return;
+  }
+  auto &matrix = this->A();
+  auto rowMap = matrix.rowMap();
+  auto columnIndices = matrix.columnIndices();
+  auto entries = matrix.entries();
+  const int blockSize = _blockSize;
+  const int blockEntries = blockSize * blockSize;
+  const int numBlockRows = int(rowMap.size()) - 1;
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<int>(0, numBlockRows),
+      LAMBDA_EXPRESSION(int blockRow) {
+        for (int c = 0; c < numColumns; c++) {
+          for (int i = 0; i < blockSize; i++) Y(columns(c), blockRow * blockSize + i) = 0.0;
+        }
+        for (int entryIndex = rowMap(blockRow); entryIndex < rowMap(blockRow + 1); entryIndex++) {
+          const int blockColumn = columnIndices(entryIndex);
+          for (int c = 0; c < numColumns; c++) {
+            const int column = columns(c);
+            for (int i = 0; i < blockSize; i++) {
+              Scalar sum = 0.0;
+              for (int j = 0; j < blockSize; j++) {
+                sum += entries(entryIndex * blockEntries + i * blockSize + j) *
+                       X(column, blockColumn * blockSize + j);
+              }
+              Y(column, blockRow * blockSize + i) += sum;
+            }
+          }
+        }
+      },
+      "native solver block apply");
+}
+
+template <class Ordinal>
+void NativeSparseLinearProblem<Ordinal>::applyMatrix(const MultiVector X, const MultiVector Y)
+{
+  LGR_THROW_IF(X.extent(0) != Y.extent(0), "multivector counts do not match\n");
+  const int numColumns = int(X.extent(0));
+  ColumnList columns("native solver columns", numColumns);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<int>(0, numColumns),
+      LAMBDA_EXPRESSION(int c) { columns(c) = c; }, "native solver all columns");
+  applyMatrix(X, Y, columns, numColumns);
+}
+
+template <class Ordinal>
+void NativeSparseLinearProblem<Ordinal>::initializeSolver()
+{
+  auto &matrix = this->A();
+  auto rowMap = matrix.rowMap();
+  auto columnIndices = matrix.columnIndices();
+  auto entries = matrix.entries();
+  const int blockSize = _blockSize;
+  const int blockEntries = blockSize * blockSize;
+  const int numBlockRows = int(rowMap.size()) - 1;
+
+  // a zero on the diagonal (e.g. an empty row) is left unscaled
+  _inverseDiagonal = Vector("inverse diagonal", _numRows);
+  auto inverseDiagonal = _inverseDiagonal;
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<int>(0, numBlockRows),
+      LAMBDA_EXPRESSION(int blockRow) {
+        for (int i = 0; i < blockSize; i++) inverseDiagonal(blockRow * blockSize + i) = 1.0;
+        for (int entryIndex = rowMap(blockRow); entryIndex < rowMap(blockRow + 1); entryIndex++) {
+          if (columnIndices(entryIndex) != blockRow) continue;
+          for (int i = 0; i < blockSize; i++) {
+            const Scalar diagonal = entries(entryIndex * blockEntries + i * blockSize + i);
+            if (diagonal != 0.0) inverseDiagonal(blockRow * blockSize + i) = 1.0 / diagonal;
+          }
+        }
+      },
+      "native solver inverse diagonal");
+
+  if (_preconditionerType == BLOCK_JACOBI && blockSize > 1) {
+    LGR_THROW_IF(blockSize > MAX_BLOCK_SIZE,
+        "block Jacobi supports blocks of at most " << int(MAX_BLOCK_SIZE) << " dofs\n");
+    _inverseBlocks = Vector("inverse diagonal blocks", numBlockRows * blockEntries);
+    auto inverseBlocks = _inverseBlocks;
+    // Gauss-Jordan with partial pivoting on each diagonal block;
+    // a singular block falls back to the point Jacobi scaling
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<int>(0, numBlockRows),
+        LAMBDA_EXPRESSION(int blockRow) {
+          constexpr int N = MAX_BLOCK_SIZE;
+          Scalar a[N][N], inv[N][N];
+          for (int i = 0; i < blockSize; i++) {
+            for (int j = 0; j < blockSize; j++) {
+              a[i][j] = 0.0;
+              inv[i][j] = (i == j) ? 1.0 : 0.0;
+            }
+          }
+          for (int entryIndex = rowMap(blockRow); entryIndex < rowMap(blockRow + 1); entryIndex++) {
+            if (columnIndices(entryIndex) != blockRow) continue;
+            for (int i = 0; i < blockSize; i++) {
+              for (int j = 0; j < blockSize; j++) {
+                a[i][j] = entries(entryIndex * blockEntries + i * blockSize + j);
+              }
+            }
+          }
+          bool singular = false;
+          for (int k = 0; k < blockSize && !singular; k++) {
+            int pivot = k;
+            for (int i = k + 1; i < blockSize; i++) {
+              if (fabs(a[i][k]) > fabs(a[pivot][k])) pivot = i;
+            }
+            if (a[pivot][k] == 0.0) {
+              singular = true;
+              break;
+            }
+            for (int j = 0; j < blockSize; j++) {
+              Scalar tmp = a[k][j]; a[k][j] = a[pivot][j]; a[pivot][j] = tmp;
+              tmp = inv[k][j]; inv[k][j] = inv[pivot][j]; inv[pivot][j] = tmp;
+            }
+            const Scalar scale = 1.0 / a[k][k];
+            for (int j = 0; j < blockSize; j++) {
+              a[k][j] *= scale;
+              inv[k][j] *= scale;
+            }
+            for (int i = 0; i < blockSize; i++) {
+              if (i == k) continue;
+              const Scalar factor = a[i][k];
+              for (int j = 0; j < blockSize; j++) {
+                a[i][j] -= factor * a[k][j];
+                inv[i][j] -= factor * inv[k][j];
+              }
+            }
+          }
+          for (int i = 0; i < blockSize; i++) {
+            for (int j = 0; j < blockSize; j++) {
+              Scalar value = inv[i][j];
+              if (singular) value = (i == j) ? inverseDiagonal(blockRow * blockSize + i) : 0.0;
+              inverseBlocks(blockRow * blockEntries + i * blockSize + j) = value;
+            }
+          }
+        },
+        "native solver inverse blocks");
+  }
+
+  if (_preconditionerType == CHEBYSHEV) {
+    _chebyshevUpdate = Vector("chebyshev update", _numRows);
+    _chebyshevResidual = Vector("chebyshev residual", _numRows);
+    estimateLambdaMax();
+  }
+
+  _haveInitialized = true;
+}
+
+// power iteration on D^-1 A.  As in Ifpack2, the largest eigenvalue is
+// padded by 10% and the smallest one is taken as a fixed fraction of it.
+template <class Ordinal>
+void NativeSparseLinearProblem<Ordinal>::estimateLambdaMax()
+{
+  const int powerIterations = 10;
+  const Scalar eigenRatio = 30.0;
+  Vector v("power iteration vector", _numRows);
+  Vector w("power iteration image", _numRows);
+  // a deterministic vector that is unlikely to miss the dominant mode
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<int>(0, _numRows),
+      LAMBDA_EXPRESSION(int i) { v(i) = 1.0 + Scalar((i * 7919) % 101) / 101.0; },
+      "native solver power iteration start");
+  auto inverseDiagonal = _inverseDiagonal;
+  Scalar lambda = 0.0;
+  for (int iteration = 0; iteration < powerIterations; iteration++) {
+    const Scalar vNorm = norm(v);
+    if (vNorm == 0.0) break;
+    axpby(0.0, v, 1.0 / vNorm, v);
+    applyMatrix(v, w);
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<int>(0, _numRows),
+        LAMBDA_EXPRESSION(int i) { w(i) *= inverseDiagonal(i); },
+        "native solver power iteration scale");
+    lambda = dot(v, w);
+    Kokkos::deep_copy(v, w);
+  }
+  LGR_THROW_IF(!(lambda > 0.0),
+      "Chebyshev preconditioner needs a positive eigenvalue estimate\n");
+  _lambdaMax = 1.1 * lambda;
+  _lambdaMin = _lambdaMax / eigenRatio;
+}
+
+template <class Ordinal>
+void NativeSparseLinearProblem<Ordinal>::applyPreconditioner(const Vector r, const Vector z)
+{
+  const int numRows = _numRows;
+  auto inverseDiagonal = _inverseDiagonal;
+  if (_preconditionerType == NO_PRECONDITIONER) {
+    Kokkos::deep_copy(z, r);
+  } else if (_preconditionerType == JACOBI ||
+             (_preconditionerType == BLOCK_JACOBI && _blockSize == 1)) {
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<int>(0, numRows),
+        LAMBDA_EXPRESSION(int i) { z(i) = inverseDiagonal(i) * r(i); },
+        "native solver jacobi");
+  } else if (_preconditionerType == BLOCK_JACOBI) {
+    auto inverseBlocks = _inverseBlocks;
+    const int blockSize = _blockSize;
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<int>(0, numRows),
+        LAMBDA_EXPRESSION(int row) {
+          const int blockRow = row / blockSize;
+          const int i = row % blockSize;
+          const int blockOffset = (blockRow * blockSize + i) * blockSize;
+          Scalar sum = 0.0;
+          for (int j = 0; j < blockSize; j++) {
+            sum += inverseBlocks(blockOffset + j) * r(blockRow * blockSize + j);
+          }
+          z(row) = sum;
+        },
+        "native solver block jacobi");
+  } else {
+    // Chebyshev iteration for A z = r starting from z = 0 (Saad, Algorithm 12.1),
+    // scaled by the diagonal
+    const Scalar theta = 0.5 * (_lambdaMax + _lambdaMin);
+    const Scalar delta = 0.5 * (_lambdaMax - _lambdaMin);
+    const Scalar sigma = theta / delta;
+    Scalar rho = 1.0 / sigma;
+    auto d = _chebyshevUpdate;
+    auto res = _chebyshevResidual;
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<int>(0, numRows),
+        LAMBDA_EXPRESSION(int i) {
+          d(i) = inverseDiagonal(i) * r(i) / theta;
+          z(i) = d(i);
+        },
+        "native solver chebyshev start");
+    for (int k = 1; k < _chebyshevDegree; k++) {
+      residual(*this, z, r, res);
+      const Scalar rhoNew = 1.0 / (2.0 * sigma - rho);
+      const Scalar dScale = rhoNew * rho;
+      const Scalar resScale = 2.0 * rhoNew / delta;
+      Kokkos::parallel_for(
+          Kokkos::RangePolicy<int>(0, numRows),
+          LAMBDA_EXPRESSION(int i) {
+            d(i) = dScale * d(i) + resScale * inverseDiagonal(i) * res(i);
+            z(i) += d(i);
+          },
+          "native solver chebyshev update");
+      rho = rhoNew;
+    }
+  }
+}
+
+// the multivector version of the above, for the listed columns
+template <class Ordinal>
+void NativeSparseLinearProblem<Ordinal>::applyPreconditioner(const MultiVector R, const MultiVector Z,
+                                                             const ColumnList columns, int numColumns)
+{
+  const int numRows = _numRows;
+  auto inverseDiagonal = _inverseDiagonal;
+  if (_preconditionerType == NO_PRECONDITIONER) {
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<int>(0, numRows),
+        LAMBDA_EXPRESSION(int i) {
+          for (int c = 0; c < numColumns; c++) Z(columns(c), i) = R(columns(c), i);
+        },
+        "native solver block copy");
+  } else if (_preconditionerType == JACOBI ||
+             (_preconditionerType == BLOCK_JACOBI && _blockSize == 1)) {
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<int>(0, numRows),
+        LAMBDA_EXPRESSION(int i) {
+          for (int c = 0; c < numColumns; c++) Z(columns(c), i) = inverseDiagonal(i) * R(columns(c), i);
+        },
+        "native solver block jacobi");
+  } else if (_preconditionerType == BLOCK_JACOBI) {
+    auto inverseBlocks = _inverseBlocks;
+    const int blockSize = _blockSize;
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<int>(0, numRows),
+        LAMBDA_EXPRESSION(int row) {
+          const int blockRow = row / blockSize;
+          const int i = row % blockSize;
+          const int blockOffset = (blockRow * blockSize + i) * blockSize;
+          for (int c = 0; c < numColumns; c++) {
+            const int column = columns(c);
+            Scalar sum = 0.0;
+            for (int j = 0; j < blockSize; j++) {
+              sum += inverseBlocks(blockOffset + j) * R(column, blockRow * blockSize + j);
+            }
+            Z(column, row) = sum;
+          }
+        },
+        "native solver block block jacobi");
+  } else {
+    const Scalar theta = 0.5 * (_lambdaMax + _lambdaMin);
+    const Scalar delta = 0.5 * (_lambdaMax - _lambdaMin);
+    const Scalar sigma = theta / delta;
+    Scalar rho = 1.0 / sigma;
+    if (_chebyshevUpdates.extent(0) < R.extent(0)) {
+      _chebyshevUpdates = MultiVector("chebyshev updates", R.extent(0), numRows);
+      _chebyshevResiduals = MultiVector("chebyshev residuals", R.extent(0), numRows);
+    }
+    auto d = _chebyshevUpdates;
+    auto res = _chebyshevResiduals;
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<int>(0, numRows),
+        LAMBDA_EXPRESSION(int i) {
+          for (int c = 0; c < numColumns; c++) {
+            const int column = columns(c);
+            d(column, i) = inverseDiagonal(i) * R(column, i) / theta;
+            Z(column, i) = d(column, i);
+          }
+        },
+        "native solver block chebyshev start");
+    for (int k = 1; k < _chebyshevDegree; k++) {
+      applyMatrix(Z, res, columns, numColumns);
+      const Scalar rhoNew = 1.0 / (2.0 * sigma - rho);
+      const Scalar dScale = rhoNew * rho;
+      const Scalar resScale = 2.0 * rhoNew / delta;
+      Kokkos::parallel_for(
+          Kokkos::RangePolicy<int>(0, numRows),
+          LAMBDA_EXPRESSION(int i) {
+            for (int c = 0; c < numColumns; c++) {
+              const int column = columns(c);
+              d(column, i) = dScale * d(column, i) +
+                             resScale * inverseDiagonal(i) * (R(column, i) - res(column, i));
+              Z(column, i) += d(column, i);
+            }
+          },
+          "native solver block chebyshev update");
+      rho = rhoNew;
+    }
+  }
+}
+
+template <class Ordinal>
+void NativeSparseLinearProblem<Ordinal>::applyPreconditioner(const MultiVector R, const MultiVector Z)
+{
+  LGR_THROW_IF(R.extent(0) != Z.extent(0), "multivector counts do not match\n");
+  if (!_haveInitialized) initializeSolver();
+  const int numColumns = int(R.extent(0));
+  ColumnList columns("native solver columns", numColumns);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<int>(0, numColumns),
+      LAMBDA_EXPRESSION(int c) { columns(c) = c; }, "native solver all columns");
+  applyPreconditioner(R, Z, columns, numColumns);
+}
+
+template <class Ordinal>
+int NativeSparseLinearProblem<Ordinal>::solveCG()
+{
+  auto x = this->x();
+  auto b = this->b();
+  Vector r("cg residual", _numRows);
+  Vector z("cg preconditioned residual", _numRows);
+  Vector p("cg direction", _numRows);
+  Vector q("cg matrix times direction", _numRows);
+
+  const Scalar bNorm = norm(b);
+  _iterationsTaken = 0;
+  if (bNorm == 0.0) {
+    Kokkos::deep_copy(x, 0.0);
+    _residualEstimate = 0.0;
+    return 0;
+  }
+  residual(*this, x, b, r);
+  Scalar rNorm = norm(r);
+  applyPreconditioner(r, z);
+  Kokkos::deep_copy(p, z);
+  Scalar rz = dot(r, z);
+  while (rNorm > _tol * bNorm && _iterationsTaken < _maxIters) {
+    applyMatrix(p, q);
+    const Scalar alpha = rz / dot(p, q);
+    axpby(alpha, p, 1.0, x);
+    axpby(-alpha, q, 1.0, r);
+    rNorm = norm(r);
+    _iterationsTaken++;
+    if (rNorm <= _tol * bNorm) break;
+    applyPreconditioner(r, z);
+    const Scalar rzNew = dot(r, z);
+    axpby(1.0, z, rzNew / rz, p);
+    rz = rzNew;
+  }
+  _residualEstimate = rNorm / bNorm;
+  return (rNorm <= _tol * bNorm) ? 0 : 1;
+}
+
+// restarted GMRES, right preconditioned so the residual it monitors is the
+// true one, with modified Gram-Schmidt and Givens rotations
+template <class Ordinal>
+int NativeSparseLinearProblem<Ordinal>::solveGMRES()
+{
+  auto x = this->x();
+  auto b = this->b();
+  const int m = _krylovDimension;
+  MultiVector V("gmres basis", m + 1, _numRows);
+  Vector r("gmres residual", _numRows);
+  Vector z("gmres preconditioned vector", _numRows);
+  Vector w("gmres new vector", _numRows);
+  std::vector<Scalar> H((m + 1) * m), cs(m), sn(m), g(m + 1), y(m);
+  auto h = [&](int i, int j) -> Scalar& { return H[i * m + j]; };
+
+  const Scalar bNorm = norm(b);
+  _iterationsTaken = 0;
+  if (bNorm == 0.0) {
+    Kokkos::deep_copy(x, 0.0);
+    _residualEstimate = 0.0;
+    return 0;
+  }
+  residual(*this, x, b, r);
+  Scalar beta = norm(r);
+  while (beta > _tol * bNorm && _iterationsTaken < _maxIters) {
+    Vector v0 = Kokkos::subview(V, 0, Kokkos::ALL());
+    axpby(1.0 / beta, r, 0.0, v0);
+    for (auto &gi : g) gi = 0.0;
+    g[0] = beta;
+    int k = 0;
+    for (int j = 0; j < m && _iterationsTaken < _maxIters; j++) {
+      Vector vj = Kokkos::subview(V, j, Kokkos::ALL());
+      applyPreconditioner(vj, z);
+      applyMatrix(z, w);
+      for (int i = 0; i <= j; i++) {
+        Vector vi = Kokkos::subview(V, i, Kokkos::ALL());
+        h(i, j) = dot(w, vi);
+        axpby(-h(i, j), vi, 1.0, w);
+      }
+      h(j + 1, j) = norm(w);
+      if (h(j + 1, j) > 0.0) {
+        Vector vNext = Kokkos::subview(V, j + 1, Kokkos::ALL());
+        axpby(1.0 / h(j + 1, j), w, 0.0, vNext);
+      }
+      for (int i = 0; i < j; i++) {
+        const Scalar tmp = cs[i] * h(i, j) + sn[i] * h(i + 1, j);
+        h(i + 1, j) = -sn[i] * h(i, j) + cs[i] * h(i + 1, j);
+        h(i, j) = tmp;
+      }
+      const Scalar denominator = std::hypot(h(j, j), h(j + 1, j));
+      cs[j] = (denominator == 0.0) ? 1.0 : h(j, j) / denominator;
+      sn[j] = (denominator == 0.0) ? 0.0 : h(j + 1, j) / denominator;
+      h(j, j) = cs[j] * h(j, j) + sn[j] * h(j + 1, j);
+      h(j + 1, j) = 0.0;
+      g[j + 1] = -sn[j] * g[j];
+      g[j] = cs[j] * g[j];
+      _iterationsTaken++;
+      k = j + 1;
+      if (std::abs(g[j + 1]) <= _tol * bNorm || denominator == 0.0) break;
+    }
+    for (int i = k - 1; i >= 0; i--) {
+      Scalar sum = g[i];
+      for (int l = i + 1; l < k; l++) sum -= h(i, l) * y[l];
+      y[i] = (h(i, i) == 0.0) ? 0.0 : sum / h(i, i);
+    }
+    Kokkos::deep_copy(w, 0.0);
+    for (int i = 0; i < k; i++) {
+      Vector vi = Kokkos::subview(V, i, Kokkos::ALL());
+      axpby(y[i], vi, 1.0, w);
+    }
+    applyPreconditioner(w, z);
+    axpby(1.0, z, 1.0, x);
+    residual(*this, x, b, r);
+    const Scalar previousBeta = beta;
+    beta = norm(r);
+    // no progress over a whole cycle means GMRES has stagnated
+    if (beta >= previousBeta) break;
+  }
+  _residualEstimate = beta / bNorm;
+  return (beta <= _tol * bNorm) ? 0 : 1;
+}
+
+// Block CG (O'Leary 1980) in the form where each new block of directions is
+// made A-conjugate to the previous one explicitly:
+//   alpha = (P^T A P)^-1 P^T R,  X += P alpha,  R -= A P alpha
+//   beta = -(P^T A P)^-1 (A P)^T Z,  P = Z + P beta
+// Converged columns leave the block, so a slow column does not keep the
+// others iterating; if the block becomes numerically rank deficient (e.g.
+// repeated right-hand sides) the remaining columns finish with plain CG.
+template <class Ordinal>
+int NativeSparseLinearProblem<Ordinal>::solveBlockCG()
+{
+  const int numRHS = _numRHS;
+  auto X = _X;
+  auto B = _B;
+  MultiVector R("block cg residual", numRHS, _numRows);
+  MultiVector Z("block cg preconditioned residual", numRHS, _numRows);
+  MultiVector P("block cg direction", numRHS, _numRows);
+  MultiVector PNext("block cg next direction", numRHS, _numRows);
+  MultiVector Q("block cg matrix times direction", numRHS, _numRows);
+  MultiVector coefficients("block cg coefficients", numRHS, numRHS);
+  auto coefficientsHost = Kokkos::create_mirror_view(coefficients);
+  ColumnList active("block cg active columns", numRHS);
+  ColumnList next("block cg next columns", numRHS);
+  auto activeHost = Kokkos::create_mirror_view(active);
+  auto nextHost = Kokkos::create_mirror_view(next);
+
+  auto setCoefficients = [&](const std::vector<Scalar> &values, int n, int m, Scalar scale) {
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < m; j++) coefficientsHost(i, j) = scale * values[i * m + j];
+    }
+    Kokkos::deep_copy(coefficients, coefficientsHost);
+  };
+
+  for (int c = 0; c < numRHS; c++) activeHost(c) = c;
+  Kokkos::deep_copy(active, activeHost);
+  auto bDots = blockDot(B, active, numRHS, B, active, numRHS);
+  std::vector<Scalar> bNorms(numRHS), rNorms(numRHS, 0.0);
+  for (int c = 0; c < numRHS; c++) bNorms[c] = std::sqrt(bDots[c * numRHS + c]);
+
+  applyMatrix(X, R, active, numRHS);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<int>(0, _numRows),
+      LAMBDA_EXPRESSION(int i) {
+        for (int c = 0; c < numRHS; c++) R(c, i) = B(c, i) - R(c, i);
+      },
+      "native solver block residual");
+  auto rDots = blockDot(R, active, numRHS, R, active, numRHS);
+
+  // the active block: right-hand sides that are nonzero and not yet converged;
+  // next gets the columns of the current block that are still not converged
+  int numActive = 0;
+  auto updateActive = [&](const std::vector<Scalar> &dots, int numOld) {
+    int numNext = 0;
+    for (int c = 0; c < numOld; c++) {
+      const int column = activeHost(c);
+      rNorms[column] = std::sqrt(std::max(dots[c * numOld + c], 0.0));
+      if (bNorms[column] == 0.0) continue;
+      if (rNorms[column] > _tol * bNorms[column]) nextHost(numNext++) = column;
+    }
+    Kokkos::deep_copy(next, nextHost);
+    return numNext;
+  };
+  for (int c = 0; c < numRHS; c++) {
+    if (bNorms[c] == 0.0) {
+      Kokkos::deep_copy(Kokkos::subview(X, c, Kokkos::ALL()), 0.0);
+    }
+  }
+  numActive = updateActive(rDots, numRHS);
+  Kokkos::deep_copy(activeHost, nextHost);
+  Kokkos::deep_copy(active, next);
+
+  _iterationsTaken = 0;
+  bool brokeDown = false;
+  if (numActive > 0) {
+    applyPreconditioner(R, Z, active, numActive);
+    Kokkos::deep_copy(P, Z);
+  }
+  while (numActive > 0 && _iterationsTaken < _maxIters) {
+    applyMatrix(P, Q, active, numActive);
+    auto G = blockDot(P, active, numActive, Q, active, numActive);
+    auto alpha = blockDot(P, active, numActive, R, active, numActive);
+    if (!solveSmallSystem(G, numActive, alpha, numActive)) {
+      brokeDown = true;
+      break;
+    }
+    setCoefficients(alpha, numActive, numActive, 1.0);
+    blockUpdate(P, active, numActive, coefficients, 1.0, X, active, numActive);
+    setCoefficients(alpha, numActive, numActive, -1.0);
+    blockUpdate(Q, active, numActive, coefficients, 1.0, R, active, numActive);
+    _iterationsTaken++;
+
+    const int numNext = updateActive(blockDot(R, active, numActive, R, active, numActive), numActive);
+    if (numNext == 0) {
+      numActive = 0;
+      break;
+    }
+
+    // the next directions are conjugate to the whole current block,
+    // including the columns that just converged
+    applyPreconditioner(R, Z, next, numNext);
+    auto beta = blockDot(Q, active, numActive, Z, next, numNext);
+    G = blockDot(P, active, numActive, Q, active, numActive);
+    if (!solveSmallSystem(G, numActive, beta, numNext)) {
+      Kokkos::deep_copy(activeHost, nextHost);
+      Kokkos::deep_copy(active, next);
+      numActive = numNext;
+      brokeDown = true;
+      break;
+    }
+    setCoefficients(beta, numActive, numNext, -1.0);
+    blockUpdate(P, active, numActive, coefficients, 0.0, PNext, next, numNext, Z);
+    std::swap(P, PNext);
+
+    Kokkos::deep_copy(activeHost, nextHost);
+    Kokkos::deep_copy(active, next);
+    numActive = numNext;
+  }
+
+  int result = 0;
+  if (brokeDown) {
+    std::vector<int> remaining(numActive);
+    for (int c = 0; c < numActive; c++) remaining[c] = activeHost(c);
+    const int blockIterations = _iterationsTaken;
+    result = solveEachColumn(remaining);
+    _iterationsTaken += blockIterations;
+    for (int column : remaining) rNorms[column] = _residualEstimate * bNorms[column];
+  } else if (numActive > 0) {
+    result = 1;
+  }
+  _residualEstimate = 0.0;
+  for (int c = 0; c < numRHS; c++) {
+    if (bNorms[c] > 0.0) _residualEstimate = std::max(_residualEstimate, rNorms[c] / bNorms[c]);
+  }
+  return result;
+}
+
+// points x() and b() at each listed right-hand side in turn
+template <class Ordinal>
+int NativeSparseLinearProblem<Ordinal>::solveEachColumn(const std::vector<int> &columns)
+{
+  int result = 0;
+  int iterations = 0;
+  double residualEstimate = 0.0;
+  for (int column : columns) {
+    this->x() = Vector(Kokkos::subview(_X, column, Kokkos::ALL()));
+    this->b() = Vector(Kokkos::subview(_B, column, Kokkos::ALL()));
+    result = std::max(result, (_solverType == GMRES) ? solveGMRES() : solveCG());
+    iterations += _iterationsTaken;
+    residualEstimate = std::max(residualEstimate, _residualEstimate);
+  }
+  this->x() = Vector(Kokkos::subview(_X, 0, Kokkos::ALL()));
+  this->b() = Vector(Kokkos::subview(_B, 0, Kokkos::ALL()));
+  _iterationsTaken = iterations;
+  _residualEstimate = residualEstimate;
+  return result;
+}
+
+template <class Ordinal>
+int NativeSparseLinearProblem<Ordinal>::solve()
+{
+  if (!_haveInitialized) initializeSolver();
+  if (_numRHS > 1) {
+    if (_solverType == CG) return solveBlockCG();
+    std::vector<int> columns(_numRHS);
+    for (int c = 0; c < _numRHS; c++) columns[c] = c;
+    return solveEachColumn(columns);
+  }
+  if (_solverType == GMRES) return solveGMRES();
+  return solveCG();
+}
+
+template class NativeSparseLinearProblem<int>;
+
+}  // namespace lgr
@@ -0,0 +1,157 @@
+//
+//  NativeSparseLinearProblem.hpp
+//
+//
+
+#ifndef LGR_NATIVE_SPARSE_LINEAR_PROBLEM_HPP
+#define LGR_NATIVE_SPARSE_LINEAR_PROBLEM_HPP
+
+#include <CrsLinearProblem.hpp>
+#include <Teuchos_ParameterList.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace lgr {
+  // Preconditioned Krylov solvers written directly against lgr::CrsMatrix,
+  // so that implicit problems can be solved on builds without AmgX, ViennaCL
+  // or Tpetra.  Kernels are Kokkos parallel_for/parallel_reduce, so they are
+  // threaded by whichever host execution space Kokkos was built with.
+  // Block matrices (blockSizeRow() == blockSizeCol() > 1) are supported.
+  // Like the ViennaCL interface, this assumes exactly one MPI rank.
+  //
+  // Several right-hand sides (rows of a MultiVector) share one preconditioner
+  // setup.  CG solves them together with block CG, so each iteration makes one
+  // pass over the matrix for all of them; columns are dropped from the block
+  // as they converge.  GMRES solves them one after another.
+  //
+  // setOperator() swaps the matrix for an operator that is only available as a
+  // function (e.g. a matrix-free stiffness); A then only supplies the diagonal
+  // (blocks) that the preconditioners are built from.
+  //
+  // Parameters, all optional:
+  //   "Solver":             "CG" (default) or "GMRES"
+  //   "Preconditioner":     "None", "Jacobi" (default), "Block Jacobi" or "Chebyshev"
+  //   "Tolerance":          residual norm relative to the RHS norm (1e-10)
+  //   "Maximum Iterations": 1000
+  //   "Krylov Dimension":   GMRES restart length (50)
+  //   "Chebyshev Degree":   polynomial degree of the Chebyshev preconditioner (3)
+  template<class Ordinal>
+  class NativeSparseLinearProblem : public CrsLinearProblem<Ordinal>
+  {
+  public:
+    enum SolverType
+    {
+      CG,
+      GMRES
+    };
+    enum PreconditionerType
+    {
+      NO_PRECONDITIONER,
+      JACOBI,
+      BLOCK_JACOBI,
+      CHEBYSHEV
+    };
+    // largest diagonal block the block Jacobi preconditioner inverts
+    static constexpr int MAX_BLOCK_SIZE = 8;
+
+    typedef typename CrsLinearProblem<Ordinal>::Vector      Vector;
+    typedef typename CrsLinearProblem<Ordinal>::MultiVector MultiVector;
+    // y := A x
+    typedef std::function<void(const Vector, const Vector)> Operator;
+  private:
+    typedef CrsMatrix<Ordinal, int> Matrix;
+    typedef Kokkos::View<int*, MemSpace> ColumnList;
+
+    SolverType         _solverType = CG;
+    PreconditionerType _preconditionerType = JACOBI;
+
+    int    _maxIters = 1000;
+    double _tol = 1e-10;
+    int    _krylovDimension = 50;
+    int    _chebyshevDegree = 3;
+
+    int    _iterationsTaken = -1;
+    double _residualEstimate = -1.0;
+
+    int  _blockSize;  // dofs per block row; 1 for scalar matrices
+    int  _numRows;    // dofs
+    int  _numRHS = 1;
+    MultiVector _X, _B; // all right-hand sides; x() and b() are the first one
+    bool _haveInitialized = false;
+
+    Vector _inverseDiagonal; // point Jacobi, also used to scale Chebyshev
+    Vector _inverseBlocks;   // inverted diagonal blocks, row-major
+    Scalar _lambdaMax = 0.0; // eigenvalue bounds of D^-1 A for Chebyshev
+    Scalar _lambdaMin = 0.0;
+
+    Vector _chebyshevUpdate, _chebyshevResidual;
+    MultiVector _chebyshevUpdates, _chebyshevResiduals; // several right-hand sides
+
+    Operator _operator; // applied instead of A when set
+
+    void estimateLambdaMax();
+    int solveCG();
+    int solveGMRES();
+    int solveBlockCG();
+    // solves the listed right-hand sides one at a time, starting from the current X
+    int solveEachColumn(const std::vector<int> &columns);
+
+    // the multivector operations act only on the listed rows of X, Y, R, Z
+    void applyMatrix(const MultiVector X, const MultiVector Y, const ColumnList columns, int numColumns);
+    void applyPreconditioner(const MultiVector R, const MultiVector Z, const ColumnList columns, int numColumns);
+
+  public:
+    NativeSparseLinearProblem(const Matrix &A, Vector x, const Vector b);
+    NativeSparseLinearProblem(const Matrix &A, Vector x, const Vector b,
+                              Teuchos::ParameterList const& params);
+    // solves for every row of x and b
+    NativeSparseLinearProblem(const Matrix &A, MultiVector x, const MultiVector b,
+                              Teuchos::ParameterList const& params = Teuchos::ParameterList());
+
+    static SolverType         solverType(std::string const& name);
+    static PreconditionerType preconditionerType(std::string const& name);
+
+    void setSolver(SolverType solverType) { _solverType = solverType; }
+    void setPreconditioner(PreconditionerType preconditionerType)
+    {
+      _preconditionerType = preconditionerType;
+      _haveInitialized = false;
+    }
+    void setTolerance(double tol) { _tol = tol; }
+    void setMaxIters(int maxIters) { _maxIters = maxIters; }
+    void setKrylovDimension(int krylovDimension) { _krylovDimension = krylovDimension; }
+    void setChebyshevDegree(int chebyshevDegree) { _chebyshevDegree = chebyshevDegree; }
+    void setOperator(Operator op)
+    {
+      _operator = op;
+      _haveInitialized = false; // Chebyshev estimates eigenvalues of the operator
+    }
+
+    // with several right-hand sides, block CG counts block iterations and
+    // GMRES counts the iterations of all its solves
+    int getIterationsTaken() { return _iterationsTaken; }
+    // relative residual norm at the last iteration (the largest one, with several right-hand sides)
+    double getResidual() { return _residualEstimate; }
+    int getNumRightHandSides() { return _numRHS; }
+
+    // y := A x
+    void applyMatrix(const Vector x, const Vector y);
+    // z := M^-1 r
+    void applyPreconditioner(const Vector r, const Vector z);
+    // the same, for every row of X and Y (R and Z)
+    void applyMatrix(const MultiVector X, const MultiVector Y);
+    void applyPreconditioner(const MultiVector R, const MultiVector Z);
+
+    // builds the preconditioner; solve() calls this if it has not been called
+    void initializeSolver() override;
+
+    // returns 0 when the tolerance was met, 1 otherwise
+    int solve() override;
+  };
+
+  extern template class NativeSparseLinearProblem<int>;
+}
+
+#endif
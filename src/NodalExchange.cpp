@@ -0,0 +1,202 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        lgr v. 1.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Glen A. Hansen (gahanse@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+
+#include "NodalExchange.hpp"
+#include "LGRLambda.hpp"
+
+#include <Omega_h_mesh.hpp>
+
+namespace lgr {
+
+static constexpr int nodalExchangeTag = 4242;
+
+static Kokkos::View<int*, ExecSpace> toDevice(
+    const char *name, const std::vector<int> &from) {
+  Kokkos::View<int*, ExecSpace> to(name, from.size());
+  auto hostTo = Kokkos::create_mirror_view(to);
+  for (size_t i = 0; i < from.size(); ++i) hostTo(i) = from[i];
+  Kokkos::deep_copy(to, hostTo);
+  return to;
+}
+
+// keeps only the ranks that exchange something with this one
+static void compressRanks(
+    const std::vector<int> &counts,
+    std::vector<int>       &ranks,
+    std::vector<int>       &offsets) {
+  ranks.clear();
+  offsets.assign(1, 0);
+  for (size_t rank = 0; rank < counts.size(); ++rank) {
+    if (counts[rank] == 0) continue;
+    ranks.push_back(int(rank));
+    offsets.push_back(offsets.back() + counts[rank]);
+  }
+}
+
+template <int SpatialDim>
+NodalExchange<SpatialDim>::NodalExchange(const FEMesh<SpatialDim> &femesh)
+    : comm_(femesh.omega_h_mesh->comm()->get_impl()) {
+  auto       mesh = femesh.omega_h_mesh;
+  const int  myRank = mesh->comm()->rank();
+  const int  nranks = mesh->comm()->size();
+  const int  nnodes = int(femesh.nnodes);
+  const int  nelems = int(femesh.nelems);
+  auto       owners = mesh->ask_owners(Omega_h::VERT);
+  Omega_h::HostRead<Omega_h::I32> ownerRanks(owners.ranks);
+  Omega_h::HostRead<Omega_h::LO>  ownerIdxs(owners.idxs);
+
+  //the copies on this rank, grouped by owner rank, along with
+  //the index of each one on its owner
+  std::vector<int> recvCounts(nranks, 0);
+  for (int node = 0; node < nnodes; ++node) {
+    if (ownerRanks[node] != myRank) ++recvCounts[ownerRanks[node]];
+  }
+  std::vector<int> recvDispls(nranks, 0);
+  for (int rank = 1; rank < nranks; ++rank) {
+    recvDispls[rank] = recvDispls[rank - 1] + recvCounts[rank - 1];
+  }
+  const int nrecv = nranks ? recvDispls.back() + recvCounts.back() : 0;
+  std::vector<int> recvNodes(nrecv);
+  std::vector<int> ownerIndices(nrecv);
+  {
+    std::vector<int> next(recvDispls);
+    for (int node = 0; node < nnodes; ++node) {
+      const int owner = ownerRanks[node];
+      if (owner == myRank) continue;
+      const int i = next[owner]++;
+      recvNodes[i] = node;
+      ownerIndices[i] = ownerIdxs[node];
+    }
+  }
+
+  //tell each owner which of its nodes this rank copies, in the order
+  //this rank will receive them
+  std::vector<int> sendCounts(nranks, 0);
+  MPI_Alltoall(recvCounts.data(), 1, MPI_INT,
+               sendCounts.data(), 1, MPI_INT, comm_);
+  std::vector<int> sendDispls(nranks, 0);
+  for (int rank = 1; rank < nranks; ++rank) {
+    sendDispls[rank] = sendDispls[rank - 1] + sendCounts[rank - 1];
+  }
+  const int nsend = nranks ? sendDispls.back() + sendCounts.back() : 0;
+  std::vector<int> sendNodes(nsend);
+  MPI_Alltoallv(ownerIndices.data(), recvCounts.data(), recvDispls.data(),
+                MPI_INT, sendNodes.data(), sendCounts.data(),
+                sendDispls.data(), MPI_INT, comm_);
+
+  compressRanks(sendCounts, sendRanks_, sendOffsets_);
+  compressRanks(recvCounts, recvRanks_, recvOffsets_);
+  sendNodes_ = toDevice("nodal exchange send nodes", sendNodes);
+  recvNodes_ = toDevice("nodal exchange recv nodes", recvNodes);
+  sendBuffer_ = buffer_type("nodal exchange send buffer", nsend * SpatialDim);
+  recvBuffer_ = buffer_type("nodal exchange recv buffer", nrecv * SpatialDim);
+  hostSendBuffer_ = Kokkos::create_mirror_view(sendBuffer_);
+  hostRecvBuffer_ = Kokkos::create_mirror_view(recvBuffer_);
+  requests_.resize(sendRanks_.size() + recvRanks_.size());
+
+  //an element is on the boundary if any of its nodes is sent,
+  //so the sent values are final once the boundary elements are done
+  std::vector<char> isSent(nnodes, 0);
+  for (int i = 0; i < nsend; ++i) isSent[sendNodes[i]] = 1;
+  auto elemNodes = Kokkos::create_mirror_view(femesh.elem_node_ids);
+  Kokkos::deep_copy(elemNodes, femesh.elem_node_ids);
+  std::vector<int> boundaryElems;
+  std::vector<int> interiorElems;
+  for (int elem = 0; elem < nelems; ++elem) {
+    bool onBoundary = false;
+    for (int i = 0; i < FEMesh<SpatialDim>::ElemNodeCount; ++i) {
+      if (isSent[elemNodes(elem, i)]) onBoundary = true;
+    }
+    if (onBoundary) boundaryElems.push_back(elem);
+    else interiorElems.push_back(elem);
+  }
+  boundaryElems_ = toDevice("boundary elements", boundaryElems);
+  interiorElems_ = toDevice("interior elements", interiorElems);
+}
+
+template <int SpatialDim>
+void NodalExchange<SpatialDim>::start(geom_array_type a) {
+  const node_list_type sendNodes = sendNodes_;
+  const buffer_type    sendBuffer = sendBuffer_;
+  auto pack = LAMBDA_EXPRESSION(int i) {
+    for (int slot = 0; slot < SpatialDim; ++slot)
+      sendBuffer(i * SpatialDim + slot) = a(sendNodes(i), slot);
+  };  //end lambda pack
+  Kokkos::parallel_for(int(sendNodes.extent(0)), pack);
+  Kokkos::deep_copy(hostSendBuffer_, sendBuffer_);
+
+  int request = 0;
+  for (size_t i = 0; i < recvRanks_.size(); ++i) {
+    const int begin = recvOffsets_[i] * SpatialDim;
+    const int count = recvOffsets_[i + 1] * SpatialDim - begin;
+    MPI_Irecv(hostRecvBuffer_.data() + begin, count, MPI_DOUBLE,
+              recvRanks_[i], nodalExchangeTag, comm_, &requests_[request++]);
+  }
+  for (size_t i = 0; i < sendRanks_.size(); ++i) {
+    const int begin = sendOffsets_[i] * SpatialDim;
+    const int count = sendOffsets_[i + 1] * SpatialDim - begin;
+    MPI_Isend(hostSendBuffer_.data() + begin, count, MPI_DOUBLE,
+              sendRanks_[i], nodalExchangeTag, comm_, &requests_[request++]);
+  }
+}
+
+template <int SpatialDim>
+void NodalExchange<SpatialDim>::finish(geom_array_type a) {
+  MPI_Waitall(int(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+  Kokkos::deep_copy(recvBuffer_, hostRecvBuffer_);
+
+  const node_list_type recvNodes = recvNodes_;
+  const buffer_type    recvBuffer = recvBuffer_;
+  auto unpack = LAMBDA_EXPRESSION(int i) {
+    for (int slot = 0; slot < SpatialDim; ++slot)
+      a(recvNodes(i), slot) = recvBuffer(i * SpatialDim + slot);
+  };  //end lambda unpack
+  Kokkos::parallel_for(int(recvNodes.extent(0)), unpack);
+}
+
+template class NodalExchange<3>;
+template class NodalExchange<2>;
+template class NodalExchange<1>;
+
+} /* namespace lgr */
@@ -0,0 +1,112 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        lgr v. 1.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Glen A. Hansen (gahanse@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+
+#ifndef LGR_NODAL_EXCHANGE_HPP
+#define LGR_NODAL_EXCHANGE_HPP
+
+#include "LGR_Types.hpp"
+#include "FEMesh.hpp"
+#include <mpi.h>
+#include <vector>
+
+namespace lgr {
+
+// Non-blocking owner-to-copy exchange of nodal vector data.
+// It moves the same values as Omega_h's sync_tag, but the sends can be
+// posted as soon as the owned shared nodes are final, so the elements are
+// split into the boundary ones (touching a node some other rank copies)
+// and the interior ones, which can be computed while messages are in flight.
+template <int SpatialDim>
+class NodalExchange {
+ public:
+  typedef typename FEMesh<SpatialDim>::geom_array_type geom_array_type;
+  typedef Kokkos::View<int*, ExecSpace>                elem_list_type;
+
+ private:
+  typedef Kokkos::View<int*, ExecSpace>    node_list_type;
+  typedef Kokkos::View<Scalar*, ExecSpace> buffer_type;
+
+  MPI_Comm comm_;
+
+  // owned nodes copied by other ranks, grouped by destination rank
+  node_list_type   sendNodes_;
+  std::vector<int> sendRanks_;
+  std::vector<int> sendOffsets_;
+
+  // copies of nodes owned by other ranks, grouped by owner rank
+  node_list_type   recvNodes_;
+  std::vector<int> recvRanks_;
+  std::vector<int> recvOffsets_;
+
+  buffer_type                      sendBuffer_;
+  buffer_type                      recvBuffer_;
+  typename buffer_type::HostMirror hostSendBuffer_;
+  typename buffer_type::HostMirror hostRecvBuffer_;
+  std::vector<MPI_Request>         requests_;
+
+  elem_list_type boundaryElems_;
+  elem_list_type interiorElems_;
+
+ public:
+  NodalExchange(const FEMesh<SpatialDim> &femesh);
+
+  NodalExchange(const NodalExchange &) = delete;
+  NodalExchange &operator=(const NodalExchange &) = delete;
+
+  elem_list_type boundaryElems() const { return boundaryElems_; }
+  elem_list_type interiorElems() const { return interiorElems_; }
+
+  // packs the owned shared nodes of a and posts the messages
+  void start(geom_array_type a);
+  // waits for the messages and overwrites the copies in a
+  void finish(geom_array_type a);
+};
+
+extern template class NodalExchange<3>;
+extern template class NodalExchange<2>;
+extern template class NodalExchange<1>;
+
+} /* namespace lgr */
+
+#endif
@@ -21,6 +21,8 @@
 #include "plato/PlatoStaticsTypes.hpp"
 #include "plato/PlatoAbstractProblem.hpp"
 
+#include "NativeSparseLinearProblem.hpp"
+
 #ifdef HAVE_AMGX
 #include "AmgXSparseLinearProblem.hpp"
 #endif
@@ -54,6 +56,8 @@ private:
     Plato::LocalOrdinalVector mBcDofs;
     Plato::ScalarVector mBcValues;
 
+    Teuchos::ParameterList mSolverParams; /* native solver parameters, used without AmgX */
+
 public:
     /******************************************************************************/
     Problem(Omega_h::Mesh& aMesh, Omega_h::MeshSets& aMeshSets, Teuchos::ParameterList& aParamList) :
@@ -64,7 +68,8 @@ public:
             mBoundaryLoads("BoundaryLoads", mEqualityConstraint.size()),
             mStates("States", static_cast<Plato::OrdinalType>(1), mEqualityConstraint.size()),
             mJacobian(Teuchos::null),
-            mIsSelfAdjoint(aParamList.get<bool>("Self-Adjoint", false))
+            mIsSelfAdjoint(aParamList.get<bool>("Self-Adjoint", false)),
+            mSolverParams()
     /******************************************************************************/
     {
         this->initialize(aMesh, aMeshSets, aParamList);
@@ -131,13 +136,7 @@ public:
         mJacobian = mEqualityConstraint.gradient_u(tStatesSubView, aControl);
         this->applyConstraints(mJacobian, mResidual);
 
-#ifdef HAVE_AMGX
-        using AmgXLinearProblem = lgr::AmgXSparseLinearProblem< Plato::OrdinalType, SimplexPhysics::m_numDofsPerNode>;
-        auto tConfigString = AmgXLinearProblem::getConfigString();
-        auto tSolver = Teuchos::rcp(new AmgXLinearProblem(*mJacobian, tStatesSubView, mResidual, tConfigString));
-        tSolver->solve();
-        tSolver = Teuchos::null;
-#endif
+        this->solveLinearSystem(mJacobian, tStatesSubView, mResidual);
 
         mResidual = mEqualityConstraint.value(tStatesSubView, aControl);
         return mStates;
@@ -266,20 +265,10 @@ public:
             // adjoint problem uses transpose of global stiffness, but we're assuming the constrained
             // system is symmetric.
 
-#ifdef HAVE_AMGX
-            typedef lgr::AmgXSparseLinearProblem< Plato::OrdinalType, SimplexPhysics::m_numDofsPerNode> AmgXLinearProblem;
-            auto tConfigString = AmgXLinearProblem::getConfigString();
-            auto tSolver = Teuchos::rcp(new AmgXLinearProblem(*mJacobian, mAdjoint, tPartialObjectiveWRT_State, tConfigString));
-            tSolver->solve();
-            tSolver = Teuchos::null;
-#endif
-
-            // compute dgdz: partial of PDE wrt state.
-            // dgdz is returned transposed, nxm.  n=z.size() and m=u.size().
-            auto tPartialPDE_WRT_Control = mEqualityConstraint.gradient_z(tStatesSubView, aControl);
+            this->solveLinearSystem(mJacobian, mAdjoint, tPartialObjectiveWRT_State);
 
-            // compute dgdz . adjoint + dfdz
-            Plato::MatrixTimesVectorPlusVector(tPartialPDE_WRT_Control, mAdjoint, tPartialObjectiveWRT_Control);
+            // compute dgdz . adjoint + dfdz without assembling dgdz
+            mEqualityConstraint.adjoint_gradient_z(tStatesSubView, aControl, mAdjoint, tPartialObjectiveWRT_Control);
         }
         return tPartialObjectiveWRT_Control;
     }
@@ -324,20 +313,10 @@ public:
             // adjoint problem uses transpose of global stiffness, but we're assuming the constrained
             // system is symmetric.
 
-#ifdef HAVE_AMGX
-            typedef lgr::AmgXSparseLinearProblem< Plato::OrdinalType, SimplexPhysics::m_numDofsPerNode> AmgXLinearProblem;
-            auto tConfigString = AmgXLinearProblem::getConfigString();
-            auto tSolver = Teuchos::rcp(new AmgXLinearProblem(*mJacobian, mAdjoint, tPartialObjectiveWRT_State, tConfigString));
-            tSolver->solve();
-            tSolver = Teuchos::null;
-#endif
-
-            // compute dgdx: partial of PDE wrt config.
-            // dgdx is returned transposed, nxm.  n=x.size() and m=u.size().
-            auto tPartialPDE_WRT_Config = mEqualityConstraint.gradient_x(tStatesSubView, aControl);
+            this->solveLinearSystem(mJacobian, mAdjoint, tPartialObjectiveWRT_State);
 
-            // compute dgdx . adjoint + dfdx
-            Plato::MatrixTimesVectorPlusVector(tPartialPDE_WRT_Config, mAdjoint, tPartialObjectiveWRT_Config);
+            // compute dgdx . adjoint + dfdx without assembling dgdx
+            mEqualityConstraint.adjoint_gradient_x(tStatesSubView, aControl, mAdjoint, tPartialObjectiveWRT_Config);
         }
         return tPartialObjectiveWRT_Config;
     }
@@ -464,6 +443,24 @@ public:
     }
 
 private:
+    /******************************************************************************/
+    void solveLinearSystem(const Teuchos::RCP<Plato::CrsMatrixType> & aMatrix,
+                           const Plato::ScalarVector & aSolution,
+                           const Plato::ScalarVector & aRhs)
+    /******************************************************************************/
+    {
+#ifdef HAVE_AMGX
+        using AmgXLinearProblem = lgr::AmgXSparseLinearProblem< Plato::OrdinalType, SimplexPhysics::m_numDofsPerNode>;
+        auto tConfigString = AmgXLinearProblem::getConfigString();
+        auto tSolver = Teuchos::rcp(new AmgXLinearProblem(*aMatrix, aSolution, aRhs, tConfigString));
+        tSolver->solve();
+        tSolver = Teuchos::null;
+#else
+        lgr::NativeSparseLinearProblem<Plato::OrdinalType> tSolver(*aMatrix, aSolution, aRhs, mSolverParams);
+        tSolver.solve();
+#endif
+    }
+
     /******************************************************************************/
     void initialize(Omega_h::Mesh& aMesh, Omega_h::MeshSets& aMeshSets, Teuchos::ParameterList& aParamList)
     /******************************************************************************/
@@ -495,6 +492,13 @@ private:
         Plato::NaturalBCs<SimplexPhysics::SpaceDim, SimplexPhysics::m_numDofsPerNode>
             tNaturalBoundaryConditions(aParamList.sublist("Natural Boundary Conditions", false));
         tNaturalBoundaryConditions.get(&aMesh, aMeshSets, mBoundaryLoads);
+
+        // the constrained system is symmetric, so the native solver's CG default applies
+        if(aParamList.isSublist("Linear Solver"))
+        {
+            mSolverParams.setParameters(aParamList.sublist("Linear Solver"));
+            mSolverParams.remove("Package", false);
+        }
     }
 };
 
@@ -0,0 +1,195 @@
+/*
+ * CellColoring.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef CELLCOLORING_HPP_
+#define CELLCOLORING_HPP_
+
+#include <vector>
+#include <string>
+
+#include <Omega_h_mesh.hpp>
+
+#include "plato/PlatoStaticsTypes.hpp"
+
+namespace Plato
+{
+
+/******************************************************************************//**
+ *
+ * @brief Partition of the mesh cells into colors such that no two cells of one
+ *        color share a node.
+ *
+ * Cells of one color can scatter into nodal (or node-block) storage with plain
+ * stores, so assembly loops run one color at a time instead of using an atomic
+ * update per entry.  The coloring is greedy in cell order and is computed once
+ * per mesh on the host.  An empty (default constructed) coloring means "all cells
+ * at once, atomic updates".
+ *
+**********************************************************************************/
+class CellColoring
+{
+private:
+    std::vector<Plato::OrdinalType> mColorOffsets; /* cells of color c are mCells(mColorOffsets[c] ... mColorOffsets[c+1]-1) */
+    Plato::LocalOrdinalVector mCells;              /* cell ordinals grouped by color */
+
+public:
+    /******************************************************************************//**
+     * @brief Empty coloring: assemble with atomic updates
+    **********************************************************************************/
+    CellColoring() :
+            mColorOffsets(),
+            mCells()
+    {
+    }
+
+    /******************************************************************************//**
+     * @brief Color the cells of a mesh
+     * @param [in] aMesh mesh data base
+    **********************************************************************************/
+    explicit CellColoring(Omega_h::Mesh & aMesh) :
+            mColorOffsets(),
+            mCells()
+    {
+        const Plato::OrdinalType tNumCells = aMesh.nelems();
+        const Plato::OrdinalType tNumNodesPerCell = aMesh.dim() + 1;
+        Omega_h::HostRead<Omega_h::LO> tCells2Nodes(aMesh.ask_elem_verts());
+        auto tNodes2Cells = aMesh.ask_up(Omega_h::VERT, aMesh.dim());
+        Omega_h::HostRead<Omega_h::LO> tNodes2CellsOffsets(tNodes2Cells.a2ab);
+        Omega_h::HostRead<Omega_h::LO> tNodes2CellsOrdinals(tNodes2Cells.ab2b);
+
+        // greedy: each cell takes the lowest color not used by a cell sharing one of its nodes
+        std::vector<Plato::OrdinalType> tCellColors(tNumCells, -1);
+        std::vector<Plato::OrdinalType> tForbiddenBy; /* tForbiddenBy[c] == cell: color c is taken near cell */
+        std::vector<Plato::OrdinalType> tColorCounts;
+        for(Plato::OrdinalType tCell = 0; tCell < tNumCells; tCell++)
+        {
+            for(Plato::OrdinalType tNode = 0; tNode < tNumNodesPerCell; tNode++)
+            {
+                auto tNodeOrdinal = tCells2Nodes[tCell * tNumNodesPerCell + tNode];
+                for(auto tIndex = tNodes2CellsOffsets[tNodeOrdinal]; tIndex < tNodes2CellsOffsets[tNodeOrdinal + 1]; tIndex++)
+                {
+                    auto tNeighborColor = tCellColors[tNodes2CellsOrdinals[tIndex]];
+                    if(tNeighborColor >= 0)
+                    {
+                        tForbiddenBy[tNeighborColor] = tCell;
+                    }
+                }
+            }
+            Plato::OrdinalType tColor = 0;
+            while(tColor < static_cast<Plato::OrdinalType>(tForbiddenBy.size()) && tForbiddenBy[tColor] == tCell)
+            {
+                tColor++;
+            }
+            if(tColor == static_cast<Plato::OrdinalType>(tForbiddenBy.size()))
+            {
+                tForbiddenBy.push_back(-1);
+                tColorCounts.push_back(0);
+            }
+            tCellColors[tCell] = tColor;
+            tColorCounts[tColor]++;
+        }
+
+        const Plato::OrdinalType tNumColors = tColorCounts.size();
+        mColorOffsets.assign(tNumColors + 1, 0);
+        for(Plato::OrdinalType tColor = 0; tColor < tNumColors; tColor++)
+        {
+            mColorOffsets[tColor + 1] = mColorOffsets[tColor] + tColorCounts[tColor];
+        }
+
+        mCells = Plato::LocalOrdinalVector("colored cells", tNumCells);
+        auto tHostCells = Kokkos::create_mirror_view(mCells);
+        std::vector<Plato::OrdinalType> tNextSlot(mColorOffsets.begin(), mColorOffsets.end() - 1);
+        for(Plato::OrdinalType tCell = 0; tCell < tNumCells; tCell++)
+        {
+            tHostCells(tNextSlot[tCellColors[tCell]]++) = tCell;
+        }
+        Kokkos::deep_copy(mCells, tHostCells);
+    }
+
+    /******************************************************************************//**
+     * @brief True if this is the empty coloring
+    **********************************************************************************/
+    bool empty() const
+    {
+        return mColorOffsets.empty();
+    }
+
+    /******************************************************************************//**
+     * @brief Number of colors; zero for the empty coloring
+    **********************************************************************************/
+    Plato::OrdinalType numColors() const
+    {
+        return mColorOffsets.empty() ? 0 : mColorOffsets.size() - 1;
+    }
+
+    /******************************************************************************//**
+     * @brief Cell ordinals grouped by color
+    **********************************************************************************/
+    Plato::LocalOrdinalVector cells() const
+    {
+        return mCells;
+    }
+
+    /******************************************************************************//**
+     * @brief First position in cells() of each color, plus the total number of cells
+    **********************************************************************************/
+    const std::vector<Plato::OrdinalType> & colorOffsets() const
+    {
+        return mColorOffsets;
+    }
+
+    /******************************************************************************//**
+     *
+     * @brief Apply aFunctor(cell) to every cell: all at once for the empty coloring,
+     *        otherwise one kernel per color
+     *
+     * @param [in] aNumCells number of cells
+     * @param [in] aFunctor cell operation
+     * @param [in] aName kernel name
+     *
+    **********************************************************************************/
+    template<class Functor>
+    void for_each_cell(const Plato::OrdinalType & aNumCells, const Functor & aFunctor, const std::string & aName) const
+    {
+        if(this->empty())
+        {
+            Kokkos::parallel_for(Kokkos::RangePolicy<>(0, aNumCells), aFunctor, aName);
+            return;
+        }
+
+        auto tCells = mCells;
+        const Plato::OrdinalType tNumColors = this->numColors();
+        for(Plato::OrdinalType tColor = 0; tColor < tNumColors; tColor++)
+        {
+            Kokkos::parallel_for(Kokkos::RangePolicy<>(mColorOffsets[tColor], mColorOffsets[tColor + 1]), LAMBDA_EXPRESSION(const Plato::OrdinalType & aIndex)
+            {
+                aFunctor(tCells(aIndex));
+            }, aName);
+        }
+    }
+};
+// class CellColoring
+
+/******************************************************************************//**
+ * @brief aDestination += aValue, atomically unless no other thread can write
+ *        aDestination at the same time (e.g. while assembling one cell color)
+**********************************************************************************/
+template<class ScalarT>
+KOKKOS_INLINE_FUNCTION void assemble_add(const bool & aAtomic, ScalarT & aDestination, const ScalarT & aValue)
+{
+    if(aAtomic)
+    {
+        Kokkos::atomic_add(&aDestination, aValue);
+    }
+    else
+    {
+        aDestination += aValue;
+    }
+}
+
+} // namespace Plato
+
+#endif /* CELLCOLORING_HPP_ */
@@ -0,0 +1,520 @@
+/*
+ * ReducedFrequencySweep.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef REDUCEDFREQUENCYSWEEP_HPP_
+#define REDUCEDFREQUENCYSWEEP_HPP_
+
+#include <cmath>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+
+#include <Teuchos_ParameterList.hpp>
+
+#include "plato/PlatoMathHelpers.hpp"
+#include "plato/PlatoStaticsTypes.hpp"
+
+namespace Plato
+{
+
+/******************************************************************************//**
+ *
+ * @brief Galerkin reduced-order solve of a frequency sweep.
+ *
+ * The constrained system of the sweep, \f$\mathbf{A}(\omega)\mathbf{u} = \mathbf{b}(\omega)\f$,
+ * must be affine in the squared angular frequency, as the structural dynamics
+ * equations \f$(\mathbf{K} + \mathbf{C} - \omega^2\mathbf{M})\mathbf{u} = \mathbf{f}\f$ are.
+ * It is therefore given by its values at two distinct frequencies.  A projection
+ * basis is built from full-order solutions at a few sample frequencies (a
+ * multi-point Krylov basis) and every frequency is solved in the reduced space.
+ * The relative full-order residual of each reduced solution is the error indicator:
+ * while it exceeds the tolerance, a full-order solve at the worst frequency
+ * enriches the basis.
+ *
+ * States are complex amplitudes in real-equivalent form: the first half of the
+ * degrees of freedom of each node are real parts, the second half imaginary parts.
+ * Each snapshot also contributes its product with the imaginary unit, so the basis
+ * spans a complex subspace.
+ *
+ * Parameters, all optional:
+ *   "Initial Samples":    full-order solves that build the first basis (3)
+ *   "Error Tolerance":    relative residual accepted without enrichment (1e-6)
+ *   "Maximum Basis Size": enrichment stops at this size (40)
+ *
+**********************************************************************************/
+template<Plato::OrdinalType NumDofsPerNode>
+class ReducedFrequencySweep
+{
+public:
+    /* solves aMatrix * aSolution = aRHS, aSolution holds the initial guess; returns the iterations taken */
+    typedef std::function<Plato::OrdinalType(const Teuchos::RCP<Plato::CrsMatrixType> &,
+                                             const Plato::ScalarVector &,
+                                             const Plato::ScalarVector &)> FullOrderSolver;
+
+private:
+    static constexpr Plato::OrdinalType mNumComplexDofsPerNode = NumDofsPerNode / 2;
+
+    Plato::OrdinalType mNumSamples;
+    Plato::OrdinalType mMaxBasisSize;
+    Plato::Scalar mTolerance;
+
+    Plato::Scalar mOmegaSquaredA;
+    Plato::Scalar mOmegaSquaredB;
+    Teuchos::RCP<Plato::CrsMatrixType> mMatrixA;
+    Teuchos::RCP<Plato::CrsMatrixType> mMatrixB;
+    Plato::ScalarVector mRhsA;
+    Plato::ScalarVector mRhsB;
+
+    Plato::OrdinalType mBasisSize;
+    Plato::ScalarMultiVector mBasis;         /* orthonormal basis vectors, one per row */
+    Plato::ScalarMultiVector mBasisTimesA;   /* A_a times each basis vector */
+    Plato::ScalarMultiVector mBasisTimesB;   /* A_b times each basis vector */
+    std::vector<Plato::Scalar> mReducedMatrixA; /* V^T A_a V, row-major, mMaxBasisSize columns */
+    std::vector<Plato::Scalar> mReducedMatrixB;
+    std::vector<Plato::Scalar> mReducedRhsA;  /* V^T b_a */
+    std::vector<Plato::Scalar> mReducedRhsB;
+
+    Plato::OrdinalType mNumFullSolves;
+    std::vector<Plato::Scalar> mErrorIndicators;
+    std::vector<Plato::OrdinalType> mIterations;
+
+public:
+    /******************************************************************************//**
+     *
+     * @brief Constructor
+     * @param [in] aParams reduced order parameters
+     *
+    **********************************************************************************/
+    explicit ReducedFrequencySweep(Teuchos::ParameterList aParams = Teuchos::ParameterList()) :
+            mNumSamples(aParams.get<int>("Initial Samples", 3)),
+            mMaxBasisSize(aParams.get<int>("Maximum Basis Size", 40)),
+            mTolerance(aParams.get<double>("Error Tolerance", 1e-6)),
+            mOmegaSquaredA(0),
+            mOmegaSquaredB(0),
+            mMatrixA(Teuchos::null),
+            mMatrixB(Teuchos::null),
+            mBasisSize(0),
+            mNumFullSolves(0)
+    {
+        mNumSamples = std::max(mNumSamples, static_cast<Plato::OrdinalType>(1));
+        mMaxBasisSize = std::max(mMaxBasisSize, static_cast<Plato::OrdinalType>(2) * mNumSamples);
+    }
+
+    /******************************************************************************//**
+     *
+     * @brief Set the constrained system at two distinct angular frequencies
+     *
+     * @param [in] aMatrixA system matrix at aOmegaA
+     * @param [in] aRhsA right hand side at aOmegaA
+     * @param [in] aOmegaA angular frequency
+     * @param [in] aMatrixB system matrix at aOmegaB, on the same graph as aMatrixA
+     * @param [in] aRhsB right hand side at aOmegaB
+     * @param [in] aOmegaB angular frequency
+     *
+    **********************************************************************************/
+    void setOperator(const Teuchos::RCP<Plato::CrsMatrixType> & aMatrixA,
+                     const Plato::ScalarVector & aRhsA,
+                     const Plato::Scalar & aOmegaA,
+                     const Teuchos::RCP<Plato::CrsMatrixType> & aMatrixB,
+                     const Plato::ScalarVector & aRhsB,
+                     const Plato::Scalar & aOmegaB)
+    {
+        if(aOmegaA * aOmegaA == aOmegaB * aOmegaB)
+        {
+            std::ostringstream tErrorMessage;
+            tErrorMessage << "\n\n************** ERROR IN FILE: " << __FILE__ << ", FUNCTION: " << __PRETTY_FUNCTION__
+                    << ", LINE: " << __LINE__
+                    << "\nMESSAGE: THE REDUCED ORDER OPERATOR NEEDS TWO DISTINCT SQUARED FREQUENCIES. **************\n\n";
+            throw std::runtime_error(tErrorMessage.str().c_str());
+        }
+        mMatrixA = aMatrixA;
+        mMatrixB = aMatrixB;
+        mRhsA = aRhsA;
+        mRhsB = aRhsB;
+        mOmegaSquaredA = aOmegaA * aOmegaA;
+        mOmegaSquaredB = aOmegaB * aOmegaB;
+    }
+
+    /******************************************************************************//**
+     *
+     * @brief Full-order system matrix at an angular frequency
+     *
+    **********************************************************************************/
+    Teuchos::RCP<Plato::CrsMatrixType> matrix(const Plato::Scalar & aOmega) const
+    {
+        auto tWeight = this->weight(aOmega);
+        auto tEntriesA = mMatrixA->entries();
+        auto tEntriesB = mMatrixB->entries();
+        Plato::ScalarVector tEntries("matrix entries", tEntriesA.size());
+        Kokkos::parallel_for(Kokkos::RangePolicy<>(0, tEntries.size()), LAMBDA_EXPRESSION(const Plato::OrdinalType & aOrdinal)
+        {
+            tEntries(aOrdinal) = (1.0 - tWeight) * tEntriesA(aOrdinal) + tWeight * tEntriesB(aOrdinal);
+        }, "interpolate matrix entries");
+        return Teuchos::rcp(new Plato::CrsMatrixType(mMatrixA->rowMap(), mMatrixA->columnIndices(), tEntries,
+                                                     mMatrixA->blockSizeCol(), mMatrixA->blockSizeRow()));
+    }
+
+    /******************************************************************************//**
+     *
+     * @brief Full-order right hand side at an angular frequency
+     *
+    **********************************************************************************/
+    void rhs(const Plato::Scalar & aOmega, const Plato::ScalarVector & aOutput) const
+    {
+        Kokkos::deep_copy(aOutput, mRhsA);
+        Plato::update(this->weight(aOmega), mRhsB, static_cast<Plato::Scalar>(1.0) - this->weight(aOmega), aOutput);
+    }
+
+    /******************************************************************************//**
+     *
+     * @brief Solve every frequency of the sweep in the reduced space
+     *
+     * @param [in] aFrequencies angular frequencies
+     * @param [out] aSolutions solutions, one row per frequency
+     * @param [in] aFullOrderSolver solver used for the basis snapshots
+     *
+    **********************************************************************************/
+    void solve(const std::vector<Plato::Scalar> & aFrequencies,
+               const Plato::ScalarMultiVector & aSolutions,
+               const FullOrderSolver & aFullOrderSolver)
+    {
+        assert(mMatrixA.is_null() == false);
+        const Plato::OrdinalType tNumFreqs = aFrequencies.size();
+        const Plato::OrdinalType tNumDofs = aSolutions.extent(1);
+        this->allocate(tNumDofs);
+
+        mBasisSize = 0;
+        mNumFullSolves = 0;
+        mIterations.assign(tNumFreqs, 0);
+        mErrorIndicators.assign(tNumFreqs, 0.0);
+        std::vector<bool> tIsSnapshot(tNumFreqs, false);
+
+        // evenly spaced samples across the sweep build the first basis
+        const Plato::OrdinalType tNumSamples = std::min(mNumSamples, tNumFreqs);
+        for(Plato::OrdinalType tSample = 0; tSample < tNumSamples; tSample++)
+        {
+            Plato::OrdinalType tFreqIndex = tNumSamples > 1 ?
+                    (tSample * (tNumFreqs - 1) + (tNumSamples - 1) / 2) / (tNumSamples - 1) : tNumFreqs / 2;
+            auto tSolution = Kokkos::subview(aSolutions, tFreqIndex, Kokkos::ALL());
+            Plato::fill(static_cast<Plato::Scalar>(0.0), tSolution);
+            this->fullOrderSolve(aFrequencies, tFreqIndex, tSolution, aFullOrderSolver);
+            tIsSnapshot[tFreqIndex] = true;
+        }
+
+        Plato::ScalarVector tReducedSolution("reduced solution", mMaxBasisSize);
+        while(true)
+        {
+            Plato::OrdinalType tWorstIndex = -1;
+            Plato::Scalar tWorstIndicator = mTolerance;
+            for(Plato::OrdinalType tFreqIndex = 0; tFreqIndex < tNumFreqs; tFreqIndex++)
+            {
+                if(tIsSnapshot[tFreqIndex])
+                {
+                    continue;
+                }
+                auto tSolution = Kokkos::subview(aSolutions, tFreqIndex, Kokkos::ALL());
+                this->reducedSolve(aFrequencies[tFreqIndex], tReducedSolution);
+                mErrorIndicators[tFreqIndex] = this->prolongate(aFrequencies[tFreqIndex], tReducedSolution, tSolution);
+                if(mErrorIndicators[tFreqIndex] > tWorstIndicator)
+                {
+                    tWorstIndicator = mErrorIndicators[tFreqIndex];
+                    tWorstIndex = tFreqIndex;
+                }
+            }
+
+            if(tWorstIndex < 0 || mBasisSize + 2 > mMaxBasisSize)
+            {
+                break;
+            }
+
+            // enrich at the worst frequency, starting from its reduced solution
+            auto tSolution = Kokkos::subview(aSolutions, tWorstIndex, Kokkos::ALL());
+            this->fullOrderSolve(aFrequencies, tWorstIndex, tSolution, aFullOrderSolver);
+            mErrorIndicators[tWorstIndex] = 0.0;
+            tIsSnapshot[tWorstIndex] = true;
+        }
+    }
+
+    /******************************************************************************//**
+     * @brief Number of basis vectors after the last sweep
+    **********************************************************************************/
+    Plato::OrdinalType getBasisSize() const
+    {
+        return mBasisSize;
+    }
+
+    /******************************************************************************//**
+     * @brief Number of full-order solves taken by the last sweep
+    **********************************************************************************/
+    Plato::OrdinalType getNumFullOrderSolves() const
+    {
+        return mNumFullSolves;
+    }
+
+    /******************************************************************************//**
+     * @brief Relative residual of each reduced solution of the last sweep (zero at snapshots)
+    **********************************************************************************/
+    const std::vector<Plato::Scalar> & getErrorIndicators() const
+    {
+        return mErrorIndicators;
+    }
+
+    /******************************************************************************//**
+     * @brief Full-order solver iterations per frequency of the last sweep (zero if reduced)
+    **********************************************************************************/
+    const std::vector<Plato::OrdinalType> & getIterations() const
+    {
+        return mIterations;
+    }
+
+private:
+    /******************************************************************************/
+    Plato::Scalar weight(const Plato::Scalar & aOmega) const
+    /******************************************************************************/
+    {
+        return (aOmega * aOmega - mOmegaSquaredA) / (mOmegaSquaredB - mOmegaSquaredA);
+    }
+
+    /******************************************************************************/
+    void allocate(const Plato::OrdinalType & aNumDofs)
+    /******************************************************************************/
+    {
+        if(static_cast<Plato::OrdinalType>(mBasis.extent(0)) != mMaxBasisSize
+                || static_cast<Plato::OrdinalType>(mBasis.extent(1)) != aNumDofs)
+        {
+            mBasis = Plato::ScalarMultiVector("reduced basis", mMaxBasisSize, aNumDofs);
+            mBasisTimesA = Plato::ScalarMultiVector("reduced basis times A_a", mMaxBasisSize, aNumDofs);
+            mBasisTimesB = Plato::ScalarMultiVector("reduced basis times A_b", mMaxBasisSize, aNumDofs);
+        }
+        mReducedMatrixA.assign(mMaxBasisSize * mMaxBasisSize, 0.0);
+        mReducedMatrixB.assign(mMaxBasisSize * mMaxBasisSize, 0.0);
+        mReducedRhsA.assign(mMaxBasisSize, 0.0);
+        mReducedRhsB.assign(mMaxBasisSize, 0.0);
+    }
+
+    /******************************************************************************/
+    static Plato::Scalar dot(const Plato::ScalarVector & aVectorA, const Plato::ScalarVector & aVectorB)
+    /******************************************************************************/
+    {
+        Plato::Scalar tOutput = 0.0;
+        Kokkos::parallel_reduce(Kokkos::RangePolicy<>(0, aVectorA.size()), LAMBDA_EXPRESSION(const Plato::OrdinalType & aOrdinal, Plato::Scalar & aSum)
+        {
+            aSum += aVectorA(aOrdinal) * aVectorB(aOrdinal);
+        }, tOutput);
+        return tOutput;
+    }
+
+    /******************************************************************************/
+    void fullOrderSolve(const std::vector<Plato::Scalar> & aFrequencies,
+                        const Plato::OrdinalType & aFreqIndex,
+                        const Plato::ScalarVector & aSolution,
+                        const FullOrderSolver & aFullOrderSolver)
+    /******************************************************************************/
+    {
+        auto tOmega = aFrequencies[aFreqIndex];
+        Plato::ScalarVector tRhs("full order rhs", aSolution.size());
+        this->rhs(tOmega, tRhs);
+        mIterations[aFreqIndex] = aFullOrderSolver(this->matrix(tOmega), aSolution, tRhs);
+        mNumFullSolves++;
+
+        this->addSnapshot(aSolution, false);
+        this->addSnapshot(aSolution, true);
+    }
+
+    /******************************************************************************//**
+     * @brief Orthonormalize a snapshot (or its product with the imaginary unit)
+     *        against the basis and, unless it is numerically dependent, append it
+    **********************************************************************************/
+    void addSnapshot(const Plato::ScalarVector & aSnapshot, bool aRotate)
+    /******************************************************************************/
+    {
+        if(mBasisSize >= mMaxBasisSize)
+        {
+            return;
+        }
+
+        auto tVector = Kokkos::subview(mBasis, mBasisSize, Kokkos::ALL());
+        const Plato::OrdinalType tNumNodes = aSnapshot.size() / NumDofsPerNode;
+        Kokkos::parallel_for(Kokkos::RangePolicy<>(0, tNumNodes), LAMBDA_EXPRESSION(const Plato::OrdinalType & aNodeOrdinal)
+        {
+            for(Plato::OrdinalType tDim = 0; tDim < mNumComplexDofsPerNode; tDim++)
+            {
+                auto tRealDof = aNodeOrdinal * NumDofsPerNode + tDim;
+                auto tImagDof = tRealDof + mNumComplexDofsPerNode;
+                // i * (a + ib) = -b + ia
+                tVector(tRealDof) = aRotate ? -aSnapshot(tImagDof) : aSnapshot(tRealDof);
+                tVector(tImagDof) = aRotate ? aSnapshot(tRealDof) : aSnapshot(tImagDof);
+            }
+        }, "copy snapshot");
+
+        // modified Gram-Schmidt, twice for stability
+        const Plato::Scalar tInitialNorm = std::sqrt(dot(tVector, tVector));
+        if(tInitialNorm == static_cast<Plato::Scalar>(0.0))
+        {
+            return;
+        }
+        for(Plato::OrdinalType tPass = 0; tPass < 2; tPass++)
+        {
+            for(Plato::OrdinalType tIndex = 0; tIndex < mBasisSize; tIndex++)
+            {
+                auto tBasisVector = Kokkos::subview(mBasis, tIndex, Kokkos::ALL());
+                Plato::Scalar tProjection = dot(tBasisVector, tVector);
+                Plato::axpy(-tProjection, tBasisVector, tVector);
+            }
+        }
+        const Plato::Scalar tNorm = std::sqrt(dot(tVector, tVector));
+        if(tNorm <= static_cast<Plato::Scalar>(1e-10) * tInitialNorm)
+        {
+            return;
+        }
+        Plato::scale(static_cast<Plato::Scalar>(1.0) / tNorm, tVector);
+
+        this->project(mBasisSize);
+        mBasisSize++;
+    }
+
+    /******************************************************************************//**
+     * @brief Add the row and column of a new basis vector to the reduced systems
+    **********************************************************************************/
+    void project(const Plato::OrdinalType & aNewIndex)
+    /******************************************************************************/
+    {
+        auto tVector = Kokkos::subview(mBasis, aNewIndex, Kokkos::ALL());
+        auto tVectorTimesA = Kokkos::subview(mBasisTimesA, aNewIndex, Kokkos::ALL());
+        auto tVectorTimesB = Kokkos::subview(mBasisTimesB, aNewIndex, Kokkos::ALL());
+        mMatrixA->Apply(tVector, tVectorTimesA);
+        mMatrixB->Apply(tVector, tVectorTimesB);
+
+        for(Plato::OrdinalType tIndex = 0; tIndex <= aNewIndex; tIndex++)
+        {
+            auto tBasisVector = Kokkos::subview(mBasis, tIndex, Kokkos::ALL());
+            auto tBasisTimesA = Kokkos::subview(mBasisTimesA, tIndex, Kokkos::ALL());
+            auto tBasisTimesB = Kokkos::subview(mBasisTimesB, tIndex, Kokkos::ALL());
+            mReducedMatrixA[tIndex * mMaxBasisSize + aNewIndex] = dot(tBasisVector, tVectorTimesA);
+            mReducedMatrixB[tIndex * mMaxBasisSize + aNewIndex] = dot(tBasisVector, tVectorTimesB);
+            mReducedMatrixA[aNewIndex * mMaxBasisSize + tIndex] = dot(tVector, tBasisTimesA);
+            mReducedMatrixB[aNewIndex * mMaxBasisSize + tIndex] = dot(tVector, tBasisTimesB);
+        }
+        mReducedRhsA[aNewIndex] = dot(tVector, mRhsA);
+        mReducedRhsB[aNewIndex] = dot(tVector, mRhsB);
+    }
+
+    /******************************************************************************//**
+     * @brief Solve the dense reduced system at an angular frequency by Gaussian
+     *        elimination with partial pivoting
+    **********************************************************************************/
+    void reducedSolve(const Plato::Scalar & aOmega, const Plato::ScalarVector & aReducedSolution) const
+    /******************************************************************************/
+    {
+        const Plato::OrdinalType tSize = mBasisSize;
+        const Plato::Scalar tWeight = this->weight(aOmega);
+        std::vector<Plato::Scalar> tMatrix(tSize * tSize);
+        std::vector<Plato::Scalar> tRhs(tSize);
+        for(Plato::OrdinalType tRow = 0; tRow < tSize; tRow++)
+        {
+            for(Plato::OrdinalType tCol = 0; tCol < tSize; tCol++)
+            {
+                auto tEntry = tRow * mMaxBasisSize + tCol;
+                tMatrix[tRow * tSize + tCol] = (1.0 - tWeight) * mReducedMatrixA[tEntry] + tWeight * mReducedMatrixB[tEntry];
+            }
+            tRhs[tRow] = (1.0 - tWeight) * mReducedRhsA[tRow] + tWeight * mReducedRhsB[tRow];
+        }
+
+        for(Plato::OrdinalType tCol = 0; tCol < tSize; tCol++)
+        {
+            Plato::OrdinalType tPivot = tCol;
+            for(Plato::OrdinalType tRow = tCol + 1; tRow < tSize; tRow++)
+            {
+                if(std::abs(tMatrix[tRow * tSize + tCol]) > std::abs(tMatrix[tPivot * tSize + tCol]))
+                {
+                    tPivot = tRow;
+                }
+            }
+            if(tMatrix[tPivot * tSize + tCol] == static_cast<Plato::Scalar>(0.0))
+            {
+                std::ostringstream tErrorMessage;
+                tErrorMessage << "\n\n************** ERROR IN FILE: " << __FILE__ << ", FUNCTION: " << __PRETTY_FUNCTION__
+                        << ", LINE: " << __LINE__ << "\nMESSAGE: SINGULAR REDUCED ORDER SYSTEM AT ANGULAR FREQUENCY "
+                        << aOmega << ". **************\n\n";
+                throw std::runtime_error(tErrorMessage.str().c_str());
+            }
+            for(Plato::OrdinalType tIndex = 0; tIndex < tSize; tIndex++)
+            {
+                std::swap(tMatrix[tCol * tSize + tIndex], tMatrix[tPivot * tSize + tIndex]);
+            }
+            std::swap(tRhs[tCol], tRhs[tPivot]);
+            for(Plato::OrdinalType tRow = tCol + 1; tRow < tSize; tRow++)
+            {
+                Plato::Scalar tFactor = tMatrix[tRow * tSize + tCol] / tMatrix[tCol * tSize + tCol];
+                for(Plato::OrdinalType tIndex = tCol; tIndex < tSize; tIndex++)
+                {
+                    tMatrix[tRow * tSize + tIndex] -= tFactor * tMatrix[tCol * tSize + tIndex];
+                }
+                tRhs[tRow] -= tFactor * tRhs[tCol];
+            }
+        }
+
+        auto tHostSolution = Kokkos::create_mirror_view(aReducedSolution);
+        for(Plato::OrdinalType tRow = tSize - 1; tRow >= 0; tRow--)
+        {
+            Plato::Scalar tSum = tRhs[tRow];
+            for(Plato::OrdinalType tCol = tRow + 1; tCol < tSize; tCol++)
+            {
+                tSum -= tMatrix[tRow * tSize + tCol] * tHostSolution(tCol);
+            }
+            tHostSolution(tRow) = tSum / tMatrix[tRow * tSize + tRow];
+        }
+        Kokkos::deep_copy(aReducedSolution, tHostSolution);
+    }
+
+    /******************************************************************************//**
+     * @brief Expand a reduced solution to the full space and return its relative
+     *        full-order residual; A(w) V y is formed from the stored products A_a V, A_b V
+    **********************************************************************************/
+    Plato::Scalar prolongate(const Plato::Scalar & aOmega,
+                             const Plato::ScalarVector & aReducedSolution,
+                             const Plato::ScalarVector & aSolution) const
+    /******************************************************************************/
+    {
+        const Plato::OrdinalType tSize = mBasisSize;
+        const Plato::Scalar tWeight = this->weight(aOmega);
+        auto tBasis = mBasis;
+        auto tBasisTimesA = mBasisTimesA;
+        auto tBasisTimesB = mBasisTimesB;
+        auto tRhsA = mRhsA;
+        auto tRhsB = mRhsB;
+
+        Plato::Scalar tResidualNormSquared = 0.0;
+        Plato::Scalar tRhsNormSquared = 0.0;
+        Kokkos::parallel_reduce(Kokkos::RangePolicy<>(0, aSolution.size()), LAMBDA_EXPRESSION(const Plato::OrdinalType & aDofOrdinal, Plato::Scalar & aResidualSum)
+        {
+            Plato::Scalar tValue = 0.0;
+            Plato::Scalar tRhs = (1.0 - tWeight) * tRhsA(aDofOrdinal) + tWeight * tRhsB(aDofOrdinal);
+            Plato::Scalar tResidual = tRhs;
+            for(Plato::OrdinalType tIndex = 0; tIndex < tSize; tIndex++)
+            {
+                tValue += aReducedSolution(tIndex) * tBasis(tIndex, aDofOrdinal);
+                tResidual -= aReducedSolution(tIndex) * ((1.0 - tWeight) * tBasisTimesA(tIndex, aDofOrdinal)
+                        + tWeight * tBasisTimesB(tIndex, aDofOrdinal));
+            }
+            aSolution(aDofOrdinal) = tValue;
+            aResidualSum += tResidual * tResidual;
+        }, tResidualNormSquared);
+        Kokkos::parallel_reduce(Kokkos::RangePolicy<>(0, aSolution.size()), LAMBDA_EXPRESSION(const Plato::OrdinalType & aDofOrdinal, Plato::Scalar & aRhsSum)
+        {
+            Plato::Scalar tRhs = (1.0 - tWeight) * tRhsA(aDofOrdinal) + tWeight * tRhsB(aDofOrdinal);
+            aRhsSum += tRhs * tRhs;
+        }, tRhsNormSquared);
+
+        return tRhsNormSquared > 0.0 ? std::sqrt(tResidualNormSquared / tRhsNormSquared) : std::sqrt(tResidualNormSquared);
+    }
+};
+// class ReducedFrequencySweep
+
+} // namespace Plato
+
+#endif /* REDUCEDFREQUENCYSWEEP_HPP_ */
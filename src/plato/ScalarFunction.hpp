@@ -35,6 +35,7 @@ class ScalarFunction : public WorksetBase<PhysicsT>
     using WorksetBase<PhysicsT>::m_stateEntryOrdinal;
     using WorksetBase<PhysicsT>::m_controlEntryOrdinal;
     using WorksetBase<PhysicsT>::m_configEntryOrdinal;
+    using WorksetBase<PhysicsT>::m_cellColoring;
 
     using Residual  = typename Plato::Evaluation<PhysicsT>::Residual;
     using Jacobian  = typename Plato::Evaluation<PhysicsT>::Jacobian;
@@ -75,6 +76,8 @@ class ScalarFunction : public WorksetBase<PhysicsT>
 
       mScalarFunctionGradientX
         = tFactory.template createScalarFunction<GradientX>(aMesh, aMeshSets, aDataMap, aParamList, aScalarFunctionType);
+
+      WorksetBase<PhysicsT>::setColoredAssembly(aMesh, aParamList.get<bool>("Colored Assembly", false));
     }
 
     /**************************************************************************/
@@ -199,7 +202,7 @@ class ScalarFunction : public WorksetBase<PhysicsT>
       // create and assemble to return view
       //
       Plato::ScalarVector tObjGradientX("objective gradient configuration",m_numSpatialDims*m_numNodes);
-      Plato::assemble_vector_gradient<m_numNodesPerCell, m_numSpatialDims>(m_numCells, m_configEntryOrdinal, tResult, tObjGradientX);
+      Plato::assemble_vector_gradient<m_numNodesPerCell, m_numSpatialDims>(m_numCells, m_configEntryOrdinal, tResult, tObjGradientX, m_cellColoring);
       Plato::Scalar tObjectiveValue = Plato::assemble_scalar_func_value<Plato::Scalar>(m_numCells, tResult);
 
       mScalarFunctionGradientX->postEvaluate( tObjGradientX, tObjectiveValue );
@@ -248,7 +251,7 @@ class ScalarFunction : public WorksetBase<PhysicsT>
       // create and assemble to return view
       //
       Plato::ScalarVector tObjGradientU("objective gradient state",m_numDofsPerNode*m_numNodes);
-      Plato::assemble_vector_gradient<m_numNodesPerCell, m_numDofsPerNode>(m_numCells, m_stateEntryOrdinal, tResult, tObjGradientU);
+      Plato::assemble_vector_gradient<m_numNodesPerCell, m_numDofsPerNode>(m_numCells, m_stateEntryOrdinal, tResult, tObjGradientU, m_cellColoring);
       Plato::Scalar tObjectiveValue = Plato::assemble_scalar_func_value<Plato::Scalar>(m_numCells, tResult);
 
       mScalarFunctionGradientU->postEvaluate( tObjGradientU, tObjectiveValue );
@@ -297,7 +300,7 @@ class ScalarFunction : public WorksetBase<PhysicsT>
       // create and assemble to return view
       //
       Plato::ScalarVector tObjGradientZ("objective gradient control",m_numNodes);
-      Plato::assemble_scalar_gradient<m_numNodesPerCell>(m_numCells, m_controlEntryOrdinal, tResult, tObjGradientZ);
+      Plato::assemble_scalar_gradient<m_numNodesPerCell>(m_numCells, m_controlEntryOrdinal, tResult, tObjGradientZ, m_cellColoring);
       Plato::Scalar tObjectiveValue = Plato::assemble_scalar_func_value<Plato::Scalar>(m_numCells, tResult);
 
       mScalarFunctionGradientZ->postEvaluate( tObjGradientZ, tObjectiveValue );
@@ -20,11 +20,13 @@
 #include "EssentialBCs.hpp"
 #include "ImplicitFunctors.hpp"
 #include "ApplyConstraints.hpp"
+#include "NativeSparseLinearProblem.hpp"
 
 #include "plato/ScalarFunction.hpp"
 #include "plato/VectorFunction.hpp"
 #include "plato/PlatoStaticsTypes.hpp"
 #include "plato/PlatoAbstractProblem.hpp"
+#include "plato/ReducedFrequencySweep.hpp"
 #include "plato/SimplexStructuralDynamics.hpp"
 
 #ifdef HAVE_AMGX
@@ -57,10 +59,23 @@ private:
     Plato::ScalarVector mExternalForce;
 
     Plato::ScalarMultiVector mStates;
+    Plato::ScalarMultiVector mAdjoints; /* adjoint per frequency, reduced order sweeps only */
 
     std::vector<Plato::Scalar> mFreqArray;
+    std::vector<Plato::OrdinalType> mFreqIterations; /* linear solver iterations per frequency, last sweep */
+    bool mWarmStart; /* start each frequency's solve from the previous frequency's solution */
+    Teuchos::ParameterList mSolverParams; /* native solver parameters, used without AmgX */
     Teuchos::RCP<Plato::CrsMatrixType> mJacobian;
 
+    bool mReducedOrder; /* solve the state and adjoint sweeps in a reduced space */
+    Plato::ReducedFrequencySweep<mNumDofsPerNode> mReducedStateSweep;
+    Plato::ReducedFrequencySweep<mNumDofsPerNode> mReducedAdjointSweep;
+
+#ifdef HAVE_AMGX
+    using AmgXLinearProblem = lgr::AmgXSparseLinearProblem<Plato::OrdinalType, mNumDofsPerNode>;
+    std::shared_ptr<AmgXLinearProblem> mAmgXSolver; /* one solver serves a whole sweep; only the values change */
+#endif
+
     // required
     std::shared_ptr<const VectorFunction<SimplexPhysics>> mEquality;
 
@@ -89,7 +104,13 @@ public:
             mGradControl("GradControl", mNumControls),
             mExternalForce("BoundaryLoads", mNumStates),
             mFreqArray(),
+            mFreqIterations(),
+            mWarmStart(true),
+            mSolverParams(),
             mJacobian(Teuchos::null),
+            mReducedOrder(false),
+            mReducedStateSweep(),
+            mReducedAdjointSweep(),
             mEquality(nullptr),
             mObjective(nullptr),
             mConstraint(nullptr),
@@ -117,7 +138,13 @@ public:
             mGradControl("GradControl", mNumControls),
             mExternalForce("ExternalForce", mNumStates),
             mFreqArray(),
+            mFreqIterations(),
+            mWarmStart(true),
+            mSolverParams(),
             mJacobian(Teuchos::null),
+            mReducedOrder(false),
+            mReducedStateSweep(),
+            mReducedAdjointSweep(),
             mEquality(aEquality),
             mObjective(nullptr),
             mConstraint(nullptr),
@@ -192,6 +219,56 @@ public:
         mNumIterationsAmgX = aInput;   
     }
 
+    /******************************************************************************//**
+     *
+     * @brief Start each frequency's solve from the previous frequency's solution (default)
+     *        or from zero
+     *
+     * @param[in] aInput warm start flag
+     *
+    **********************************************************************************/
+    void setWarmStart(const bool & aInput)
+    {
+        mWarmStart = aInput;
+    }
+
+    /******************************************************************************//**
+     *
+     * @brief Solve the state and adjoint sweeps in a reduced space built from a few
+     *        full-order solves (see ReducedFrequencySweep) or, by default, in full
+     *
+     * @param[in] aInput reduced order flag
+     * @param[in] aParams reduced order parameters
+     *
+    **********************************************************************************/
+    void setReducedOrder(const bool & aInput, const Teuchos::ParameterList & aParams = Teuchos::ParameterList())
+    {
+        mReducedOrder = aInput;
+        mReducedStateSweep = Plato::ReducedFrequencySweep<mNumDofsPerNode>(aParams);
+        mReducedAdjointSweep = Plato::ReducedFrequencySweep<mNumDofsPerNode>(aParams);
+    }
+
+    /******************************************************************************//**
+     *
+     * @brief Get the reduced order model of the last state sweep
+     *
+    **********************************************************************************/
+    const Plato::ReducedFrequencySweep<mNumDofsPerNode> & getReducedStateSweep() const
+    {
+        return mReducedStateSweep;
+    }
+
+    /******************************************************************************//**
+     *
+     * @brief Get the number of linear solver iterations taken at each frequency
+     *        by the last call to solution
+     *
+    **********************************************************************************/
+    const std::vector<Plato::OrdinalType> & getFrequencyIterations() const
+    {
+        return mFreqIterations;
+    }
+
     /******************************************************************************//**
      *
      * @brief Set state vector
@@ -256,26 +333,61 @@ public:
     {
         assert(aControl.size() == mNumControls);
 
+        // the equations are linear in the state, so the residual and Jacobian are
+        // evaluated at zero and the state slot only holds the initial guess.  The
+        // Jacobian graph is built once by the equality function and reused here.
+        Plato::ScalarVector tZeroState("Zero State", mNumStates);
+#ifdef HAVE_AMGX
+        mAmgXSolver.reset();
+#endif
+
+        Plato::OrdinalType tIndexA, tIndexB;
+        if(mReducedOrder && this->findSweepEndpoints(tIndexA, tIndexB))
+        {
+            // the constrained system is affine in the squared frequency, so the
+            // whole sweep needs only the two assemblies at the end points
+            auto tFreqA = mFreqArray[tIndexA];
+            auto tRhsA = mEquality->value(tZeroState, aControl, tFreqA);
+            this->applyBoundaryLoads(tRhsA);
+            mJacobian = mEquality->gradient_u(tZeroState, aControl, tFreqA);
+            auto tMatrixA = mJacobian;
+            this->applyConstraints(tMatrixA, tRhsA);
+
+            auto tFreqB = mFreqArray[tIndexB];
+            auto tRhsB = mEquality->value(tZeroState, aControl, tFreqB);
+            this->applyBoundaryLoads(tRhsB);
+            auto tMatrixB = mEquality->gradient_u(tZeroState, aControl, tFreqB);
+            this->applyConstraints(tMatrixB, tRhsB);
+
+            mReducedStateSweep.setOperator(tMatrixA, tRhsA, tFreqA, tMatrixB, tRhsB, tFreqB);
+            mReducedStateSweep.solve(mFreqArray, mStates, this->fullOrderSolver());
+            mFreqIterations = mReducedStateSweep.getIterations();
+            return mStates;
+        }
+
         const Plato::OrdinalType tNumFreqs = mFreqArray.size();
+        mFreqIterations.assign(tNumFreqs, 0);
         for(Plato::OrdinalType tFreqIndex = 0; tFreqIndex < tNumFreqs; tFreqIndex++)
         {
             assert(mResidual.size() == mNumStates);
             auto tMyStatesSubView = Kokkos::subview(mStates, tFreqIndex, Kokkos::ALL());
             assert(tMyStatesSubView.size() == mNumStates);
-            Plato::fill(static_cast<Plato::Scalar>(0.0), tMyStatesSubView);
+            if(mWarmStart && tFreqIndex > 0)
+            {
+                Kokkos::deep_copy(tMyStatesSubView, Kokkos::subview(mStates, tFreqIndex - 1, Kokkos::ALL()));
+            }
+            else
+            {
+                Plato::fill(static_cast<Plato::Scalar>(0.0), tMyStatesSubView);
+            }
             auto tMyFrequency = mFreqArray[tFreqIndex];
-            mResidual = mEquality->value(tMyStatesSubView, aControl, tMyFrequency);
+            mResidual = mEquality->value(tZeroState, aControl, tMyFrequency);
             this->applyBoundaryLoads(mResidual);
 
-            mJacobian = mEquality->gradient_u(tMyStatesSubView, aControl, tMyFrequency);
+            mJacobian = mEquality->gradient_u(tZeroState, aControl, tMyFrequency);
             this->applyConstraints(mJacobian, mResidual);
 
-#ifdef HAVE_AMGX
-            using AmgXLinearProblem = lgr::AmgXSparseLinearProblem<Plato::OrdinalType, mNumDofsPerNode>;
-            auto tConfigString = AmgXLinearProblem::getConfigString(mNumIterationsAmgX);
-            auto tSolver = std::make_shared<AmgXLinearProblem>(*mJacobian, tMyStatesSubView, mResidual, tConfigString);
-            tSolver->solve();
-#endif
+            mFreqIterations[tFreqIndex] = this->solveLinearSystem(mJacobian, tMyStatesSubView, mResidual);
         }
 
         return mStates;
@@ -674,6 +786,15 @@ private:
             mAdjointProb = std::make_shared<VectorFunction<SimplexPhysics>>(aMesh, aMeshSets, mDataMap, aParamList, tAdjointName);
         }
 
+        // The structural dynamics Jacobian is not symmetric
+        mSolverParams.set("Solver", std::string("GMRES"));
+        mSolverParams.set("Preconditioner", std::string("Block Jacobi"));
+        if(aParamList.isSublist("Linear Solver"))
+        {
+            mSolverParams.setParameters(aParamList.sublist("Linear Solver"));
+            mSolverParams.remove("Package", false);
+        }
+
         // Parse essential boundary conditions (i.e. Dirichlet)
         //
         Plato::EssentialBCs<SimplexPhysics>
@@ -690,6 +811,11 @@ private:
             auto tFreqParams = aParamList.sublist("Frequency Steps");
             assert(tFreqParams.isParameter("Values"));
             auto tFreqValues = tFreqParams.get < Teuchos::Array < Plato::Scalar >> ("Values");
+            mWarmStart = tFreqParams.get<bool>("Warm Start", true);
+            if(tFreqParams.isSublist("Reduced Order"))
+            {
+                this->setReducedOrder(true, tFreqParams.sublist("Reduced Order"));
+            }
 
             const Plato::OrdinalType tNumFrequencies = tFreqValues.size();
             mFreqArray.resize(tNumFrequencies);
@@ -713,29 +839,107 @@ private:
         }
     }
 
+    /******************************************************************************//**
+     *
+     * @brief Find the sweep frequencies with the smallest and largest squared value;
+     *        returns false if they are equal, i.e. a reduced model would gain nothing
+     *
+    **********************************************************************************/
+    bool findSweepEndpoints(Plato::OrdinalType & aIndexA, Plato::OrdinalType & aIndexB) const
+    {
+        aIndexA = 0;
+        aIndexB = 0;
+        const Plato::OrdinalType tNumFreqs = mFreqArray.size();
+        for(Plato::OrdinalType tFreqIndex = 1; tFreqIndex < tNumFreqs; tFreqIndex++)
+        {
+            auto tOmegaSquared = mFreqArray[tFreqIndex] * mFreqArray[tFreqIndex];
+            if(tOmegaSquared < mFreqArray[aIndexA] * mFreqArray[aIndexA])
+            {
+                aIndexA = tFreqIndex;
+            }
+            if(tOmegaSquared > mFreqArray[aIndexB] * mFreqArray[aIndexB])
+            {
+                aIndexB = tFreqIndex;
+            }
+        }
+        return mFreqArray[aIndexA] * mFreqArray[aIndexA] != mFreqArray[aIndexB] * mFreqArray[aIndexB];
+    }
+
+    /******************************************************************************//**
+     *
+     * @brief Solve aMatrix * aSolution = aRhs; aSolution holds the initial guess.
+     *        Returns the number of iterations taken.
+     *
+    **********************************************************************************/
+    Plato::OrdinalType solveLinearSystem(const Teuchos::RCP<Plato::CrsMatrixType> & aMatrix,
+                                         const Plato::ScalarVector & aSolution,
+                                         const Plato::ScalarVector & aRhs)
+    {
+#ifdef HAVE_AMGX
+        if(mAmgXSolver == nullptr)
+        {
+            auto tConfigString = AmgXLinearProblem::getConfigString(mNumIterationsAmgX);
+            mAmgXSolver = std::make_shared<AmgXLinearProblem>(*aMatrix, aSolution, aRhs, tConfigString);
+        }
+        else
+        {
+            mAmgXSolver->setMatrix(*aMatrix, mNumStates);
+            mAmgXSolver->setRHS(aRhs);
+            mAmgXSolver->setSolution(aSolution);
+        }
+        mAmgXSolver->solve();
+        return mAmgXSolver->getIterationsTaken();
+#else
+        Teuchos::ParameterList tSolverParams(mSolverParams);
+        tSolverParams.get<int>("Maximum Iterations", mNumIterationsAmgX);
+        lgr::NativeSparseLinearProblem<Plato::OrdinalType> tSolver(*aMatrix, aSolution, aRhs, tSolverParams);
+        tSolver.solve();
+        return tSolver.getIterationsTaken();
+#endif
+    }
+
     /******************************************************************************/
-    Teuchos::RCP<Plato::CrsMatrixType> computePartialResidualWrtDesignVar(const Plato::partial::derivative_t & aWhichType,
-                                                                          const Plato::ScalarVector & aState,
-                                                                          const Plato::ScalarVector & aControl,
-                                                                          const Plato::Scalar & aTimeStep)
+    typename Plato::ReducedFrequencySweep<mNumDofsPerNode>::FullOrderSolver fullOrderSolver()
+    /******************************************************************************/
+    {
+        return [this](const Teuchos::RCP<Plato::CrsMatrixType> & aMatrix,
+                      const Plato::ScalarVector & aSolution,
+                      const Plato::ScalarVector & aRhs)
+        {
+            return this->solveLinearSystem(aMatrix, aSolution, aRhs);
+        };
+    }
+
+    /******************************************************************************/
+    void addAdjointWeightedPartialResidualWrtDesignVar(const Plato::partial::derivative_t & aWhichType,
+                                                       const Plato::ScalarVector & aState,
+                                                       const Plato::ScalarVector & aControl,
+                                                       const Plato::Scalar & aTimeStep,
+                                                       Plato::ScalarVector & aOutput)
     /******************************************************************************/
     {
         switch(aWhichType)
         {
-            case Plato::partial::STATE:
-            {
-                return mEquality->gradient_u(aState, aControl, aTimeStep);
-            }
             case Plato::partial::CONTROL:
             {
-                return mEquality->gradient_z(aState, aControl, aTimeStep);
+                mEquality->adjoint_gradient_z(aState, aControl, mMyAdjoint, aOutput, aTimeStep);
+                break;
             }
             case Plato::partial::CONFIGURATION:
             {
-                return mEquality->gradient_x(aState, aControl, aTimeStep);
+                mEquality->adjoint_gradient_x(aState, aControl, mMyAdjoint, aOutput, aTimeStep);
+                break;
+            }
+            default:
+            {
+                std::ostringstream tErrorMessage;
+                tErrorMessage << "\n\n************** ERROR IN FILE: " << __FILE__ << ", FUNCTION: " << __PRETTY_FUNCTION__
+                        << ", LINE: " << __LINE__
+                        << "\nMESSAGE: ADJOINT-WEIGHTED PARTIAL DERIVATIVE REQUESTED WITH RESPECT TO AN UNSUPPORTED VARIABLE.\n"
+                        << "ONLY CONTROL AND CONFIGURATION PARTIAL DERIVATIVES ARE SUPPORTED. **************\n\n";
+                throw std::runtime_error(tErrorMessage.str().c_str());
             }
         }
-        return (Teuchos::null);
     }
 
     /******************************************************************************/
@@ -745,7 +949,45 @@ private:
                                  Plato::ScalarVector & aOutput)
     /******************************************************************************/
     {
+#ifdef HAVE_AMGX
+        mAmgXSolver.reset();
+#endif
         const Plato::OrdinalType tNumFreqs = mFreqArray.size();
+
+        Plato::OrdinalType tIndexA, tIndexB;
+        if(mReducedOrder && this->findSweepEndpoints(tIndexA, tIndexB))
+        {
+            // adjoint operator and right hand side are affine in the squared frequency, too
+            auto tFreqA = mFreqArray[tIndexA];
+            mJacobian = mAdjointProb->gradient_u(Kokkos::subview(aState, tIndexA, Kokkos::ALL()), aControl, tFreqA);
+            auto tMatrixA = mJacobian;
+            Plato::ScalarVector tRhsA("Adjoint RHS", mNumStates);
+            Kokkos::deep_copy(tRhsA, mGradState);
+            this->applyConstraints(tMatrixA, tRhsA);
+
+            auto tFreqB = mFreqArray[tIndexB];
+            auto tMatrixB = mAdjointProb->gradient_u(Kokkos::subview(aState, tIndexB, Kokkos::ALL()), aControl, tFreqB);
+            Plato::ScalarVector tRhsB("Adjoint RHS", mNumStates);
+            Kokkos::deep_copy(tRhsB, mGradState);
+            this->applyConstraints(tMatrixB, tRhsB);
+
+            if(mAdjoints.extent(0) != mStates.extent(0) || mAdjoints.extent(1) != mStates.extent(1))
+            {
+                mAdjoints = Plato::ScalarMultiVector("Adjoints", tNumFreqs, mNumStates);
+            }
+            mReducedAdjointSweep.setOperator(tMatrixA, tRhsA, tFreqA, tMatrixB, tRhsB, tFreqB);
+            mReducedAdjointSweep.solve(mFreqArray, mAdjoints, this->fullOrderSolver());
+
+            for(Plato::OrdinalType tFreqIndex = 0; tFreqIndex < tNumFreqs; tFreqIndex++)
+            {
+                auto tMyFrequency = mFreqArray[tFreqIndex];
+                auto tMyStatesSubView = Kokkos::subview(aState, tFreqIndex, Kokkos::ALL());
+                Kokkos::deep_copy(mMyAdjoint, Kokkos::subview(mAdjoints, tFreqIndex, Kokkos::ALL()));
+                this->addAdjointWeightedPartialResidualWrtDesignVar(aWhichPartial, tMyStatesSubView, aControl, tMyFrequency, aOutput);
+            }
+            return;
+        }
+
         for(Plato::OrdinalType tFreqIndex = 0; tFreqIndex < tNumFreqs; tFreqIndex++)
         {
             // compute dgdu: partial of PDE wrt state
@@ -756,19 +998,10 @@ private:
 
             // adjoint problem \lambda = (dg/du)-*(df/du) uses transpose of global stiffness,
             Plato::fill(static_cast<Plato::Scalar>(0.0), mMyAdjoint);
-#ifdef HAVE_AMGX
-            using AmgXLinearProblem = lgr::AmgXSparseLinearProblem< Plato::OrdinalType, mNumDofsPerNode>;
-            auto tConfigString = AmgXLinearProblem::getConfigString();
-            auto tSolver = std::make_shared<AmgXLinearProblem>(*mJacobian, mMyAdjoint, mGradState, tConfigString);
-            tSolver->solve();
-#endif
-
-            // compute dgdz: partial of PDE wrt design variable.
-            auto tPartialWrtDesignVar =
-                    this->computePartialResidualWrtDesignVar(aWhichPartial, tMyStatesSubView, aControl, tMyFrequency);
+            this->solveLinearSystem(mJacobian, mMyAdjoint, mGradState);
 
-            // compute dfdz + dgdz . adjoint
-            Plato::MatrixTimesVectorPlusVector(tPartialWrtDesignVar, mMyAdjoint, aOutput);
+            // compute dfdz + dgdz . adjoint without assembling dgdz
+            this->addAdjointWeightedPartialResidualWrtDesignVar(aWhichPartial, tMyStatesSubView, aControl, tMyFrequency, aOutput);
         }
     }
 };
@@ -49,6 +49,43 @@ class VectorFunction : public WorksetBase<PhysicsT>
 
     Plato::DataMap& m_dataMap;
 
+    // The Jacobian graphs and their entry ordinal tables depend only on the mesh
+    // topology.  They are built by the first assembly and reused afterwards, so
+    // later assemblies only allocate and fill values.
+    mutable Teuchos::RCP<Plato::CrsMatrixType> mJacobianGraphU;
+    mutable Teuchos::RCP<Plato::CrsMatrixType> mJacobianGraphX;
+    mutable Teuchos::RCP<Plato::CrsMatrixType> mJacobianGraphZ;
+    mutable Plato::BlockMatrixEntryOrdinalTable<m_numSpatialDims, m_numDofsPerNode, m_numDofsPerNode> mJacobianEntryOrdinalU;
+    mutable Plato::BlockMatrixEntryOrdinalTable<m_numSpatialDims, m_numSpatialDims, m_numDofsPerNode> mJacobianEntryOrdinalX;
+    mutable Plato::BlockMatrixEntryOrdinalTable<m_numSpatialDims, m_numControl, m_numDofsPerNode>     mJacobianEntryOrdinalZ;
+
+    /**************************************************************************//**
+    *
+    * @brief Return a zeroed block matrix on the cached graph, building the graph
+    *        and its entry ordinal table on first use
+    * @param [in] aMesh mesh data base
+    * @param [in,out] aGraph cached graph
+    * @param [in,out] aEntryOrdinal cached entry ordinal table
+    *
+    ******************************************************************************/
+    template<Plato::OrdinalType DofsPerNode_I, Plato::OrdinalType DofsPerNode_J, class EntryOrdinalTableType>
+    Teuchos::RCP<Plato::CrsMatrixType>
+    createJacobian(Omega_h::Mesh& aMesh,
+                   Teuchos::RCP<Plato::CrsMatrixType>& aGraph,
+                   EntryOrdinalTableType& aEntryOrdinal) const
+    {
+      if( aGraph.is_null() )
+      {
+        auto tMatrix = Plato::CreateBlockMatrix<Plato::CrsMatrixType, DofsPerNode_I, DofsPerNode_J>( &aMesh );
+        aEntryOrdinal = EntryOrdinalTableType( tMatrix, &aMesh );
+        aGraph = Teuchos::rcp( new Plato::CrsMatrixType( tMatrix->rowMap(), tMatrix->columnIndices(),
+                                                         Plato::ScalarVector(), DofsPerNode_I, DofsPerNode_J ) );
+      }
+      Plato::ScalarVector tEntries("matrix entries", aGraph->columnIndices().size()*DofsPerNode_I*DofsPerNode_J);
+      return Teuchos::rcp( new Plato::CrsMatrixType( aGraph->rowMap(), aGraph->columnIndices(),
+                                                     tEntries, DofsPerNode_I, DofsPerNode_J ) );
+    }
+
   public:
 
     /**************************************************************************//**
@@ -78,6 +115,8 @@ class VectorFunction : public WorksetBase<PhysicsT>
       mVectorFunctionJacobianZ = tFunctionFactory.template createVectorFunction<GradientZ>(aMesh, aMeshSets, aDataMap, aParamList, aProblemType);
 
       mVectorFunctionJacobianX = tFunctionFactory.template createVectorFunction<GradientX>(aMesh, aMeshSets, aDataMap, aParamList, aProblemType);
+
+      WorksetBase<PhysicsT>::setColoredAssembly(aMesh, aParamList.get<bool>("Colored Assembly", false));
     }
 
     /**************************************************************************//**
@@ -187,10 +226,10 @@ class VectorFunction : public WorksetBase<PhysicsT>
     }
 
     /**************************************************************************/
-    Teuchos::RCP<Plato::CrsMatrixType>
-    gradient_x(const Plato::ScalarVector & aState,
-               const Plato::ScalarVector & aControl,
-               Plato::Scalar aTimeStep = 0.0) const
+    Plato::ScalarMultiVectorT<typename GradientX::ResultScalarType>
+    jacobianWorksetX(const Plato::ScalarVector & aState,
+                     const Plato::ScalarVector & aControl,
+                     Plato::Scalar aTimeStep) const
     /**************************************************************************/
     {
         using ConfigScalar = typename GradientX::ConfigScalarType;
@@ -222,18 +261,27 @@ class VectorFunction : public WorksetBase<PhysicsT>
         //
         mVectorFunctionJacobianX->evaluate(tStateWS, tControlWS, tConfigWS, tJacobian, aTimeStep);
 
+        return tJacobian;
+    }
+
+    /**************************************************************************/
+    Teuchos::RCP<Plato::CrsMatrixType>
+    gradient_x(const Plato::ScalarVector & aState,
+               const Plato::ScalarVector & aControl,
+               Plato::Scalar aTimeStep = 0.0) const
+    /**************************************************************************/
+    {
+        auto tJacobian = jacobianWorksetX(aState, aControl, aTimeStep);
+
         // create return matrix
         //
         auto tMesh = mVectorFunctionJacobianX->getMesh();
         Teuchos::RCP<Plato::CrsMatrixType> tJacobianMat =
-                Plato::CreateBlockMatrix<Plato::CrsMatrixType, m_numSpatialDims, m_numDofsPerNode>(&tMesh);
+                createJacobian<m_numSpatialDims, m_numDofsPerNode>(tMesh, mJacobianGraphX, mJacobianEntryOrdinalX);
 
         // assembly to return matrix
-        Plato::BlockMatrixEntryOrdinal<m_numSpatialDims, m_numSpatialDims, m_numDofsPerNode>
-            tJacobianMatEntryOrdinal(tJacobianMat, &tMesh);
-
         auto tJacobianMatEntries = tJacobianMat->entries();
-        WorksetBase<PhysicsT>::assembleTransposeJacobian(m_numDofsPerCell, m_numConfigDofsPerCell, tJacobianMatEntryOrdinal, tJacobian, tJacobianMatEntries);
+        WorksetBase<PhysicsT>::assembleTransposeJacobian(m_numDofsPerCell, m_numConfigDofsPerCell, mJacobianEntryOrdinalX, tJacobian, tJacobianMatEntries);
 
         return tJacobianMat;
     }
@@ -278,23 +326,20 @@ class VectorFunction : public WorksetBase<PhysicsT>
       //
       auto tMesh = mVectorFunctionJacobianU->getMesh();
       Teuchos::RCP<Plato::CrsMatrixType> tJacobianMat =
-              Plato::CreateBlockMatrix<Plato::CrsMatrixType, m_numDofsPerNode, m_numDofsPerNode>( &tMesh );
+              createJacobian<m_numDofsPerNode, m_numDofsPerNode>( tMesh, mJacobianGraphU, mJacobianEntryOrdinalU );
 
       // assembly to return matrix
-      Plato::BlockMatrixEntryOrdinal<m_numSpatialDims, m_numDofsPerNode, m_numDofsPerNode>
-          tJacobianMatEntryOrdinal( tJacobianMat, &tMesh );
-
       auto tJacobianMatEntries = tJacobianMat->entries();
-      WorksetBase<PhysicsT>::assembleJacobian(m_numDofsPerCell, m_numDofsPerCell, tJacobianMatEntryOrdinal, tJacobian, tJacobianMatEntries);
+      WorksetBase<PhysicsT>::assembleJacobian(m_numDofsPerCell, m_numDofsPerCell, mJacobianEntryOrdinalU, tJacobian, tJacobianMatEntries);
 
       return tJacobianMat;
     }
 
     /**************************************************************************/
-    Teuchos::RCP<Plato::CrsMatrixType>
-    gradient_z(const Plato::ScalarVectorT<Plato::Scalar> & aState,
-               const Plato::ScalarVectorT<Plato::Scalar> & aControl,
-               Plato::Scalar aTimeStep = 0.0) const
+    Plato::ScalarMultiVectorT<typename GradientZ::ResultScalarType>
+    jacobianWorksetZ(const Plato::ScalarVectorT<Plato::Scalar> & aState,
+                     const Plato::ScalarVectorT<Plato::Scalar> & aControl,
+                     Plato::Scalar aTimeStep) const
     /**************************************************************************/
     {
       using ConfigScalar  = typename GradientZ::ConfigScalarType;
@@ -326,21 +371,74 @@ class VectorFunction : public WorksetBase<PhysicsT>
       //
       mVectorFunctionJacobianZ->evaluate( tStateWS, tControlWS, tConfigWS, tJacobian, aTimeStep );
 
+      return tJacobian;
+    }
+
+    /**************************************************************************/
+    Teuchos::RCP<Plato::CrsMatrixType>
+    gradient_z(const Plato::ScalarVectorT<Plato::Scalar> & aState,
+               const Plato::ScalarVectorT<Plato::Scalar> & aControl,
+               Plato::Scalar aTimeStep = 0.0) const
+    /**************************************************************************/
+    {
+      auto tJacobian = jacobianWorksetZ(aState, aControl, aTimeStep);
+
       // create return matrix
       //
       auto tMesh = mVectorFunctionJacobianZ->getMesh();
       Teuchos::RCP<Plato::CrsMatrixType> tJacobianMat =
-              Plato::CreateBlockMatrix<Plato::CrsMatrixType, m_numControl, m_numDofsPerNode>( &tMesh );
+              createJacobian<m_numControl, m_numDofsPerNode>( tMesh, mJacobianGraphZ, mJacobianEntryOrdinalZ );
 
       // assembly to return matrix
-      Plato::BlockMatrixEntryOrdinal<m_numSpatialDims, m_numControl, m_numDofsPerNode>
-        tJacobianMatEntryOrdinal( tJacobianMat, &tMesh );
-
       auto tJacobianMatEntries = tJacobianMat->entries();
-      WorksetBase<PhysicsT>::assembleTransposeJacobian(m_numDofsPerCell, m_numNodesPerCell, tJacobianMatEntryOrdinal, tJacobian, tJacobianMatEntries);
+      WorksetBase<PhysicsT>::assembleTransposeJacobian(m_numDofsPerCell, m_numNodesPerCell, mJacobianEntryOrdinalZ, tJacobian, tJacobianMatEntries);
 
       return tJacobianMat;
     }
+
+    /**************************************************************************//**
+    *
+    * @brief Add the adjoint-weighted configuration gradient, aOutput += aAdjoint^T dR/dx.
+    *        Same result as multiplying gradient_x by aAdjoint, without building the matrix.
+    * @param [in] aState state vector
+    * @param [in] aControl control vector
+    * @param [in] aAdjoint adjoint vector, one value per state dof
+    * @param [in,out] aOutput configuration gradient, one value per configuration dof
+    * @param [in] aTimeStep time step
+    *
+    ******************************************************************************/
+    void
+    adjoint_gradient_x(const Plato::ScalarVector & aState,
+                       const Plato::ScalarVector & aControl,
+                       const Plato::ScalarVector & aAdjoint,
+                       Plato::ScalarVector & aOutput,
+                       Plato::Scalar aTimeStep = 0.0) const
+    {
+        auto tJacobian = jacobianWorksetX(aState, aControl, aTimeStep);
+        WorksetBase<PhysicsT>::assembleAdjointWeightedJacobianX(aAdjoint, tJacobian, aOutput);
+    }
+
+    /**************************************************************************//**
+    *
+    * @brief Add the adjoint-weighted control gradient, aOutput += aAdjoint^T dR/dz.
+    *        Same result as multiplying gradient_z by aAdjoint, without building the matrix.
+    * @param [in] aState state vector
+    * @param [in] aControl control vector
+    * @param [in] aAdjoint adjoint vector, one value per state dof
+    * @param [in,out] aOutput control gradient, one value per control dof
+    * @param [in] aTimeStep time step
+    *
+    ******************************************************************************/
+    void
+    adjoint_gradient_z(const Plato::ScalarVectorT<Plato::Scalar> & aState,
+                       const Plato::ScalarVectorT<Plato::Scalar> & aControl,
+                       const Plato::ScalarVector & aAdjoint,
+                       Plato::ScalarVector & aOutput,
+                       Plato::Scalar aTimeStep = 0.0) const
+    {
+      auto tJacobian = jacobianWorksetZ(aState, aControl, aTimeStep);
+      WorksetBase<PhysicsT>::assembleAdjointWeightedJacobianZ(aAdjoint, tJacobian, aOutput);
+    }
 };
 
 #endif
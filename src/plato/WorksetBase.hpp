@@ -6,6 +6,7 @@
 #include <Omega_h_mesh.hpp>
 
 #include "ImplicitFunctors.hpp"
+#include "plato/CellColoring.hpp"
 #include "plato/SimplexFadTypes.hpp"
 
 #ifdef NDEBUG
@@ -64,22 +65,25 @@ inline Scalar assemble_scalar_func_value(const Plato::OrdinalType& aNumCells, co
 * @param aEntryOrdinal global indices to output vector
 * @param aGradien gradient workset - gradient values for each cell
 * @param aOutput assembled global gradient
+* @param aColoring cell coloring; assemble color by color without atomics unless empty
 *
 * *****************************************************************************/
 template<Plato::OrdinalType NumNodesPerCell, Plato::OrdinalType NumDofsPerNode, class EntryOrdinal, class Gradient, class ReturnVal>
 inline void assemble_vector_gradient(const Plato::OrdinalType& aNumCells,
                                      const EntryOrdinal& aEntryOrdinal,
                                      const Gradient& aGradient,
-                                     ReturnVal& aOutput)
+                                     ReturnVal& aOutput,
+                                     const Plato::CellColoring& aColoring = Plato::CellColoring())
 {
-    Kokkos::parallel_for(Kokkos::RangePolicy<>(0, aNumCells), LAMBDA_EXPRESSION(const Plato::OrdinalType & aCellOrdinal)
+    const bool tAtomic = aColoring.empty();
+    aColoring.for_each_cell(aNumCells, LAMBDA_EXPRESSION(const Plato::OrdinalType & aCellOrdinal)
     {
         for(Plato::OrdinalType tNodeIndex=0; tNodeIndex < NumNodesPerCell; tNodeIndex++)
         {
             for(Plato::OrdinalType tDimIndex=0; tDimIndex < NumDofsPerNode; tDimIndex++)
             {
                 Plato::OrdinalType tEntryOrdinal = aEntryOrdinal(aCellOrdinal, tNodeIndex, tDimIndex);
-                Kokkos::atomic_add(&aOutput(tEntryOrdinal), aGradient(aCellOrdinal).dx(tNodeIndex * NumDofsPerNode + tDimIndex));
+                Plato::assemble_add(tAtomic, aOutput(tEntryOrdinal), aGradient(aCellOrdinal).dx(tNodeIndex * NumDofsPerNode + tDimIndex));
             }
         }
     }, "Assemble - Vector Gradient Calculation");
@@ -98,20 +102,23 @@ inline void assemble_vector_gradient(const Plato::OrdinalType& aNumCells,
 * @param aEntryOrdinal global indices to output vector
 * @param aGradien gradient workset - gradient values for each cell
 * @param aOutput assembled global gradient
+* @param aColoring cell coloring; assemble color by color without atomics unless empty
 *
 *****************************************************************************/
 template<Plato::OrdinalType NumNodesPerCell, class EntryOrdinal, class Gradient, class ReturnVal>
 inline void assemble_scalar_gradient(const Plato::OrdinalType& aNumCells,
                                      const EntryOrdinal& aEntryOrdinal,
                                      const Gradient& aGradient,
-                                     ReturnVal& aOutput)
+                                     ReturnVal& aOutput,
+                                     const Plato::CellColoring& aColoring = Plato::CellColoring())
 {
-    Kokkos::parallel_for(Kokkos::RangePolicy<>(0, aNumCells), LAMBDA_EXPRESSION(const Plato::OrdinalType & aCellOrdinal)
+    const bool tAtomic = aColoring.empty();
+    aColoring.for_each_cell(aNumCells, LAMBDA_EXPRESSION(const Plato::OrdinalType & aCellOrdinal)
     {
       for(Plato::OrdinalType tNodeIndex=0; tNodeIndex < NumNodesPerCell; tNodeIndex++)
       {
           Plato::OrdinalType tEntryOrdinal = aEntryOrdinal(aCellOrdinal, tNodeIndex);
-          Kokkos::atomic_add(&aOutput(tEntryOrdinal), aGradient(aCellOrdinal).dx(tNodeIndex));
+          Plato::assemble_add(tAtomic, aOutput(tEntryOrdinal), aGradient(aCellOrdinal).dx(tNodeIndex));
       }
     }, "Assemble - Scalar Gradient Calculation");
 }
@@ -234,15 +241,17 @@ template<int numNodesPerCell, int numDofsPerNode, class StateEntryOrdinal, class
 inline void assemble_residual(int aNumCells, 
                               const StateEntryOrdinal & aStateEntryOrdinal, 
                               const Residual & aResidual, 
-                              ReturnVal & aReturnValue)
+                              ReturnVal & aReturnValue,
+                              const Plato::CellColoring & aColoring = Plato::CellColoring())
 /******************************************************************************/
 {
-  Kokkos::parallel_for(Kokkos::RangePolicy<int>(0,aNumCells), LAMBDA_EXPRESSION(const int & aCellOrdinal)
+  const bool tAtomic = aColoring.empty();
+  aColoring.for_each_cell(aNumCells, LAMBDA_EXPRESSION(const int & aCellOrdinal)
   {
     for(int tNodeIndex = 0; tNodeIndex < numNodesPerCell; tNodeIndex++){
       for(int tDofIndex = 0; tDofIndex < numDofsPerNode; tDofIndex++){
         int tEntryOrdinal = aStateEntryOrdinal(aCellOrdinal, tNodeIndex, tDofIndex);
-        Kokkos::atomic_add(&aReturnValue(tEntryOrdinal), aResidual(aCellOrdinal,tNodeIndex*numDofsPerNode+tDofIndex));
+        Plato::assemble_add(tAtomic, aReturnValue(tEntryOrdinal), aResidual(aCellOrdinal,tNodeIndex*numDofsPerNode+tDofIndex));
       }
     }
   }, "assemble_residual");
@@ -255,15 +264,17 @@ inline void assemble_jacobian(int aNumCells,
                               int aNumColumnsPerCell,
                               const MatrixEntriesOrdinal & aMatrixEntryOrdinal,
                               const Jacobian & aJacobianWorkset,
-                              ReturnVal & aReturnValue)
+                              ReturnVal & aReturnValue,
+                              const Plato::CellColoring & aColoring = Plato::CellColoring())
 /******************************************************************************/
 {
-  Kokkos::parallel_for(Kokkos::RangePolicy<>(0, aNumCells), LAMBDA_EXPRESSION(const int & aCellOrdinal)
+  const bool tAtomic = aColoring.empty();
+  aColoring.for_each_cell(aNumCells, LAMBDA_EXPRESSION(const int & aCellOrdinal)
   {
     for(int tRowIndex = 0; tRowIndex < aNumRowsPerCell; tRowIndex++){
       for(int tColumnIndex = 0; tColumnIndex < aNumColumnsPerCell; tColumnIndex++){
         int tEntryOrdinal = aMatrixEntryOrdinal(aCellOrdinal, tRowIndex, tColumnIndex);
-        Kokkos::atomic_add(&aReturnValue(tEntryOrdinal), aJacobianWorkset(aCellOrdinal,tRowIndex).dx(tColumnIndex));
+        Plato::assemble_add(tAtomic, aReturnValue(tEntryOrdinal), aJacobianWorkset(aCellOrdinal,tRowIndex).dx(tColumnIndex));
       }
     }
   }, "assemble_jacobian");
@@ -276,20 +287,58 @@ inline void assemble_transpose_jacobian(int aNumCells,
                                         int aNumColumnsPerCell,
                                         const MatrixEntriesOrdinal & aMatrixEntryOrdinal,
                                         const Jacobian & aJacobianWorkset,
-                                        ReturnVal & aReturnValue)
+                                        ReturnVal & aReturnValue,
+                                        const Plato::CellColoring & aColoring = Plato::CellColoring())
 /******************************************************************************/
 {
-  Kokkos::parallel_for(Kokkos::RangePolicy<>(0, aNumCells), LAMBDA_EXPRESSION(const int & aCellOrdinal)
+  const bool tAtomic = aColoring.empty();
+  aColoring.for_each_cell(aNumCells, LAMBDA_EXPRESSION(const int & aCellOrdinal)
   {
     for(int tRowIndex = 0; tRowIndex < aNumRowsPerCell; tRowIndex++){
       for(int tColumnIndex = 0; tColumnIndex < aNumColumnsPerCell; tColumnIndex++){
         int tEntryOrdinal = aMatrixEntryOrdinal(aCellOrdinal, tColumnIndex, tRowIndex);
-        Kokkos::atomic_add(&aReturnValue(tEntryOrdinal), aJacobianWorkset(aCellOrdinal,tRowIndex).dx(tColumnIndex));
+        Plato::assemble_add(tAtomic, aReturnValue(tEntryOrdinal), aJacobianWorkset(aCellOrdinal,tRowIndex).dx(tColumnIndex));
       }
     }
   }, "assemble_transpose_jacobian");
 }
 
+/******************************************************************************/
+template<int numNodesPerCell, int numDofsPerNode, int numDesignDofsPerNode,
+         class StateEntryOrdinal, class DesignEntryOrdinal, class Adjoint, class Jacobian, class ReturnVal>
+inline void assemble_adjoint_weighted_jacobian(int aNumCells,
+                                               const StateEntryOrdinal & aStateEntryOrdinal,
+                                               const DesignEntryOrdinal & aDesignEntryOrdinal,
+                                               const Adjoint & aAdjoint,
+                                               const Jacobian & aJacobianWorkset,
+                                               ReturnVal & aReturnValue,
+                                               const Plato::CellColoring & aColoring = Plato::CellColoring())
+/******************************************************************************/
+{
+  constexpr int tNumDofsPerCell = numNodesPerCell * numDofsPerNode;
+  const bool tAtomic = aColoring.empty();
+  aColoring.for_each_cell(aNumCells, LAMBDA_EXPRESSION(const int & aCellOrdinal)
+  {
+    Plato::Scalar tCellAdjoint[tNumDofsPerCell];
+    for(int tNodeIndex = 0; tNodeIndex < numNodesPerCell; tNodeIndex++){
+      for(int tDofIndex = 0; tDofIndex < numDofsPerNode; tDofIndex++){
+        tCellAdjoint[tNodeIndex*numDofsPerNode+tDofIndex] = aAdjoint(aStateEntryOrdinal(aCellOrdinal, tNodeIndex, tDofIndex));
+      }
+    }
+    for(int tNodeIndex = 0; tNodeIndex < numNodesPerCell; tNodeIndex++){
+      for(int tDofIndex = 0; tDofIndex < numDesignDofsPerNode; tDofIndex++){
+        int tColumnIndex = tNodeIndex*numDesignDofsPerNode + tDofIndex;
+        Plato::Scalar tValue = 0.0;
+        for(int tRowIndex = 0; tRowIndex < tNumDofsPerCell; tRowIndex++){
+          tValue += tCellAdjoint[tRowIndex] * aJacobianWorkset(aCellOrdinal,tRowIndex).dx(tColumnIndex);
+        }
+        int tEntryOrdinal = aDesignEntryOrdinal(aCellOrdinal, tNodeIndex, tDofIndex);
+        Plato::assemble_add(tAtomic, aReturnValue(tEntryOrdinal), tValue);
+      }
+    }
+  }, "assemble_adjoint_weighted_jacobian");
+}
+
 }//namespace Plato
 
 /******************************************************************************/
@@ -321,6 +370,8 @@ class WorksetBase : public SimplexPhysics
 
     Plato::NodeCoordinate<SpaceDim>     m_nodeCoordinate;
 
+    Plato::CellColoring m_cellColoring; //!< empty unless colored assembly is enabled
+
   public:
     /**************************************************************************/
     WorksetBase(Omega_h::Mesh& aMesh) :
@@ -329,11 +380,33 @@ class WorksetBase : public SimplexPhysics
             m_stateEntryOrdinal(Plato::VectorEntryOrdinal<SpaceDim, m_numDofsPerNode>(&aMesh)),
             m_controlEntryOrdinal(Plato::VectorEntryOrdinal<SpaceDim, m_numControl>(&aMesh)),
             m_configEntryOrdinal(Plato::VectorEntryOrdinal<SpaceDim, SpaceDim>(&aMesh)),
-            m_nodeCoordinate(Plato::NodeCoordinate<SpaceDim>(&aMesh))
+            m_nodeCoordinate(Plato::NodeCoordinate<SpaceDim>(&aMesh)),
+            m_cellColoring()
     {
     }
     /**************************************************************************/
 
+    /**************************************************************************/
+    //! Assemble one cell color at a time with plain stores (true) or all cells
+    //! at once with atomic updates (false, the default).  The coloring is
+    //! computed the first time it is enabled.
+    void setColoredAssembly(Omega_h::Mesh& aMesh, bool aColored = true)
+    /**************************************************************************/
+    {
+      if( !aColored )
+      {
+        m_cellColoring = Plato::CellColoring();
+      }
+      else if( m_cellColoring.empty() )
+      {
+        m_cellColoring = Plato::CellColoring(aMesh);
+      }
+    }
+
+    /**************************************************************************/
+    bool isColoredAssembly() const { return !m_cellColoring.empty(); }
+    /**************************************************************************/
+
     /**************************************************************************/
     void worksetControl( const Plato::ScalarVectorT<Plato::Scalar> & aControl,
                          Plato::ScalarMultiVectorT<Plato::Scalar> & aControlWS ) const
@@ -392,7 +465,7 @@ class WorksetBase : public SimplexPhysics
     /**************************************************************************/
     {
         Plato::assemble_residual<m_numNodesPerCell, m_numDofsPerNode>(
-                m_numCells, WorksetBase<SimplexPhysics>::m_stateEntryOrdinal, aResidualWorkset, aReturnValue);
+                m_numCells, WorksetBase<SimplexPhysics>::m_stateEntryOrdinal, aResidualWorkset, aReturnValue, m_cellColoring);
     }
 
     /**************************************************************************/
@@ -404,7 +477,7 @@ class WorksetBase : public SimplexPhysics
                           AssembledJacobianType & aReturnValue) const
     /**************************************************************************/
     {
-        Plato::assemble_jacobian(m_numCells, aNumRows, aNumColumns, aMatrixEntryOrdinal, aJacobianWorkset, aReturnValue);
+        Plato::assemble_jacobian(m_numCells, aNumRows, aNumColumns, aMatrixEntryOrdinal, aJacobianWorkset, aReturnValue, m_cellColoring);
     }
 
     /**************************************************************************/
@@ -416,7 +489,31 @@ class WorksetBase : public SimplexPhysics
                                    AssembledJacobianType & aReturnValue) const
     /**************************************************************************/
     {
-        Plato::assemble_transpose_jacobian(m_numCells, aNumRows, aNumColumns, aMatrixEntryOrdinal, aJacobianWorkset, aReturnValue);
+        Plato::assemble_transpose_jacobian(m_numCells, aNumRows, aNumColumns, aMatrixEntryOrdinal, aJacobianWorkset, aReturnValue, m_cellColoring);
+    }
+
+    /**************************************************************************/
+    //! aReturnValue += aAdjoint^T dR/dz, without forming dR/dz
+    template<class AdjointType, class JacobianWorksetType, class AssembledGradientType>
+    void assembleAdjointWeightedJacobianZ(const AdjointType & aAdjoint,
+                                          const JacobianWorksetType & aJacobianWorkset,
+                                          AssembledGradientType & aReturnValue) const
+    /**************************************************************************/
+    {
+        Plato::assemble_adjoint_weighted_jacobian<m_numNodesPerCell, m_numDofsPerNode, m_numControl>(
+                m_numCells, m_stateEntryOrdinal, m_controlEntryOrdinal, aAdjoint, aJacobianWorkset, aReturnValue, m_cellColoring);
+    }
+
+    /**************************************************************************/
+    //! aReturnValue += aAdjoint^T dR/dx, without forming dR/dx
+    template<class AdjointType, class JacobianWorksetType, class AssembledGradientType>
+    void assembleAdjointWeightedJacobianX(const AdjointType & aAdjoint,
+                                          const JacobianWorksetType & aJacobianWorkset,
+                                          AssembledGradientType & aReturnValue) const
+    /**************************************************************************/
+    {
+        Plato::assemble_adjoint_weighted_jacobian<m_numNodesPerCell, m_numDofsPerNode, SpaceDim>(
+                m_numCells, m_stateEntryOrdinal, m_configEntryOrdinal, aAdjoint, aJacobianWorkset, aReturnValue, m_cellColoring);
     }
 
 };
@@ -63,6 +63,11 @@ namespace lgr {
     AMGX_config_handle    _config;
     
     bool _haveInitialized = false;
+    bool _haveSetup = false; // a hierarchy exists for the uploaded sparsity pattern
+
+    // the sparsity pattern last uploaded to _matrix
+    typename Matrix::RowMapVector  _rowMap;
+    typename Matrix::OrdinalVector _columnIndices;
 
     Vector _x; // will want to copy here (from _lhs) in solve()...
 
@@ -376,6 +381,8 @@ namespace lgr {
       const void *data = A.entries().data();
       const void *diag_data = nullptr; // no exterior diagonal
       AMGX_matrix_upload_all(_matrix, N/BlockSize, nnz, BlockSize, BlockSize, row_ptrs, col_indices, data, diag_data);
+      _rowMap = A.rowMap();
+      _columnIndices = A.columnIndices();
       
       setRHS(b);
       setInitialGuess(x);
@@ -390,7 +397,38 @@ namespace lgr {
     
     void initializeSolver() // TODO: add mechanism for setting options
     {
-      initializePreconditioner();
+      if (_haveSetup)
+      {
+        // same sparsity pattern: AMGX keeps the hierarchy's structure
+        Kokkos::Profiling::pushRegion("AMGX_solver_resetup");
+        AMGX_solver_resetup(_solver, _matrix);
+        Kokkos::Profiling::popRegion();
+      }
+      else
+      {
+        initializePreconditioner();
+        _haveSetup = true;
+      }
+    }
+
+    bool hasSameGraph(const Matrix & aMatrix) const
+    {
+      auto tRowMap = aMatrix.rowMap();
+      auto tColumnIndices = aMatrix.columnIndices();
+      if (tRowMap.size() != _rowMap.size()) return false;
+      if (tColumnIndices.size() != _columnIndices.size()) return false;
+      if (tRowMap.data() == _rowMap.data() && tColumnIndices.data() == _columnIndices.data()) return true;
+      auto tOldRowMap = _rowMap;
+      auto tOldColumnIndices = _columnIndices;
+      int tNumDifferences = 0;
+      Kokkos::parallel_reduce("AmgX row map comparison", Kokkos::RangePolicy<int>(0, tRowMap.size()), KOKKOS_LAMBDA(int i, int & aSum) {
+        if (tRowMap(i) != tOldRowMap(i)) ++aSum;
+      }, tNumDifferences);
+      if (tNumDifferences != 0) return false;
+      Kokkos::parallel_reduce("AmgX column index comparison", Kokkos::RangePolicy<int>(0, tColumnIndices.size()), KOKKOS_LAMBDA(int i, int & aSum) {
+        if (tColumnIndices(i) != tOldColumnIndices(i)) ++aSum;
+      }, tNumDifferences);
+      return tNumDifferences == 0;
     }
     
     void setInitialGuess(const Vector x)
@@ -412,6 +450,13 @@ namespace lgr {
       AMGX_vector_upload(_rhs, b.size()/BlockSize, BlockSize, b.data());
     }
 
+    // solve() writes to x from now on; its current values are the initial guess
+    void setSolution(Vector x)
+    {
+      _x = x;
+      setInitialGuess(x);
+    }
+
     void setMatrix(const Matrix & aMatrix, const Ordinal & aNumEquations)
     {
         const void *tData = aMatrix.entries().data();
@@ -419,7 +464,19 @@ namespace lgr {
         const int *tRowPtrs = aMatrix.rowMap().data();
         const int *tColIndices = aMatrix.columnIndices().data();
         const Ordinal tNumNonZeros = aMatrix.columnIndices().size();
-        AMGX_matrix_upload_all(_matrix, aNumEquations/BlockSize, tNumNonZeros, BlockSize, BlockSize, tRowPtrs, tColIndices, tData, tDiagData);
+        if (hasSameGraph(aMatrix))
+        {
+          // only the values changed; AMGX keeps the uploaded structure
+          AMGX_matrix_replace_coefficients(_matrix, aNumEquations/BlockSize, tNumNonZeros, tData, tDiagData);
+        }
+        else
+        {
+          AMGX_matrix_upload_all(_matrix, aNumEquations/BlockSize, tNumNonZeros, BlockSize, BlockSize, tRowPtrs, tColIndices, tData, tDiagData);
+          _rowMap = aMatrix.rowMap();
+          _columnIndices = aMatrix.columnIndices();
+          _haveSetup = false;
+        }
+        _haveInitialized = false; // the preconditioner must be rebuilt for the new values
     }
     
     void setTolerance(double tol)
@@ -451,6 +508,13 @@ namespace lgr {
       return solverErr;
     }
 
+    int getIterationsTaken()
+    {
+      int numIterations = 0;
+      AMGX_solver_get_iterations_number(_solver, &numIterations);
+      return numIterations;
+    }
+
     ~AmgXSparseLinearProblem()
     {
       AMGX_solver_destroy    (_solver);
@@ -6,6 +6,7 @@
 #include "MatrixIO.hpp"
 
 #include <sstream>
+#include <vector>
 
 using namespace lgr;
 using namespace std;
@@ -123,4 +124,91 @@ namespace {
       testFloatingEquality<Scalar, ScalarVector>(bExpected,b,tol,out,success);
     }
   }
+
+  // block sparsity of a 27-point stencil on an n x n x n grid of nodes, like the
+  // Jacobian of a hexahedral mesh with one block per node pair sharing an element
+  void gridGraph(int n, vector<SizeType> &rowMap, vector<Ordinal> &columnIndices)
+  {
+    rowMap.assign(1, 0);
+    columnIndices.clear();
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < n; j++)
+        for (int k = 0; k < n; k++)
+        {
+          for (int di = -1; di <= 1; di++)
+            for (int dj = -1; dj <= 1; dj++)
+              for (int dk = -1; dk <= 1; dk++)
+              {
+                int ci = i + di, cj = j + dj, ck = k + dk;
+                if (ci < 0 || cj < 0 || ck < 0 || ci >= n || cj >= n || ck >= n) continue;
+                columnIndices.push_back((ci * n + cj) * n + ck);
+              }
+          rowMap.push_back(columnIndices.size());
+        }
+  }
+
+  // the same matrix as the block matrix described by the arguments, stored point-wise
+  CrsMatrix pointCrsMatrix(const vector<SizeType> &blockRowMap, const vector<Ordinal> &blockColumnIndices,
+                           const vector<Scalar> &blockEntries, int blockSizeRow, int blockSizeCol)
+  {
+    vector<SizeType> rowMap(1, 0);
+    vector<Ordinal> columnIndices;
+    vector<Scalar> entries;
+    for (size_t blockRow = 0; blockRow + 1 < blockRowMap.size(); blockRow++)
+    {
+      for (int i = 0; i < blockSizeRow; i++)
+      {
+        for (auto entryIndex = blockRowMap[blockRow]; entryIndex < blockRowMap[blockRow + 1]; entryIndex++)
+        {
+          for (int j = 0; j < blockSizeCol; j++)
+          {
+            columnIndices.push_back(blockColumnIndices[entryIndex] * blockSizeCol + j);
+            entries.push_back(blockEntries[(entryIndex * blockSizeRow + i) * blockSizeCol + j]);
+          }
+        }
+        rowMap.push_back(columnIndices.size());
+      }
+    }
+    return CrsMatrix(toDevice<SizeType, SizeTypeVector>("rowMap", rowMap),
+                     toDevice<Ordinal, OrdinalVector>("columnIndices", columnIndices),
+                     toDevice<Scalar, ScalarVector>("entries", entries));
+  }
+
+  vector<Scalar> sampleBlockEntries(size_t numBlocks, int blockSizeRow, int blockSizeCol)
+  {
+    vector<Scalar> entries(numBlocks * blockSizeRow * blockSizeCol);
+    for (size_t i = 0; i < entries.size(); i++) entries[i] = Scalar(i % 11) - 5.0;
+    return entries;
+  }
+
+  TEUCHOS_UNIT_TEST( CrsMatrix, BlockMultiply )
+  {
+    // every specialized square block size, a larger one, and rectangular blocks,
+    // checked against the same matrix stored point-wise
+    vector<pair<int,int>> blockSizes = {{1,1},{2,2},{3,3},{4,4},{5,5},{6,6},{7,7},{3,2},{2,4}};
+    vector<SizeType> rowMap;
+    vector<Ordinal> columnIndices;
+    gridGraph(3, rowMap, columnIndices);
+    const int numBlocks = rowMap.size() - 1;
+
+    for (auto blockSize : blockSizes)
+    {
+      const int blockSizeRow = blockSize.first, blockSizeCol = blockSize.second;
+      auto entries = sampleBlockEntries(columnIndices.size(), blockSizeRow, blockSizeCol);
+      CrsMatrix A(toDevice<SizeType, SizeTypeVector>("rowMap", rowMap),
+                  toDevice<Ordinal, OrdinalVector>("columnIndices", columnIndices),
+                  toDevice<Scalar, ScalarVector>("entries", entries),
+                  blockSizeCol, blockSizeRow);
+      CrsMatrix pointA = pointCrsMatrix(rowMap, columnIndices, entries, blockSizeRow, blockSizeCol);
+
+      ScalarVector x = sampleLHS(numBlocks * blockSizeCol);
+      ScalarVector b("b", numBlocks * blockSizeRow);
+      ScalarVector bExpected("b expected", numBlocks * blockSizeRow);
+      A.Apply(x, b);
+      pointA.Apply(x, bExpected);
+
+      double tol = 1e-14;
+      testFloatingEquality<Scalar, ScalarVector>(bExpected, b, tol, out, success);
+    }
+  }
 } // namespace
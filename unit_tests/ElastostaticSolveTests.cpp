@@ -1608,3 +1608,303 @@ TEUCHOS_UNIT_TEST( ElastostaticSolve, ElastostaticSolve_BlockSolve3D )
                                 << gold_sol[i] << std::endl;
   }
 }
+
+
+/******************************************************************************/
+/*! Compare the matrix-free stiffness against the assembled block matrix.
+
+  Test setup:
+   1.  Create a box mesh in 3D, and one assembled and one matrix-free
+       ElastostaticSolve object with the same body load and x=0 face
+       constraints (nonzero in one direction, to exercise the lifting).
+   2.  Assemble both.
+
+  Tests:
+   1.  The matrix-free operator and the assembled matrix agree on a vector.
+   2.  The constrained right hand sides agree.
+   3.  The matrix-free diagonal blocks match those of the assembled matrix.
+   4.  Native CG solutions agree.  Solve times and the memory held by each
+       operator are reported.
+*/
+/******************************************************************************/
+namespace {
+
+template<int SpaceDim>
+Teuchos::RCP<ElastostaticSolve<SpaceDim>>
+setupElastostaticSolve(Teuchos::RCP<Omega_h::Mesh> meshOmegaH, Teuchos::RCP<lgr::Fields<SpaceDim>> fields, bool matrixFree,
+                       bool useBlockMatrix = true)
+{
+  Teuchos::ParameterList paramList;
+  Teuchos::RCP<Teuchos::ParameterList> modelParams =
+    Teuchos::getParametersFromXmlString(
+    "<ParameterList  name='Isotropic Linear Elastic'>                   \n"
+    "  <Parameter  name='Poissons Ratio' type='double' value='0.3'/>   \n"
+    "  <Parameter  name='Youngs Modulus' type='double' value='1.0e6'/> \n"
+    "</ParameterList>                                                   \n"
+   );
+  paramList.sublist("Material Model").set<Teuchos::ParameterList>("Isotropic Linear Elastic", *modelParams);
+  paramList.set<bool>("Use Block Matrix",useBlockMatrix);
+  paramList.set<bool>("Matrix Free",matrixFree);
+  paramList.sublist("Linear Solver").set<std::string>("Package","native");
+  auto solver = Teuchos::rcp(new ElastostaticSolve<SpaceDim>(paramList, fields, lgr::getCommMachine()));
+
+  solver->initialize();
+
+  Teuchos::RCP<Teuchos::ParameterList> params =
+    Teuchos::getParametersFromXmlString(
+    "<ParameterList  name='Body Loads'>                          \n"
+    "  <ParameterList  name='Gravity Force'>                     \n"
+    "    <Parameter  name='Function' type='string' value='1.0'/> \n"
+    "    <Parameter  name='Index'    type='int'    value='0'/>   \n"
+    "  </ParameterList>                                          \n"
+    "</ParameterList>                                            \n"
+   );
+  Plato::BodyLoads<SpaceDim> bl(*params);
+  bl.get(*meshOmegaH, solver->getRHS());
+
+  Omega_h::LOs x0_ordinals = PlatoUtestHelpers::getBoundaryNodes_x0(meshOmegaH);
+  Omega_h::Write<Omega_h::LO> bcOrdinals(SpaceDim*x0_ordinals.size());
+  Omega_h::Write<Plato::Scalar> bcValues(bcOrdinals.size());
+  Kokkos::parallel_for(Kokkos::RangePolicy<int>(0,x0_ordinals.size()), LAMBDA_EXPRESSION(int x0_ordinal)
+  {
+    auto offset = x0_ordinal * SpaceDim;
+    for (int iDim=0; iDim<SpaceDim; iDim++)
+    {
+      bcOrdinals[offset+iDim] = SpaceDim*x0_ordinals[x0_ordinal]+iDim;
+      bcValues  [offset+iDim] = (iDim == 1) ? 1.0e-7 : 0.0;
+    }
+  },"Dirichlet BC");
+  solver->setBC(bcOrdinals, bcValues);
+
+  solver->assemble();
+  return solver;
+}
+
+Plato::Scalar relativeDifference(Plato::ScalarVector aFirst, Plato::ScalarVector aSecond)
+{
+  Plato::Scalar difference = 0.0, norm = 0.0;
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<int>(0,aFirst.size()), LAMBDA_EXPRESSION(int i, Plato::Scalar & sum)
+  {
+    sum += (aFirst(i) - aSecond(i)) * (aFirst(i) - aSecond(i));
+  }, difference);
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<int>(0,aSecond.size()), LAMBDA_EXPRESSION(int i, Plato::Scalar & sum)
+  {
+    sum += aSecond(i) * aSecond(i);
+  }, norm);
+  return std::sqrt(difference / norm);
+}
+
+} // namespace
+
+TEUCHOS_UNIT_TEST( ElastostaticSolve, ElastostaticSolve_MatrixFree3D )
+{
+  const int spaceDim = 3;
+  using DefaultFields = lgr::Fields<spaceDim>;
+
+  const int meshWidth=8;
+  auto meshOmegaH = PlatoUtestHelpers::getBoxMesh(spaceDim, meshWidth);
+
+  auto mesh = PlatoUtestHelpers::createFEMesh<spaceDim>(meshOmegaH);
+  Teuchos::ParameterList fieldParams;
+  auto fields = Teuchos::rcp(new DefaultFields(mesh, fieldParams));
+
+  auto assembled  = setupElastostaticSolve<spaceDim>(meshOmegaH, fields, /*matrixFree=*/false);
+  auto matrixFree = setupElastostaticSolve<spaceDim>(meshOmegaH, fields, /*matrixFree=*/true);
+  TEST_ASSERT(matrixFree->isMatrixFree());
+
+  // Test 1: operator application
+  const int numDofs = assembled->getLHS().size();
+  Plato::ScalarVector x("x", numDofs), yAssembled("y assembled", numDofs), yMatrixFree("y matrix free", numDofs);
+  Kokkos::parallel_for(Kokkos::RangePolicy<int>(0,numDofs), LAMBDA_EXPRESSION(int dofOrdinal)
+  {
+    x(dofOrdinal) = Plato::Scalar(dofOrdinal % 11) / 5.0 - 1.0;
+  },"sample vector");
+  assembled->getMatrix().Apply(x, yAssembled);
+  matrixFree->getMatrixFreeStiffness()->applyConstrained(x, yMatrixFree);
+  TEST_COMPARE(relativeDifference(yMatrixFree, yAssembled), <, 1.0e-13);
+
+  // Test 2: constrained right hand side
+  TEST_COMPARE(relativeDifference(matrixFree->getRHS(), assembled->getRHS()), <, 1.0e-13);
+
+  // Test 3: diagonal blocks
+  {
+    auto rowMapHost = Kokkos::create_mirror_view(assembled->getMatrix().rowMap());
+    Kokkos::deep_copy(rowMapHost, assembled->getMatrix().rowMap());
+    auto columnsHost = Kokkos::create_mirror_view(assembled->getMatrix().columnIndices());
+    Kokkos::deep_copy(columnsHost, assembled->getMatrix().columnIndices());
+    auto entriesHost = Kokkos::create_mirror_view(assembled->getMatrix().entries());
+    Kokkos::deep_copy(entriesHost, assembled->getMatrix().entries());
+    auto diagonalHost = Kokkos::create_mirror_view(matrixFree->getMatrix().entries());
+    Kokkos::deep_copy(diagonalHost, matrixFree->getMatrix().entries());
+
+    const int blockEntries = spaceDim*spaceDim;
+    const int numNodes = rowMapHost.size() - 1;
+    for(int node=0; node<numNodes; node++)
+    {
+      for(int entry=rowMapHost(node); entry<rowMapHost(node+1); entry++)
+      {
+        if(columnsHost(entry) != node) continue;
+        for(int i=0; i<blockEntries; i++)
+        {
+          TEST_ASSERT(std::abs(diagonalHost(node*blockEntries+i) - entriesHost(entry*blockEntries+i))
+                      <= 1.0e-12 * std::abs(entriesHost(entry*blockEntries+i)) + 1.0e-9);
+        }
+      }
+    }
+  }
+
+  // Test 4: solve
+  Kokkos::Timer timer;
+  auto assembledSolver = assembled->getDefaultSolver(/*cgTol=*/1e-12, /*cgMaxIters=*/10000);
+  TEST_EQUALITY(0, assembledSolver->solve());
+  Kokkos::fence();
+  const double assembledTime = timer.seconds();
+
+  timer.reset();
+  auto matrixFreeSolver = matrixFree->getDefaultSolver(/*cgTol=*/1e-12, /*cgMaxIters=*/10000);
+  TEST_EQUALITY(0, matrixFreeSolver->solve());
+  Kokkos::fence();
+  const double matrixFreeTime = timer.seconds();
+
+  TEST_COMPARE(relativeDifference(matrixFree->getLHS(), assembled->getLHS()), <, 1.0e-9);
+
+  auto matrix = assembled->getMatrix();
+  const size_t assembledBytes = matrix.entries().size()*sizeof(Plato::Scalar)
+                              + matrix.columnIndices().size()*sizeof(Plato::OrdinalType)
+                              + matrix.rowMap().size()*sizeof(Plato::RowMapEntryType);
+  const size_t matrixFreeBytes = matrixFree->getMatrixFreeStiffness()->storageBytes()
+                               + matrixFree->getMatrix().entries().size()*sizeof(Plato::Scalar);
+  out << meshWidth << "^3 box, block Jacobi CG: assembled " << assembledBytes << " bytes, "
+      << assembledTime << " s; matrix free " << matrixFreeBytes << " bytes, "
+      << matrixFreeTime << " s\n";
+  TEST_COMPARE(matrixFreeBytes, <, assembledBytes);
+}
+
+
+
+/******************************************************************************/
+/*! Benchmark the CrsMatrix apply on an elastostatic Jacobian.
+  
+  Test setup:
+   1.  Create a box mesh in 3D and assemble the constrained Jacobian of
+       setupElastostaticSolve twice: with 3x3 blocks and point-wise.
+   2.  Apply the block Jacobian with the runtime block size kernel that
+       NativeSparseLinearProblem used before, and with ApplyCrsMatrix.
+   3.  Apply the point-wise Jacobian with the original point kernel of
+       ApplyCrsMatrix, and with ApplyCrsMatrix.
+
+  Tests:
+   1.  All four products agree.  GFLOP/s and GB/s of each kernel are reported.
+*/
+/******************************************************************************/
+namespace {
+
+// ApplyCrsMatrix before it dispatched on the block size
+void applyOriginalPointKernel(const Plato::CrsMatrixType & aMatrix, Plato::ScalarVector x, Plato::ScalarVector b)
+{
+  auto rowMap = aMatrix.rowMap();
+  auto numRows = rowMap.size() - 1;
+  auto columnIndices = aMatrix.columnIndices();
+  auto entries = aMatrix.entries();
+  Kokkos::parallel_for(Kokkos::RangePolicy<int>(0, numRows), LAMBDA_EXPRESSION(int rowOrdinal)
+  {
+    auto   rowStart = rowMap(rowOrdinal);
+    auto   rowEnd = rowMap(rowOrdinal + 1);
+    Plato::Scalar sum = 0.0;
+    for (auto entryIndex = rowStart; entryIndex < rowEnd; entryIndex++) {
+      auto columnIndex = columnIndices(entryIndex);
+      sum += entries(entryIndex) * x(columnIndex);
+    }
+    b(rowOrdinal) = sum;
+  }, "original point apply");
+}
+
+// NativeSparseLinearProblem::applyMatrix before it called Apply()
+void applyOriginalBlockKernel(const Plato::CrsMatrixType & aMatrix, Plato::ScalarVector x, Plato::ScalarVector y)
+{
+  auto rowMap = aMatrix.rowMap();
+  auto columnIndices = aMatrix.columnIndices();
+  auto entries = aMatrix.entries();
+  const int blockSize = aMatrix.blockSizeRow();
+  const int numBlockRows = int(rowMap.size()) - 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<int>(0, numBlockRows), LAMBDA_EXPRESSION(int blockRow)
+  {
+    const int rowStart = rowMap(blockRow);
+    const int rowEnd = rowMap(blockRow + 1);
+    for (int i = 0; i < blockSize; i++) {
+      Plato::Scalar sum = 0.0;
+      for (int entryIndex = rowStart; entryIndex < rowEnd; entryIndex++) {
+        const int column = columnIndices(entryIndex);
+        const int blockOffset = (entryIndex * blockSize + i) * blockSize;
+        for (int j = 0; j < blockSize; j++) {
+          sum += entries(blockOffset + j) * x(column * blockSize + j);
+        }
+      }
+      y(blockRow * blockSize + i) = sum;
+    }
+  }, "original block apply");
+}
+
+void applyCurrentKernel(const Plato::CrsMatrixType & aMatrix, Plato::ScalarVector x, Plato::ScalarVector b)
+{
+  lgr::ApplyCrsMatrix(aMatrix, x, b);
+}
+
+} // namespace
+
+TEUCHOS_UNIT_TEST( ElastostaticSolve, ElastostaticSolve_ApplyBenchmark3D )
+{
+  const int spaceDim = 3;
+  using DefaultFields = lgr::Fields<spaceDim>;
+
+  const int meshWidth=20;
+  auto meshOmegaH = PlatoUtestHelpers::getBoxMesh(spaceDim, meshWidth);
+
+  auto mesh = PlatoUtestHelpers::createFEMesh<spaceDim>(meshOmegaH);
+  Teuchos::ParameterList fieldParams;
+  auto fields = Teuchos::rcp(new DefaultFields(mesh, fieldParams));
+
+  auto blocked   = setupElastostaticSolve<spaceDim>(meshOmegaH, fields, /*matrixFree=*/false, /*useBlockMatrix=*/true);
+  auto pointwise = setupElastostaticSolve<spaceDim>(meshOmegaH, fields, /*matrixFree=*/false, /*useBlockMatrix=*/false);
+  TEST_EQUALITY(blocked->getMatrix().blockSizeRow(), spaceDim);
+  TEST_EQUALITY(pointwise->getMatrix().blockSizeRow(), 1);
+
+  const int numDofs = blocked->getLHS().size();
+  Plato::ScalarVector x("x", numDofs), yExpected("y expected", numDofs);
+  Kokkos::parallel_for(Kokkos::RangePolicy<int>(0,numDofs), LAMBDA_EXPRESSION(int dofOrdinal)
+  {
+    x(dofOrdinal) = Plato::Scalar(dofOrdinal % 11) / 5.0 - 1.0;
+  },"sample vector");
+  applyOriginalPointKernel(pointwise->getMatrix(), x, yExpected);
+
+  typedef void (*ApplyKernel)(const Plato::CrsMatrixType &, Plato::ScalarVector, Plato::ScalarVector);
+  struct Case { const char* name; Plato::CrsMatrixType matrix; ApplyKernel apply; };
+  std::vector<Case> cases = {
+    {"point-wise, original point kernel",   pointwise->getMatrix(), applyOriginalPointKernel},
+    {"point-wise, ApplyCrsMatrix",          pointwise->getMatrix(), applyCurrentKernel},
+    {"3x3 blocks, original block kernel",   blocked->getMatrix(),   applyOriginalBlockKernel},
+    {"3x3 blocks, ApplyCrsMatrix",          blocked->getMatrix(),   applyCurrentKernel}
+  };
+
+  const int numApplies = 20;
+  for (auto& benchmark : cases)
+  {
+    auto const& matrix = benchmark.matrix;
+    // both storages hold the same values, the point-wise one with more indices
+    const double flops = 2.0 * matrix.entries().size();
+    // bytes moved at best: matrix values and indices once, x and y once
+    const double bytes = sizeof(Plato::Scalar) * (matrix.entries().size() + 2.0 * numDofs)
+                       + sizeof(Plato::OrdinalType) * matrix.columnIndices().size()
+                       + sizeof(Plato::RowMapEntryType) * matrix.rowMap().size();
+    Plato::ScalarVector y("y", numDofs);
+    benchmark.apply(matrix, x, y);
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    for (int apply = 0; apply < numApplies; apply++) benchmark.apply(matrix, x, y);
+    Kokkos::fence();
+    const double seconds = timer.seconds() / numApplies;
+    out << meshWidth << "^3 box Jacobian, " << benchmark.name << ": "
+        << flops / seconds * 1e-9 << " GFLOP/s, " << bytes / seconds * 1e-9 << " GB/s\n";
+    TEST_COMPARE(relativeDifference(y, yExpected), <, 1.0e-13);
+  }
+}
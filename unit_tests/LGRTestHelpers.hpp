@@ -11,6 +11,8 @@
 #include "CrsMatrix.hpp"
 #include <ParallelComm.hpp>
 
+#include <vector>
+
 namespace lgr
 {
   void initializeCommMachine(int *argc , char ***argv);
@@ -57,6 +59,17 @@ namespace lgr
     }, "copy to Kokkos View");
   }
 
+  // copies host values into a new device view
+  template <class T, class ViewType>
+  ViewType toDevice(const char* name, const std::vector<T> &from)
+  {
+    ViewType to(name, from.size());
+    auto toHost = Kokkos::create_mirror_view(to);
+    for (size_t i = 0; i < from.size(); i++) toHost(i) = from[i];
+    Kokkos::deep_copy(to, toHost);
+    return to;
+  }
+
   bool fileExists(const std::string &filePath);
   
   template<class Scalar, class ViewType>
@@ -178,7 +178,8 @@ namespace {
   }
   
   template<int spaceDim>
-  LowRmPotentialSolve<spaceDim> getLowRmPotentialSolveExample(Teuchos::RCP<Omega_h::Mesh> meshOmegaH)
+  LowRmPotentialSolve<spaceDim> getLowRmPotentialSolveExample(Teuchos::RCP<Omega_h::Mesh> meshOmegaH,
+                                                              Teuchos::ParameterList const &solveParams = Teuchos::ParameterList())
   {
     using DefaultFields = Fields<spaceDim>;
     
@@ -228,7 +229,7 @@ namespace {
     Teuchos::ParameterList emptyParamList;
     auto fields = Teuchos::rcp( new DefaultFields(mesh, emptyParamList) );
     
-    LowRmPotentialSolve<spaceDim> solver(emptyParamList, fields, getCommMachine());
+    LowRmPotentialSolve<spaceDim> solver(solveParams, fields, getCommMachine());
     solver.setConductivity(solver.getConstantConductivity(1.0));
     
     return solver;
@@ -680,6 +681,45 @@ namespace {
   //testEquality<Ordinal> (expectedColumnIndices, solver.getMatrix()->columnIndices(), out, success);
   }
   
+  TEUCHOS_UNIT_TEST( LowRmPotentialSolve, EntryOrdinals_3D )
+  {
+    // every (cell, iNode, jNode) entry of the table should point into row cells2nodes(iNode) at column cells2nodes(jNode)
+    const int spaceDim = 3;
+    const int meshWidth = 3;
+    const int nodesPerCell = spaceDim + 1;
+    auto mesh = getBoxMesh(spaceDim, meshWidth);
+    
+    LowRmPotentialSolve<spaceDim> solver = getLowRmPotentialSolveExample<spaceDim>(mesh);
+    
+    solver.initialize();
+    
+    auto entryOrdinals = solver.getEntryOrdinals();
+    const int numCells = mesh->nelems();
+    TEST_EQUALITY(numCells, int(entryOrdinals.extent(0)));
+    TEST_EQUALITY(nodesPerCell, int(entryOrdinals.extent(1)));
+    TEST_EQUALITY(nodesPerCell, int(entryOrdinals.extent(2)));
+    
+    auto rowMap = solver.getMatrix().rowMap();
+    auto columnIndices = solver.getMatrix().columnIndices();
+    auto cells2nodes = mesh->ask_elem_verts();
+    int numMismatched = 0;
+    Kokkos::parallel_reduce(numCells, LAMBDA_EXPRESSION(int cellOrdinal, int &mismatched)
+    {
+      for (int iNode=0; iNode<nodesPerCell; iNode++)
+      {
+        auto row = cells2nodes[cellOrdinal * nodesPerCell + iNode];
+        for (int jNode=0; jNode<nodesPerCell; jNode++)
+        {
+          auto column = cells2nodes[cellOrdinal * nodesPerCell + jNode];
+          auto entryOrdinal = entryOrdinals(cellOrdinal, iNode, jNode);
+          bool inRow = (entryOrdinal >= rowMap(row)) && (entryOrdinal < rowMap(row + 1));
+          if (!inRow || (columnIndices(entryOrdinal) != column)) mismatched++;
+        }
+      }
+    }, numMismatched);
+    TEST_EQUALITY(0, numMismatched);
+  }
+  
   TEUCHOS_UNIT_TEST( LowRmPotentialSolve, MFoldSymmetry_3D )
   {
     // in 1D, we think of slicing a 1D wire into m equal lengths.  We solve the problem on one such segment,
@@ -961,4 +1001,56 @@ namespace {
     double tol = 1e-15;
     testFloatingEquality(expectedRHS,rhs,tol,out,success);
   }
+
+  TEUCHOS_UNIT_TEST( LowRmPotentialSolve, ConductorRightHandSides_2D )
+  {
+    /*
+     Each conductor adds a right-hand side, and the native solver takes all of them together
+     with block CG.  Row 0 is the particular solve, assembled from forcing and boundary conditions
+     as usual.  The conductor rows are filled after assembly with the matrix applied to other exact
+     solutions, so that every row of the solution has a known answer.
+     */
+    const int spaceDim = 2;
+    int meshWidth = 4;
+    auto mesh = getBoxMesh(spaceDim, meshWidth);
+    auto exactSolutions = getExactPolynomialSolutions();
+    
+    const int numConductors = 2;
+    Teuchos::ParameterList solveParams;
+    solveParams.set("Number of Conductors", numConductors);
+    solveParams.sublist("Linear Solver").set("Package", std::string("native"));
+    solveParams.sublist("Linear Solver").set("Solver", std::string("CG"));
+    LowRmPotentialSolve<spaceDim> solver = getLowRmPotentialSolveExample<spaceDim>(mesh, solveParams);
+    
+    auto particularExpr = exactSolutions[0].exactSolution;
+    solver.setForcingFunctionExpr(exactSolutions[0].forcingFunction, exactSolutions[0].forcingQuadratureDegree);
+    solver.setBC(particularExpr, getBoundaryNodes(mesh));
+    solver.initialize();
+    solver.assemble();
+    
+    const int numSolves = numConductors + 1;
+    auto rhs = solver.getRHS();
+    TEST_EQUALITY(numSolves, int(rhs.extent(0)));
+    
+    int numNodes = mesh->nverts();
+    LowRmPotentialSolve<spaceDim>::ScalarMultiVector expectedSolution("expected solution",numSolves,numNodes);
+    auto coords = mesh->coords();
+    for (int solve = 0; solve < numSolves; solve++)
+    {
+      auto solnExpr = exactSolutions[solve].exactSolution;
+      LowRmPotentialSolve<spaceDim>::ScalarVector expected = Kokkos::subview(expectedSolution, solve, Kokkos::ALL());
+      evaluateNodalExpression(solnExpr, spaceDim, coords, expected);
+      if (solve > 0)
+      {
+        LowRmPotentialSolve<spaceDim>::ScalarVector b = Kokkos::subview(rhs, solve, Kokkos::ALL());
+        solver.getMatrix().Apply(expected, b);
+      }
+    }
+    
+    auto linearSolver = solver.getDefaultSolver(1e-14, 1000);
+    TEST_EQUALITY(0, linearSolver->solve());
+    
+    double tol = 1e-10;
+    testFloatingEquality(expectedSolution, solver.getLHS(), tol, out, success);
+  }
 } // namespace
@@ -0,0 +1,235 @@
+#include "Teuchos_UnitTestHarness.hpp"
+
+#include <NativeSparseLinearProblem.hpp>
+
+#include <Kokkos_Timer.hpp>
+
+#include <vector>
+
+#include "LGRTestHelpers.hpp"
+
+using namespace lgr;
+using namespace std;
+
+namespace {
+  typedef int                                  Ordinal;
+  typedef NativeSparseLinearProblem<Ordinal>   LinearProblem;
+  typedef CrsMatrix<Ordinal, int>              CrsMatrix;
+
+  typedef Kokkos::View<Ordinal*, MemSpace> OrdinalVector;
+  typedef Kokkos::View<Scalar*,  MemSpace> ScalarVector;
+  typedef LinearProblem::MultiVector       ScalarMultiVector;
+  typedef Kokkos::View<int*,     MemSpace> RowMapVector;
+
+  // block-tridiagonal matrix with the given diagonal and off-diagonal blocks
+  CrsMatrix blockTridiagonalMatrix(int numBlockRows, int blockSize,
+                                   const vector<Scalar> &diagonalBlock,
+                                   const vector<Scalar> &offDiagonalBlock)
+  {
+    vector<int> rowMap(1, 0);
+    vector<Ordinal> columnIndices;
+    vector<Scalar> entries;
+    for (int row = 0; row < numBlockRows; row++)
+    {
+      for (int column = row - 1; column <= row + 1; column++)
+      {
+        if (column < 0 || column >= numBlockRows) continue;
+        columnIndices.push_back(column);
+        auto &block = (column == row) ? diagonalBlock : offDiagonalBlock;
+        entries.insert(entries.end(), block.begin(), block.end());
+      }
+      rowMap.push_back(columnIndices.size());
+    }
+    return CrsMatrix(toDevice<int, RowMapVector>("rowMap", rowMap),
+                     toDevice<Ordinal, OrdinalVector>("columnIndices", columnIndices),
+                     toDevice<Scalar, ScalarVector>("entries", entries),
+                     blockSize, blockSize);
+  }
+
+  // 5-point Laplacian on an n x n grid with Dirichlet boundaries
+  CrsMatrix poissonMatrix(int n)
+  {
+    vector<int> rowMap(1, 0);
+    vector<Ordinal> columnIndices;
+    vector<Scalar> entries;
+    for (int i = 0; i < n; i++)
+    {
+      for (int j = 0; j < n; j++)
+      {
+        const int row = i * n + j;
+        const int neighbors[4][2] = {{i - 1, j}, {i, j - 1}, {i, j + 1}, {i + 1, j}};
+        for (int k = 0; k < 2; k++)
+        {
+          if (neighbors[k][0] < 0 || neighbors[k][1] < 0) continue;
+          columnIndices.push_back(neighbors[k][0] * n + neighbors[k][1]);
+          entries.push_back(-1.0);
+        }
+        columnIndices.push_back(row);
+        entries.push_back(4.0);
+        for (int k = 2; k < 4; k++)
+        {
+          if (neighbors[k][0] >= n || neighbors[k][1] >= n) continue;
+          columnIndices.push_back(neighbors[k][0] * n + neighbors[k][1]);
+          entries.push_back(-1.0);
+        }
+        rowMap.push_back(columnIndices.size());
+      }
+    }
+    return CrsMatrix(toDevice<int, RowMapVector>("rowMap", rowMap),
+                     toDevice<Ordinal, OrdinalVector>("columnIndices", columnIndices),
+                     toDevice<Scalar, ScalarVector>("entries", entries));
+  }
+
+  ScalarVector sampleLHS(int numRows)
+  {
+    ScalarVector x("x", numRows);
+    Kokkos::parallel_for("initialize sample LHS", numRows, LAMBDA_EXPRESSION(int row)
+                         {
+                           x(row) = Scalar(row % 7) / 2.0 - 1.0;
+                         });
+    return x;
+  }
+
+  // solves A x = A xExpected with every solver and preconditioner
+  void testAllSolvers(CrsMatrix A, int numRows, Teuchos::FancyOStream &out, bool &success)
+  {
+    ScalarVector xExpected = sampleLHS(numRows);
+    ScalarVector b("b", numRows);
+    {
+      ScalarVector x0("x0", numRows);
+      LinearProblem problem(A, x0, b);
+      problem.applyMatrix(xExpected, b);
+    }
+    for (auto solver : {"CG", "GMRES"})
+    {
+      for (auto preconditioner : {"None", "Jacobi", "Block Jacobi", "Chebyshev"})
+      {
+        Teuchos::ParameterList params;
+        params.set("Solver", string(solver));
+        params.set("Preconditioner", string(preconditioner));
+        params.set("Tolerance", 1e-12);
+        ScalarVector xActual("x", numRows);
+        LinearProblem problem(A, xActual, b, params);
+        int result = problem.solve();
+        out << solver << " with " << preconditioner << ": "
+            << problem.getIterationsTaken() << " iterations\n";
+        TEST_EQUALITY(0, result);
+        double tol = 1e-9;
+        testFloatingEquality(xExpected, xActual, tol, out, success);
+      }
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( NativeSolver, SolveSampleSystem )
+  {
+    const int numRows = 25;
+    CrsMatrix A = blockTridiagonalMatrix(numRows, 1, {2.0}, {1.0});
+    testAllSolvers(A, numRows, out, success);
+  }
+
+  TEUCHOS_UNIT_TEST( NativeSolver, SolveBlockSystem )
+  {
+    const int numBlockRows = 20;
+    const int blockSize = 3;
+    vector<Scalar> diagonalBlock = {6.0, 1.0, 0.5,
+                                    1.0, 5.0, 1.0,
+                                    0.5, 1.0, 4.0};
+    vector<Scalar> offDiagonalBlock = {-1.0, 0.0, 0.0,
+                                        0.0,-1.0, 0.0,
+                                        0.0, 0.0,-1.0};
+    CrsMatrix A = blockTridiagonalMatrix(numBlockRows, blockSize, diagonalBlock, offDiagonalBlock);
+    testAllSolvers(A, numBlockRows * blockSize, out, success);
+  }
+
+  TEUCHOS_UNIT_TEST( NativeSolver, PoissonBenchmark )
+  {
+    const int n = 64;
+    const int numRows = n * n;
+    CrsMatrix A = poissonMatrix(n);
+    ScalarVector b("b", numRows);
+    Kokkos::deep_copy(b, 1.0);
+    for (auto solver : {"CG", "GMRES"})
+    {
+      for (auto preconditioner : {"None", "Jacobi", "Chebyshev"})
+      {
+        Teuchos::ParameterList params;
+        params.set("Solver", string(solver));
+        params.set("Preconditioner", string(preconditioner));
+        params.set("Tolerance", 1e-8);
+        params.set("Maximum Iterations", 20000);
+        params.set("Krylov Dimension", 100);
+        ScalarVector x("x", numRows);
+        Kokkos::Timer timer;
+        LinearProblem problem(A, x, b, params);
+        int result = problem.solve();
+        Kokkos::fence();
+        out << n << "x" << n << " Poisson, " << solver << " with " << preconditioner << ": "
+            << problem.getIterationsTaken() << " iterations, " << timer.seconds() << " s\n";
+        TEST_EQUALITY(0, result);
+        TEST_COMPARE(problem.getResidual(), <=, 1e-8);
+      }
+    }
+  }
+
+  // several right-hand sides, one of them zero and two nearly parallel, solved
+  // together and one at a time
+  TEUCHOS_UNIT_TEST( NativeSolver, SolveMultipleRightHandSides )
+  {
+    const int n = 32;
+    const int numRows = n * n;
+    const int numRHS = 4;
+    CrsMatrix A = poissonMatrix(n);
+    ScalarMultiVector B("B", numRHS, numRows);
+    Kokkos::parallel_for("initialize sample RHSes", numRows, LAMBDA_EXPRESSION(int row)
+                         {
+                           B(0, row) = 1.0;
+                           B(1, row) = Scalar(row % 7) / 2.0 - 1.0;
+                           B(2, row) = 0.0;
+                           B(3, row) = 1.0 + 1e-3 * Scalar(row % 5);
+                         });
+    for (auto solver : {"CG", "GMRES"})
+    {
+      for (auto preconditioner : {"None", "Jacobi", "Chebyshev"})
+      {
+        Teuchos::ParameterList params;
+        params.set("Solver", string(solver));
+        params.set("Preconditioner", string(preconditioner));
+        params.set("Tolerance", 1e-10);
+        params.set("Maximum Iterations", 20000);
+
+        ScalarMultiVector X("X", numRHS, numRows);
+        Kokkos::Timer timer;
+        LinearProblem problem(A, X, B, params);
+        TEST_EQUALITY(numRHS, problem.getNumRightHandSides());
+        int result = problem.solve();
+        Kokkos::fence();
+        const double blockTime = timer.seconds();
+        TEST_EQUALITY(0, result);
+        TEST_COMPARE(problem.getResidual(), <=, 1e-10);
+
+        int separateIterations = 0;
+        timer.reset();
+        for (int column = 0; column < numRHS; column++)
+        {
+          ScalarVector b = Kokkos::subview(B, column, Kokkos::ALL());
+          ScalarVector x("x", numRows);
+          LinearProblem single(A, x, b, params);
+          TEST_EQUALITY(0, single.solve());
+          separateIterations += single.getIterationsTaken();
+          ScalarVector xBlock = Kokkos::subview(X, column, Kokkos::ALL());
+          double tol = 1e-7;
+          testFloatingEquality(x, xBlock, tol, out, success);
+        }
+        Kokkos::fence();
+        out << numRHS << " right-hand sides, " << solver << " with " << preconditioner << ": "
+            << problem.getIterationsTaken() << " iterations, " << blockTime << " s together; "
+            << separateIterations << " iterations, " << timer.seconds() << " s separately\n";
+        if (string(solver) == "CG")
+        {
+          // each block iteration is one pass over the matrix for the whole block
+          TEST_COMPARE(problem.getIterationsTaken(), <, separateIterations);
+        }
+      }
+    }
+  }
+} // namespace
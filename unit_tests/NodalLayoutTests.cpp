@@ -0,0 +1,135 @@
+//@HEADER
+// ************************************************************************
+//
+//                        LGR v. 1.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact  Glen A. Hansen (gahanse@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <iostream>
+
+#include "Teuchos_UnitTestHarness.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Timer.hpp>
+
+#include <FEMesh.hpp>
+#include <Fields.hpp>
+#include <LGRLambda.hpp>
+
+namespace {
+
+typedef lgr::Fields<3> FieldT;
+
+// times the velocity update of LagrangianStep::advanceTime on nodal
+// vectors stored with the given component order
+double timeVelocityUpdate(
+    lgr::GeomOrder order, int nnodes, int repeats,
+    FieldT::geom_state_array_type& velocity) {
+  lgr::FEMesh<3> mesh;
+  mesh.geom_order = order;
+  velocity = FieldT::geom_state_array_type(
+      "velocity", mesh.geomStateLayout(nnodes, FieldT::NumStates));
+  FieldT::geom_array_type acceleration(
+      "acceleration", mesh.geomLayout(nnodes));
+  const FieldT::geom_array_type cur_vel(FieldT::getGeomFromSA(velocity, 0));
+  const FieldT::geom_array_type next_vel(FieldT::getGeomFromSA(velocity, 1));
+  Kokkos::parallel_for(nnodes, LAMBDA_EXPRESSION(int inode) {
+    for (int slot = 0; slot < 3; ++slot) {
+      cur_vel(inode, slot) = inode + slot;
+      acceleration(inode, slot) = 1.0 + slot;
+    }
+  });
+  const lgr::Scalar dt = 1.0e-3;
+  auto updateVelocity = LAMBDA_EXPRESSION(int inode) {
+    for (int slot = 0; slot < 3; ++slot) {
+      next_vel(inode, slot) =
+          cur_vel(inode, slot) + dt * acceleration(inode, slot);
+    }
+  };
+  Kokkos::fence();
+  Kokkos::Timer timer;
+  for (int repeat = 0; repeat < repeats; ++repeat) {
+    Kokkos::parallel_for(nnodes, updateVelocity);
+  }
+  Kokkos::fence();
+  return timer.seconds();
+}
+
+TEUCHOS_UNIT_TEST(NodalLayout, Strides)
+{
+  const int nnodes = 5;
+  lgr::FEMesh<3> mesh;
+  FieldT::geom_state_array_type interleaved(
+      "interleaved", mesh.geomStateLayout(nnodes, FieldT::NumStates));
+  TEST_EQUALITY_CONST(interleaved.stride(1), 1);
+  TEST_EQUALITY_CONST(interleaved.stride(0), 3);
+  TEST_EQUALITY_CONST(interleaved.stride(2), 3 * nnodes);
+  mesh.geom_order = lgr::GeomOrder::Blocked;
+  FieldT::geom_state_array_type blocked(
+      "blocked", mesh.geomStateLayout(nnodes, FieldT::NumStates));
+  TEST_EQUALITY_CONST(blocked.stride(0), 1);
+  TEST_EQUALITY_CONST(blocked.stride(1), nnodes);
+  TEST_EQUALITY_CONST(blocked.stride(2), 3 * nnodes);
+}
+
+TEUCHOS_UNIT_TEST(NodalLayout, VelocityUpdateBenchmark)
+{
+  const int nnodes = 1 << 18;
+  const int repeats = 20;
+  FieldT::geom_state_array_type interleaved, blocked;
+  auto interleavedTime = timeVelocityUpdate(
+      lgr::GeomOrder::Interleaved, nnodes, repeats, interleaved);
+  auto blockedTime = timeVelocityUpdate(
+      lgr::GeomOrder::Blocked, nnodes, repeats, blocked);
+  out << "velocity update on " << nnodes << " nodes, " << repeats
+      << " repeats: interleaved " << interleavedTime << " s, blocked "
+      << blockedTime << " s\n";
+  auto interleavedHost = Kokkos::create_mirror_view(interleaved);
+  auto blockedHost = Kokkos::create_mirror_view(blocked);
+  Kokkos::deep_copy(interleavedHost, interleaved);
+  Kokkos::deep_copy(blockedHost, blocked);
+  int mismatches = 0;
+  for (int inode = 0; inode < nnodes; ++inode) {
+    for (int slot = 0; slot < 3; ++slot) {
+      if (interleavedHost(inode, slot, 1) != blockedHost(inode, slot, 1))
+        ++mismatches;
+    }
+  }
+  TEST_EQUALITY_CONST(mismatches, 0);
+}
+
+} // namespace
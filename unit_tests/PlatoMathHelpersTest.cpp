@@ -4,6 +4,8 @@
  *  Created on: July 11, 2018
  */
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 //#define COMPUTE_GOLD_
@@ -16,11 +18,15 @@
 #include "Teuchos_UnitTestHarness.hpp"
 
 #include "plato/PlatoMathHelpers.hpp"
+#include "plato/Thermal.hpp"
 #include "plato/Mechanics.hpp"
+#include "plato/CellColoring.hpp"
 #include "plato/ScalarFunction.hpp"
+#include "plato/StructuralDynamics.hpp"
 #include "plato/VectorFunction.hpp"
 
 #include <Omega_h_mesh.hpp>
+#include <Kokkos_Timer.hpp>
 
 namespace PlatoUnitTests
 {
@@ -279,4 +285,361 @@ TEUCHOS_UNIT_TEST(PlatoLGRUnitTests, PlatoMathHelpers_MatrixTimesVectorPlusVecto
   }
 }
 
+TEUCHOS_UNIT_TEST(PlatoLGRUnitTests, VectorFunction_CachedJacobianGraph)
+{
+  // create test mesh
+  //
+  constexpr int meshWidth=2;
+  constexpr int spaceDim=3;
+  auto mesh = PlatoUtestHelpers::getBoxMesh(spaceDim, meshWidth);
+
+  // create mesh based density and displacement
+  //
+  Plato::ScalarVector z("density", mesh->nverts());
+  Kokkos::deep_copy(z, 1.0);
+
+  auto stateSize = spaceDim*mesh->nverts();
+  Plato::ScalarVector u("state",stateSize);
+  auto u_host = Kokkos::create_mirror_view(u);
+  Plato::Scalar disp = 0.0, dval = 0.0001;
+  for( int i = 0; i<stateSize; i++) u_host(i) = (disp += dval);
+  Kokkos::deep_copy(u, u_host);
+
+  Teuchos::RCP<Teuchos::ParameterList> tParams =
+    Teuchos::getParametersFromXmlString(
+    "<ParameterList name='Plato Problem'>                                          \n"
+    "  <Parameter name='PDE Constraint' type='string' value='Elastostatics'/>      \n"
+    "  <ParameterList name='Elastostatics'>                                        \n"
+    "    <ParameterList name='Penalty Function'>                                   \n"
+    "      <Parameter name='Exponent' type='double' value='3.0'/>                  \n"
+    "      <Parameter name='Type' type='string' value='SIMP'/>                     \n"
+    "    </ParameterList>                                                          \n"
+    "  </ParameterList>                                                            \n"
+    "  <ParameterList name='Material Model'>                                       \n"
+    "    <ParameterList name='Isotropic Linear Elastic'>                           \n"
+    "      <Parameter name='Poissons Ratio' type='double' value='0.3'/>            \n"
+    "      <Parameter name='Youngs Modulus' type='double' value='1.0e6'/>          \n"
+    "    </ParameterList>                                                          \n"
+    "  </ParameterList>                                                            \n"
+    "</ParameterList>                                                              \n"
+  );
+
+  Plato::DataMap tDataMap;
+  Omega_h::MeshSets tMeshSets;
+  VectorFunction<::Plato::Mechanics<spaceDim>>
+    esVectorFunction(*mesh, tMeshSets, tDataMap, *tParams, tParams->get<std::string>("PDE Constraint"));
+
+  // the second assembly reuses the graph of the first, but not its values
+  //
+  auto jacobian_1 = esVectorFunction.gradient_u(u,z);
+  auto jacobian_2 = esVectorFunction.gradient_u(u,z);
+  TEST_EQUALITY(jacobian_1->rowMap().data(), jacobian_2->rowMap().data());
+  TEST_EQUALITY(jacobian_1->columnIndices().data(), jacobian_2->columnIndices().data());
+  TEST_INEQUALITY(jacobian_1->entries().data(), jacobian_2->entries().data());
+
+  // the cached entry ordinal table agrees with the searching functor
+  //
+  constexpr int numDofsPerCell = spaceDim*(spaceDim+1);
+  auto jacobian_gold = Plato::CreateBlockMatrix<Plato::CrsMatrixType, spaceDim, spaceDim>(mesh.get());
+  Plato::BlockMatrixEntryOrdinal<spaceDim, spaceDim, spaceDim> tEntryOrdinal(jacobian_gold, mesh.get());
+  Plato::BlockMatrixEntryOrdinalTable<spaceDim, spaceDim, spaceDim> tEntryOrdinalTable(jacobian_gold, mesh.get());
+  int tNumMismatches = 0;
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<>(0, mesh->nelems()), LAMBDA_EXPRESSION(const int & aCellOrdinal, int & aMismatches)
+  {
+    for(int i = 0; i < numDofsPerCell; i++)
+      for(int j = 0; j < numDofsPerCell; j++)
+        if(tEntryOrdinal(aCellOrdinal, i, j) != tEntryOrdinalTable(aCellOrdinal, i, j)) aMismatches++;
+  }, tNumMismatches);
+  TEST_EQUALITY(tNumMismatches, 0);
+
+  auto entries_1 = Kokkos::create_mirror_view(jacobian_1->entries());
+  Kokkos::deep_copy(entries_1, jacobian_1->entries());
+  auto entries_2 = Kokkos::create_mirror_view(jacobian_2->entries());
+  Kokkos::deep_copy(entries_2, jacobian_2->entries());
+  TEST_EQUALITY(entries_1.size(), jacobian_gold->entries().size());
+  for(unsigned int i = 0; i < entries_1.size(); i++)
+  {
+    TEST_ASSERT(std::abs(entries_1(i) - entries_2(i)) <= 1e-12 * std::abs(entries_1(i)));
+  }
+}
+
+TEUCHOS_UNIT_TEST(PlatoLGRUnitTests, VectorFunction_AdjointGradients)
+{
+  // create test mesh
+  //
+  constexpr int meshWidth=8;
+  constexpr int spaceDim=3;
+  auto mesh = PlatoUtestHelpers::getBoxMesh(spaceDim, meshWidth);
+
+  // create mesh based density, displacement and adjoint
+  //
+  Plato::ScalarVector z("density", mesh->nverts());
+  Kokkos::deep_copy(z, 0.8);
+
+  auto stateSize = spaceDim*mesh->nverts();
+  Plato::ScalarVector u("state",stateSize);
+  Plato::ScalarVector lambda("adjoint",stateSize);
+  auto u_host = Kokkos::create_mirror_view(u);
+  auto lambda_host = Kokkos::create_mirror_view(lambda);
+  Plato::Scalar disp = 0.0, dval = 0.0001;
+  for( int i = 0; i<stateSize; i++)
+  {
+    u_host(i) = (disp += dval);
+    lambda_host(i) = Plato::Scalar(i % 5) - 2.0;
+  }
+  Kokkos::deep_copy(u, u_host);
+  Kokkos::deep_copy(lambda, lambda_host);
+
+  Teuchos::RCP<Teuchos::ParameterList> tParams =
+    Teuchos::getParametersFromXmlString(
+    "<ParameterList name='Plato Problem'>                                          \n"
+    "  <Parameter name='PDE Constraint' type='string' value='Elastostatics'/>      \n"
+    "  <ParameterList name='Elastostatics'>                                        \n"
+    "    <ParameterList name='Penalty Function'>                                   \n"
+    "      <Parameter name='Exponent' type='double' value='3.0'/>                  \n"
+    "      <Parameter name='Type' type='string' value='SIMP'/>                     \n"
+    "    </ParameterList>                                                          \n"
+    "  </ParameterList>                                                            \n"
+    "  <ParameterList name='Material Model'>                                       \n"
+    "    <ParameterList name='Isotropic Linear Elastic'>                           \n"
+    "      <Parameter name='Poissons Ratio' type='double' value='0.3'/>            \n"
+    "      <Parameter name='Youngs Modulus' type='double' value='1.0e6'/>          \n"
+    "    </ParameterList>                                                          \n"
+    "  </ParameterList>                                                            \n"
+    "</ParameterList>                                                              \n"
+  );
+
+  Plato::DataMap tDataMap;
+  Omega_h::MeshSets tMeshSets;
+  VectorFunction<::Plato::Mechanics<spaceDim>>
+    esVectorFunction(*mesh, tMeshSets, tDataMap, *tParams, tParams->get<std::string>("PDE Constraint"));
+
+  // compare the matrix-free products with the assembled ones, and report the
+  // time of each and the matrix storage the matrix-free products avoid
+  //
+  auto compare = [&](const Plato::ScalarVector & aExpected, const Plato::ScalarVector & aActual)
+  {
+    auto tExpected = Kokkos::create_mirror_view(aExpected);
+    Kokkos::deep_copy(tExpected, aExpected);
+    auto tActual = Kokkos::create_mirror_view(aActual);
+    Kokkos::deep_copy(tActual, aActual);
+    TEST_EQUALITY(tExpected.size(), tActual.size());
+    for(unsigned int i = 0; i < tExpected.size(); i++)
+    {
+      TEST_ASSERT(std::abs(tExpected(i) - tActual(i)) <= 1e-10 * std::max(1.0, std::abs(tExpected(i))));
+    }
+  };
+  auto matrixBytes = [](const Teuchos::RCP<Plato::CrsMatrixType> & aMatrix)
+  {
+    return sizeof(Plato::Scalar) * aMatrix->entries().size()
+         + sizeof(Plato::OrdinalType) * aMatrix->columnIndices().size()
+         + sizeof(Plato::RowMapEntryType) * aMatrix->rowMap().size();
+  };
+
+  {
+    Plato::ScalarVector tAssembled("assembled dgdz", mesh->nverts());
+    Plato::ScalarVector tMatrixFree("matrix-free dgdz", mesh->nverts());
+    Kokkos::Timer tTimer;
+    auto dgdz = esVectorFunction.gradient_z(u,z);
+    Plato::MatrixTimesVectorPlusVector(dgdz, lambda, tAssembled);
+    Kokkos::fence();
+    auto tAssembledTime = tTimer.seconds();
+    tTimer.reset();
+    esVectorFunction.adjoint_gradient_z(u,z,lambda,tMatrixFree);
+    Kokkos::fence();
+    auto tMatrixFreeTime = tTimer.seconds();
+    out << "lambda^T dR/dz: assembled " << tAssembledTime << " s, matrix-free " << tMatrixFreeTime
+        << " s, " << matrixBytes(dgdz) << " matrix bytes avoided\n";
+    compare(tAssembled, tMatrixFree);
+  }
+
+  {
+    Plato::ScalarVector tAssembled("assembled dgdx", spaceDim*mesh->nverts());
+    Plato::ScalarVector tMatrixFree("matrix-free dgdx", spaceDim*mesh->nverts());
+    Kokkos::Timer tTimer;
+    auto dgdx = esVectorFunction.gradient_x(u,z);
+    Plato::MatrixTimesVectorPlusVector(dgdx, lambda, tAssembled);
+    Kokkos::fence();
+    auto tAssembledTime = tTimer.seconds();
+    tTimer.reset();
+    esVectorFunction.adjoint_gradient_x(u,z,lambda,tMatrixFree);
+    Kokkos::fence();
+    auto tMatrixFreeTime = tTimer.seconds();
+    out << "lambda^T dR/dx: assembled " << tAssembledTime << " s, matrix-free " << tMatrixFreeTime
+        << " s, " << matrixBytes(dgdx) << " matrix bytes avoided\n";
+    compare(tAssembled, tMatrixFree);
+  }
+}
+
+TEUCHOS_UNIT_TEST(PlatoLGRUnitTests, CellColoring)
+{
+  constexpr int meshWidth=4;
+  constexpr int spaceDim=3;
+  auto mesh = PlatoUtestHelpers::getBoxMesh(spaceDim, meshWidth);
+
+  Plato::CellColoring tColoring(*mesh);
+  TEST_COMPARE(tColoring.numColors(), >, 0);
+  TEST_EQUALITY(tColoring.colorOffsets().back(), mesh->nelems());
+
+  // every cell appears once, and no two cells of one color share a node
+  //
+  auto tCells = Kokkos::create_mirror_view(tColoring.cells());
+  Kokkos::deep_copy(tCells, tColoring.cells());
+  Omega_h::HostRead<Omega_h::LO> tCells2Nodes(mesh->ask_elem_verts());
+  constexpr int numNodesPerCell = spaceDim+1;
+  std::vector<int> tCellCount(mesh->nelems(), 0);
+  std::vector<int> tNodeColor(mesh->nverts(), -1);
+  int tNumConflicts = 0;
+  for(int tColor = 0; tColor < tColoring.numColors(); tColor++)
+  {
+    for(int i = tColoring.colorOffsets()[tColor]; i < tColoring.colorOffsets()[tColor+1]; i++)
+    {
+      tCellCount[tCells(i)]++;
+      for(int tNode = 0; tNode < numNodesPerCell; tNode++)
+      {
+        auto tNodeOrdinal = tCells2Nodes[tCells(i)*numNodesPerCell + tNode];
+        if(tNodeColor[tNodeOrdinal] == tColor) tNumConflicts++;
+        tNodeColor[tNodeOrdinal] = tColor;
+      }
+    }
+  }
+  TEST_EQUALITY(tNumConflicts, 0);
+  TEST_EQUALITY(*std::min_element(tCellCount.begin(), tCellCount.end()), 1);
+  TEST_EQUALITY(*std::max_element(tCellCount.begin(), tCellCount.end()), 1);
+}
+
+/******************************************************************************/
+/*! Assembles the residual and Jacobian of aProblemType with atomic updates and
+    with cell coloring, checks that they agree, and reports the time of each.
+*/
+/******************************************************************************/
+template<typename PhysicsT>
+void testColoredAssembly(Omega_h::Mesh& aMesh,
+                         Teuchos::ParameterList& aParams,
+                         Plato::Scalar aFrequency,
+                         Teuchos::FancyOStream &out,
+                         bool &success)
+{
+  Plato::DataMap tDataMap;
+  Omega_h::MeshSets tMeshSets;
+  auto tProblemType = aParams.get<std::string>("PDE Constraint");
+  VectorFunction<PhysicsT> tVectorFunction(aMesh, tMeshSets, tDataMap, aParams, tProblemType);
+
+  Plato::ScalarVector z("density", aMesh.nverts());
+  Kokkos::deep_copy(z, 0.8);
+  Plato::ScalarVector u("state", tVectorFunction.size());
+  Kokkos::parallel_for(Kokkos::RangePolicy<>(0, u.size()), LAMBDA_EXPRESSION(const int & aOrdinal)
+  {
+    u(aOrdinal) = 1e-4 * (aOrdinal % 11);
+  });
+
+  constexpr int numRepeats = 5;
+  Plato::ScalarVector tResidual[2];
+  Teuchos::RCP<Plato::CrsMatrixType> tJacobian[2];
+  double tResidualTime[2], tJacobianTime[2];
+  for(int tColored = 0; tColored < 2; tColored++)
+  {
+    tVectorFunction.setColoredAssembly(aMesh, tColored == 1);
+    Kokkos::Timer tTimer;
+    for(int i = 0; i < numRepeats; i++) tResidual[tColored] = tVectorFunction.value(u, z, aFrequency);
+    Kokkos::fence();
+    tResidualTime[tColored] = tTimer.seconds() / numRepeats;
+    tTimer.reset();
+    for(int i = 0; i < numRepeats; i++) tJacobian[tColored] = tVectorFunction.gradient_u(u, z, aFrequency);
+    Kokkos::fence();
+    tJacobianTime[tColored] = tTimer.seconds() / numRepeats;
+  }
+  out << tProblemType << ": residual " << tResidualTime[0] << " s atomic, " << tResidualTime[1]
+      << " s colored; Jacobian " << tJacobianTime[0] << " s atomic, " << tJacobianTime[1] << " s colored\n";
+
+  auto compare = [&](const Plato::ScalarVector & aExpected, const Plato::ScalarVector & aActual)
+  {
+    auto tExpected = Kokkos::create_mirror_view(aExpected);
+    Kokkos::deep_copy(tExpected, aExpected);
+    auto tActual = Kokkos::create_mirror_view(aActual);
+    Kokkos::deep_copy(tActual, aActual);
+    TEST_EQUALITY(tExpected.size(), tActual.size());
+    Plato::Scalar tMax = 0.0;
+    for(unsigned int i = 0; i < tExpected.size(); i++) tMax = std::max(tMax, std::abs(tExpected(i)));
+    for(unsigned int i = 0; i < tExpected.size(); i++)
+    {
+      TEST_ASSERT(std::abs(tExpected(i) - tActual(i)) <= 1e-12 * tMax);
+    }
+  };
+  compare(tResidual[0], tResidual[1]);
+  compare(tJacobian[0]->entries(), tJacobian[1]->entries());
+}
+
+TEUCHOS_UNIT_TEST(PlatoLGRUnitTests, VectorFunction_ColoredAssembly)
+{
+  constexpr int meshWidth=10;
+  constexpr int spaceDim=3;
+  auto mesh = PlatoUtestHelpers::getBoxMesh(spaceDim, meshWidth);
+
+  Teuchos::RCP<Teuchos::ParameterList> tElastostatics =
+    Teuchos::getParametersFromXmlString(
+    "<ParameterList name='Plato Problem'>                                          \n"
+    "  <Parameter name='PDE Constraint' type='string' value='Elastostatics'/>      \n"
+    "  <ParameterList name='Elastostatics'>                                        \n"
+    "    <ParameterList name='Penalty Function'>                                   \n"
+    "      <Parameter name='Exponent' type='double' value='3.0'/>                  \n"
+    "      <Parameter name='Type' type='string' value='SIMP'/>                     \n"
+    "    </ParameterList>                                                          \n"
+    "  </ParameterList>                                                            \n"
+    "  <ParameterList name='Material Model'>                                       \n"
+    "    <ParameterList name='Isotropic Linear Elastic'>                           \n"
+    "      <Parameter name='Poissons Ratio' type='double' value='0.3'/>            \n"
+    "      <Parameter name='Youngs Modulus' type='double' value='1.0e6'/>          \n"
+    "    </ParameterList>                                                          \n"
+    "  </ParameterList>                                                            \n"
+    "</ParameterList>                                                              \n"
+  );
+  testColoredAssembly<::Plato::Mechanics<spaceDim>>(*mesh, *tElastostatics, 0.0, out, success);
+
+  Teuchos::RCP<Teuchos::ParameterList> tThermostatics =
+    Teuchos::getParametersFromXmlString(
+    "<ParameterList name='Plato Problem'>                                          \n"
+    "  <Parameter name='PDE Constraint' type='string' value='Thermostatics'/>      \n"
+    "  <ParameterList name='Thermostatics'>                                        \n"
+    "    <ParameterList name='Penalty Function'>                                   \n"
+    "      <Parameter name='Exponent' type='double' value='3.0'/>                  \n"
+    "      <Parameter name='Type' type='string' value='SIMP'/>                     \n"
+    "    </ParameterList>                                                          \n"
+    "  </ParameterList>                                                            \n"
+    "  <ParameterList name='Material Model'>                                       \n"
+    "    <ParameterList name='Isotropic Linear Thermal'>                           \n"
+    "      <Parameter name='Conductivity Coefficient' type='double' value='100.'/> \n"
+    "    </ParameterList>                                                          \n"
+    "  </ParameterList>                                                            \n"
+    "</ParameterList>                                                              \n"
+  );
+  testColoredAssembly<::Plato::Thermal<spaceDim>>(*mesh, *tThermostatics, 0.0, out, success);
+
+  Teuchos::RCP<Teuchos::ParameterList> tStructuralDynamics =
+    Teuchos::getParametersFromXmlString(
+    "<ParameterList name='Plato Problem'>                                             \n"
+    "  <Parameter name='PDE Constraint' type='string' value='StructuralDynamics'/>    \n"
+    "  <ParameterList name='StructuralDynamics'>                                      \n"
+    "    <ParameterList name='Penalty Function'>                                      \n"
+    "      <Parameter name='Exponent' type='double' value='3.0'/>                     \n"
+    "      <Parameter name='Type' type='string' value='SIMP'/>                        \n"
+    "    </ParameterList>                                                             \n"
+    "  </ParameterList>                                                               \n"
+    "  <ParameterList name='Frequency Steps'>                                         \n"
+    "    <Parameter name='Values' type='Array(double)' value='{10.0}'/>               \n"
+    "  </ParameterList>                                                               \n"
+    "  <ParameterList name='Material Model'>                                          \n"
+    "    <Parameter name='Density' type='double' value='1000'/>                       \n"
+    "    <Parameter name='Mass Proportional Damping' type='double' value='2.5e-5'/>   \n"
+    "    <Parameter name='Stiffness Proportional Damping' type='double' value='2.3e-5'/>\n"
+    "    <ParameterList name='Isotropic Linear Elastic'>                              \n"
+    "      <Parameter name='Poissons Ratio' type='double' value='0.3'/>               \n"
+    "      <Parameter name='Youngs Modulus' type='double' value='1.0e9'/>             \n"
+    "    </ParameterList>                                                             \n"
+    "  </ParameterList>                                                               \n"
+    "</ParameterList>                                                                 \n"
+  );
+  testColoredAssembly<::Plato::StructuralDynamics<spaceDim>>(*mesh, *tStructuralDynamics, 10.0, out, success);
+}
+
 } // namespace PlatoUnitTests
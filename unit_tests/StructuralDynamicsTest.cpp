@@ -4,8 +4,10 @@
  *  Created on: Mar 2, 2018
  **/
 
+#include <cmath>
 #include <memory>
 #include <cstdlib>
+#include <algorithm>
 
 #include <iostream>
 #include <fstream>
@@ -1698,4 +1700,234 @@ TEUCHOS_UNIT_TEST(PlatoLGRUnitTests, AdjointStructuralDynamicsSolve)
     auto tSolution = tProblem.solution(tControl);
 }
 
+TEUCHOS_UNIT_TEST(PlatoLGRUnitTests, StructuralDynamicsFrequencySweep)
+{
+    // CREATE 2D-MESH
+    Omega_h::LO aNx = 4;
+    Omega_h::LO aNy = 4;
+    Omega_h::Real aX = 1;
+    Omega_h::Real aY = 1;
+    std::shared_ptr<Omega_h::Mesh> tMesh = PlatoUtestHelpers::build_2d_box_mesh(aX, aY, aNx, aNy);
+
+    // PROBLEM INPUTS
+    const Plato::Scalar tDensity = 1000;
+    const Plato::Scalar tPoissonRatio = 0.3;
+    const Plato::Scalar tYoungsModulus = 1e9;
+    const Plato::Scalar tMassPropDamping = 0.000025;
+    const Plato::Scalar tStiffPropDamping = 0.000023;
+
+    // ALLOCATE STRUCTURAL DYNAMICS RESIDUAL
+    Plato::DataMap tDataMap;
+    Omega_h::MeshSets tMeshSets;
+    const Plato::OrdinalType tSpaceDim = 2;
+    using ResidualT = typename Plato::Evaluation<Plato::StructuralDynamics<tSpaceDim>>::Residual;
+    using JacobianU = typename Plato::Evaluation<Plato::StructuralDynamics<tSpaceDim>>::Jacobian;
+    std::shared_ptr<Plato::StructuralDynamicsResidual<ResidualT, SIMP, Plato::HyperbolicTangentProjection>> tResidual;
+    tResidual = std::make_shared<Plato::StructuralDynamicsResidual<ResidualT, SIMP, Plato::HyperbolicTangentProjection>>(*tMesh, tMeshSets, tDataMap);
+    tResidual->setMaterialDensity(tDensity);
+    tResidual->setMassPropDamping(tMassPropDamping);
+    tResidual->setStiffPropDamping(tStiffPropDamping);
+    tResidual->setIsotropicLinearElasticMaterial(tYoungsModulus, tPoissonRatio);
+
+    std::shared_ptr<Plato::StructuralDynamicsResidual<JacobianU, SIMP, Plato::HyperbolicTangentProjection>> tJacobianState;
+    tJacobianState = std::make_shared<Plato::StructuralDynamicsResidual<JacobianU, SIMP, Plato::HyperbolicTangentProjection>>(*tMesh, tMeshSets, tDataMap);
+    tJacobianState->setMaterialDensity(tDensity);
+    tJacobianState->setMassPropDamping(tMassPropDamping);
+    tJacobianState->setStiffPropDamping(tStiffPropDamping);
+    tJacobianState->setIsotropicLinearElasticMaterial(tYoungsModulus, tPoissonRatio);
+
+    // ALLOCATE VECTOR FUNCTION
+    std::shared_ptr<VectorFunction<Plato::StructuralDynamics<tSpaceDim>>> tVectorFunction =
+        std::make_shared<VectorFunction<Plato::StructuralDynamics<tSpaceDim>>>(*tMesh, tDataMap);
+    tVectorFunction->allocateResidual(tResidual, tJacobianState);
+
+    // ALLOCATE STRUCTURAL DYNAMICS PROBLEM
+    Plato::StructuralDynamicsProblem<Plato::StructuralDynamics<tSpaceDim>> tProblem(*tMesh, tVectorFunction);
+
+    // SET DIRICHLET BOUNDARY CONDITIONS
+    Plato::Scalar tValue = 0;
+    auto tNumDofsPerNode = 2*tSpaceDim;
+    Omega_h::LOs tCoordsX0 = PlatoUtestHelpers::get_2D_boundary_nodes_x0(*tMesh);
+    auto tNumDirichletDofs = tNumDofsPerNode*tCoordsX0.size();
+    Plato::ScalarVector tDirichletValues("DirichletValues", tNumDirichletDofs);
+    Plato::LocalOrdinalVector tDirichletDofs("DirichletDofs", tNumDirichletDofs);
+    PlatoUtestHelpers::set_dirichlet_boundary_conditions(tNumDofsPerNode, tValue, tCoordsX0, tDirichletDofs, tDirichletValues);
+    tProblem.setEssentialBoundaryConditions(tDirichletDofs, tDirichletValues);
+
+    // SET FREQUENCIES
+    std::vector<Plato::Scalar> tFreq = { 5, 5.5, 6, 6.5, 7 };
+    tProblem.setFrequencyArray(tFreq);
+
+    // SET EXTERNAL FORCE
+    auto tNumDofs = tVectorFunction->size();
+    Plato::ScalarVector tPointLoad("PointLoad", tNumDofs);
+    Plato::ScalarMultiVector tValues("Values", 2, tSpaceDim);
+    auto tHostValues = Kokkos::create_mirror(tValues);
+    tHostValues(0,0) = 0;    tHostValues(1,0) = 0;
+    tHostValues(0,1) = -1e5; tHostValues(1,1) = -1e5;
+    Kokkos::deep_copy(tValues, tHostValues);
+    auto tTopOrdinalIndex = 0;
+    auto tNodeOrdinalsX1 = PlatoUtestHelpers::get_2D_boundary_nodes_x1(*tMesh);
+    PlatoUtestHelpers::set_point_load(tTopOrdinalIndex, tNodeOrdinalsX1, tValues, tPointLoad);
+    tProblem.setExternalForce(tPointLoad);
+
+    // SWEEP WITH AND WITHOUT WARM STARTS: SAME SOLUTIONS, ITERATIONS REPORTED PER FREQUENCY
+    auto tNumVerts = tMesh->nverts();
+    Plato::ScalarVector tControl("Control", tNumVerts);
+    Kokkos::deep_copy(tControl, static_cast<Plato::Scalar>(1));
+    tProblem.setMaxNumIterationsAmgX(2000);
+
+    tProblem.setWarmStart(false);
+    tProblem.solution(tControl);
+    auto tColdSolution = Kokkos::create_mirror(tProblem.getState());
+    Kokkos::deep_copy(tColdSolution, tProblem.getState());
+    auto tColdIterations = tProblem.getFrequencyIterations();
+
+    tProblem.setWarmStart(true);
+    tProblem.solution(tControl);
+    auto tWarmSolution = Kokkos::create_mirror(tProblem.getState());
+    Kokkos::deep_copy(tWarmSolution, tProblem.getState());
+    auto tWarmIterations = tProblem.getFrequencyIterations();
+
+    TEST_EQUALITY(tColdIterations.size(), tFreq.size());
+    TEST_EQUALITY(tWarmIterations.size(), tFreq.size());
+    for(size_t tIndex = 0; tIndex < tFreq.size(); tIndex++)
+    {
+        out << "frequency " << tFreq[tIndex] << ": " << tColdIterations[tIndex] << " iterations from zero, "
+            << tWarmIterations[tIndex] << " warm started\n";
+        TEST_COMPARE(tWarmIterations[tIndex], >, 0);
+    }
+
+    Plato::Scalar tMaxValue = 0;
+    for(size_t tIndex = 0; tIndex < tColdSolution.extent(1); tIndex++)
+    {
+        tMaxValue = std::max(tMaxValue, std::abs(tColdSolution(0, tIndex)));
+    }
+    TEST_COMPARE(tMaxValue, >, 0.0);
+    for(size_t tFreqIndex = 0; tFreqIndex < tColdSolution.extent(0); tFreqIndex++)
+    {
+        for(size_t tIndex = 0; tIndex < tColdSolution.extent(1); tIndex++)
+        {
+            TEST_ASSERT(std::abs(tColdSolution(tFreqIndex, tIndex) - tWarmSolution(tFreqIndex, tIndex)) <= 1e-6 * tMaxValue);
+        }
+    }
+}
+
+TEUCHOS_UNIT_TEST(PlatoLGRUnitTests, StructuralDynamicsReducedOrderSweep)
+{
+    // CREATE 2D-MESH
+    Omega_h::LO aNx = 4;
+    Omega_h::LO aNy = 4;
+    Omega_h::Real aX = 1;
+    Omega_h::Real aY = 1;
+    std::shared_ptr<Omega_h::Mesh> tMesh = PlatoUtestHelpers::build_2d_box_mesh(aX, aY, aNx, aNy);
+
+    // PROBLEM INPUTS
+    const Plato::Scalar tDensity = 1000;
+    const Plato::Scalar tPoissonRatio = 0.3;
+    const Plato::Scalar tYoungsModulus = 1e9;
+    const Plato::Scalar tMassPropDamping = 0.000025;
+    const Plato::Scalar tStiffPropDamping = 0.000023;
+
+    // ALLOCATE STRUCTURAL DYNAMICS RESIDUAL
+    Plato::DataMap tDataMap;
+    Omega_h::MeshSets tMeshSets;
+    const Plato::OrdinalType tSpaceDim = 2;
+    using ResidualT = typename Plato::Evaluation<Plato::StructuralDynamics<tSpaceDim>>::Residual;
+    using JacobianU = typename Plato::Evaluation<Plato::StructuralDynamics<tSpaceDim>>::Jacobian;
+    std::shared_ptr<Plato::StructuralDynamicsResidual<ResidualT, SIMP, Plato::HyperbolicTangentProjection>> tResidual;
+    tResidual = std::make_shared<Plato::StructuralDynamicsResidual<ResidualT, SIMP, Plato::HyperbolicTangentProjection>>(*tMesh, tMeshSets, tDataMap);
+    tResidual->setMaterialDensity(tDensity);
+    tResidual->setMassPropDamping(tMassPropDamping);
+    tResidual->setStiffPropDamping(tStiffPropDamping);
+    tResidual->setIsotropicLinearElasticMaterial(tYoungsModulus, tPoissonRatio);
+
+    std::shared_ptr<Plato::StructuralDynamicsResidual<JacobianU, SIMP, Plato::HyperbolicTangentProjection>> tJacobianState;
+    tJacobianState = std::make_shared<Plato::StructuralDynamicsResidual<JacobianU, SIMP, Plato::HyperbolicTangentProjection>>(*tMesh, tMeshSets, tDataMap);
+    tJacobianState->setMaterialDensity(tDensity);
+    tJacobianState->setMassPropDamping(tMassPropDamping);
+    tJacobianState->setStiffPropDamping(tStiffPropDamping);
+    tJacobianState->setIsotropicLinearElasticMaterial(tYoungsModulus, tPoissonRatio);
+
+    // ALLOCATE VECTOR FUNCTION
+    std::shared_ptr<VectorFunction<Plato::StructuralDynamics<tSpaceDim>>> tVectorFunction =
+        std::make_shared<VectorFunction<Plato::StructuralDynamics<tSpaceDim>>>(*tMesh, tDataMap);
+    tVectorFunction->allocateResidual(tResidual, tJacobianState);
+
+    // ALLOCATE STRUCTURAL DYNAMICS PROBLEM
+    Plato::StructuralDynamicsProblem<Plato::StructuralDynamics<tSpaceDim>> tProblem(*tMesh, tVectorFunction);
+
+    // SET DIRICHLET BOUNDARY CONDITIONS
+    Plato::Scalar tValue = 0;
+    auto tNumDofsPerNode = 2*tSpaceDim;
+    Omega_h::LOs tCoordsX0 = PlatoUtestHelpers::get_2D_boundary_nodes_x0(*tMesh);
+    auto tNumDirichletDofs = tNumDofsPerNode*tCoordsX0.size();
+    Plato::ScalarVector tDirichletValues("DirichletValues", tNumDirichletDofs);
+    Plato::LocalOrdinalVector tDirichletDofs("DirichletDofs", tNumDirichletDofs);
+    PlatoUtestHelpers::set_dirichlet_boundary_conditions(tNumDofsPerNode, tValue, tCoordsX0, tDirichletDofs, tDirichletValues);
+    tProblem.setEssentialBoundaryConditions(tDirichletDofs, tDirichletValues);
+
+    // SET FREQUENCIES
+    std::vector<Plato::Scalar> tFreq;
+    for(Plato::OrdinalType tIndex = 0; tIndex < 21; tIndex++)
+    {
+        tFreq.push_back(5 + 2.5 * tIndex);
+    }
+    tProblem.setFrequencyArray(tFreq);
+
+    // SET EXTERNAL FORCE
+    auto tNumDofs = tVectorFunction->size();
+    Plato::ScalarVector tPointLoad("PointLoad", tNumDofs);
+    Plato::ScalarMultiVector tValues("Values", 2, tSpaceDim);
+    auto tHostValues = Kokkos::create_mirror(tValues);
+    tHostValues(0,0) = 0;    tHostValues(1,0) = 0;
+    tHostValues(0,1) = -1e5; tHostValues(1,1) = -1e5;
+    Kokkos::deep_copy(tValues, tHostValues);
+    auto tTopOrdinalIndex = 0;
+    auto tNodeOrdinalsX1 = PlatoUtestHelpers::get_2D_boundary_nodes_x1(*tMesh);
+    PlatoUtestHelpers::set_point_load(tTopOrdinalIndex, tNodeOrdinalsX1, tValues, tPointLoad);
+    tProblem.setExternalForce(tPointLoad);
+
+    // FULL ORDER SWEEP
+    auto tNumVerts = tMesh->nverts();
+    Plato::ScalarVector tControl("Control", tNumVerts);
+    Kokkos::deep_copy(tControl, static_cast<Plato::Scalar>(1));
+    tProblem.setMaxNumIterationsAmgX(2000);
+    tProblem.solution(tControl);
+    auto tFullSolution = Kokkos::create_mirror(tProblem.getState());
+    Kokkos::deep_copy(tFullSolution, tProblem.getState());
+
+    // REDUCED ORDER SWEEP: FEWER FULL SOLVES, SAME SOLUTIONS
+    Teuchos::ParameterList tReducedOrderParams;
+    tReducedOrderParams.set<int>("Initial Samples", 3);
+    tReducedOrderParams.set<double>("Error Tolerance", 1e-8);
+    tProblem.setReducedOrder(true, tReducedOrderParams);
+    tProblem.solution(tControl);
+    auto tReducedSolution = Kokkos::create_mirror(tProblem.getState());
+    Kokkos::deep_copy(tReducedSolution, tProblem.getState());
+
+    const auto & tReducedSweep = tProblem.getReducedStateSweep();
+    out << tFreq.size() << " frequencies: " << tReducedSweep.getNumFullOrderSolves() << " full order solves, "
+        << tReducedSweep.getBasisSize() << " basis vectors\n";
+    TEST_COMPARE(tReducedSweep.getNumFullOrderSolves(), <, static_cast<Plato::OrdinalType>(tFreq.size()));
+    for(auto tIndicator : tReducedSweep.getErrorIndicators())
+    {
+        TEST_COMPARE(tIndicator, <=, 1e-8);
+    }
+
+    Plato::Scalar tMaxValue = 0;
+    for(size_t tIndex = 0; tIndex < tFullSolution.extent(1); tIndex++)
+    {
+        tMaxValue = std::max(tMaxValue, std::abs(tFullSolution(0, tIndex)));
+    }
+    TEST_COMPARE(tMaxValue, >, 0.0);
+    for(size_t tFreqIndex = 0; tFreqIndex < tFullSolution.extent(0); tFreqIndex++)
+    {
+        for(size_t tIndex = 0; tIndex < tFullSolution.extent(1); tIndex++)
+        {
+            TEST_ASSERT(std::abs(tFullSolution(tFreqIndex, tIndex) - tReducedSolution(tFreqIndex, tIndex)) <= 1e-5 * tMaxValue);
+        }
+    }
+}
+
 } //namespace PlatoUnitTests
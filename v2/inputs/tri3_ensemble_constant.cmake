@@ -0,0 +1,36 @@
+# checks the files written by tri3_ensemble_constant.yaml:
+# one results row per member and a history in each member's directory
+
+function(check_lines file_name)
+  if (NOT EXISTS "${file_name}")
+    message(FATAL_ERROR "${file_name} was not written")
+  endif()
+  file(STRINGS "${file_name}" lines)
+  list(LENGTH lines nlines)
+  list(LENGTH ARGN nexpected)
+  if (NOT nlines EQUAL nexpected)
+    message(FATAL_ERROR "${file_name} has ${nlines} lines instead of ${nexpected}")
+  endif()
+  set(i 0)
+  foreach (pattern IN LISTS ARGN)
+    list(GET lines ${i} line)
+    if (NOT line MATCHES "${pattern}")
+      message(FATAL_ERROR "line ${i} of ${file_name} is \"${line}\", expected \"${pattern}\"")
+    endif()
+    math(EXPR i "${i} + 1")
+  endforeach()
+endfunction()
+
+# the velocity never changes, so its error is zero up to round-off
+set(zero "(0\\.0+e\\+00|[0-9]\\.[0-9]+e-(1[1-9]|[2-9][0-9]|[1-9][0-9][0-9]))")
+
+check_lines(tri3_ensemble_constant.csv
+  "^member, time, velocity error$"
+  "^slow, 1\\.0+e\\+00, ${zero}$"
+  "^fast, 5\\.0+e-01, ${zero}$")
+check_lines(slow/history.csv
+  "^time, velocity error$"
+  "^0\\.0+e\\+00, " "^2\\.50+e-01, " "^5\\.0+e-01, " "^7\\.50+e-01, " "^1\\.0+e\\+00, ")
+check_lines(fast/history.csv
+  "^time, velocity error$"
+  "^0\\.0+e\\+00, " "^2\\.50+e-01, " "^5\\.0+e-01, ")
@@ -0,0 +1,30 @@
+# runs tri3_mesh_cache.yaml with an empty cache, which prepares the mesh
+# and stores it, then again, which has to read the stored mesh.
+# both runs must write the same history.
+
+function(run_lgr expect_cached)
+  execute_process(COMMAND "${LGR}" "${INPUT}"
+    RESULT_VARIABLE result OUTPUT_VARIABLE output ERROR_VARIABLE output)
+  message("${output}")
+  if (NOT result EQUAL 0)
+    message(FATAL_ERROR "lgr failed with ${result}")
+  endif()
+  if (output MATCHES "read prepared mesh from")
+    set(cached TRUE)
+  else()
+    set(cached FALSE)
+  endif()
+  if (NOT cached STREQUAL expect_cached)
+    message(FATAL_ERROR "expected reading the cached mesh to be ${expect_cached}")
+  endif()
+endfunction()
+
+file(REMOVE_RECURSE lgr_mesh_cache)
+run_lgr(FALSE)
+file(RENAME tri3_mesh_cache.csv tri3_mesh_cache_fresh.csv)
+run_lgr(TRUE)
+execute_process(COMMAND "${CMAKE_COMMAND}" -E compare_files
+  tri3_mesh_cache_fresh.csv tri3_mesh_cache.csv RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "the run on the cached mesh wrote a different history")
+endif()
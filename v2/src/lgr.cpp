@@ -1,4 +1,5 @@
 #include <lgr_run.hpp>
+#include <lgr_ensemble.hpp>
 #include <Omega_h_library.hpp>
 #include <Omega_h_cmdline.hpp>
 #include <Omega_h_teuchos.hpp>
@@ -15,5 +16,9 @@ int main(int argc, char** argv) {
   auto comm_teuchos = Omega_h::make_teuchos_comm(world);
   auto params = Teuchos::ParameterList{};
   Omega_h::update_parameters_from_file(config_path, &params, *comm_teuchos);
-  lgr::run(world, params);
+  if (params.isSublist("ensemble")) {
+    lgr::run_ensemble(world, params);
+  } else {
+    lgr::run(world, params);
+  }
 }
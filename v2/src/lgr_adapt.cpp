@@ -3,6 +3,8 @@
 #include <lgr_for.hpp>
 #include <Omega_h_stack.hpp>
 #include <Omega_h_metric.hpp>
+#include <Omega_h_mark.hpp>
+#include <Omega_h_array_ops.hpp>
 
 namespace lgr {
 
@@ -13,6 +15,14 @@ Adapter::Adapter(Simulation& sim_in)
 void Adapter::setup(Teuchos::ParameterList& pl) {
   should_adapt = pl.isSublist("adapt");
   if (should_adapt) {
+    if (sim.disc.has_edge_nodes()) {
+      Omega_h_fail("mesh adaptation can't remap edge nodes of %s elements\n",
+          sim.elem_name.c_str());
+    }
+    if (!sim.disc.is_simplex_) {
+      Omega_h_fail("mesh adaptation only supports simplices, not %s elements\n",
+          sim.elem_name.c_str());
+    }
     opts = decltype(opts)(&sim.disc.mesh);
     auto& adapt_pl = pl.sublist("adapt");
     opts.min_quality_desired =
@@ -28,6 +38,11 @@ void Adapter::setup(Teuchos::ParameterList& pl) {
     opts.verbosity = Omega_h::EACH_REBUILD;
     this->gradation_rate = adapt_pl.get<double>("gradation rate", 1.0);
     should_coarsen_with_expansion = adapt_pl.get<bool>("coarsen with expansion", false);
+    should_localize = adapt_pl.isSublist("localized");
+    if (should_localize) {
+      auto& localized_pl = adapt_pl.sublist("localized");
+      localized_layers = localized_pl.get<int>("layers", 2);
+    }
   }
 #define LGR_EXPL_INST(Elem) \
   if (sim.elem_name == Elem::name()) { \
@@ -52,6 +67,8 @@ bool Adapter::adapt() {
     metric = Omega_h::limit_metric_gradation(&sim.disc.mesh, metric, this->gradation_rate);
     sim.disc.mesh.add_tag(0, "metric", 1, metric);
   }
+  if (should_localize && !localize_metric()) return false;
+  before_remap(sim);
   remap->before_adapt();
   sim.fields.forget_disc();
   sim.subsets.forget_disc();
@@ -80,4 +97,50 @@ void Adapter::coarsen_metric_with_expansion() {
   sim.disc.mesh.add_tag(0, "metric", 1, read(new_metric));
 }
 
+// restricts adaptation to a cavity around the bad elements:
+// elements of poor quality or with overly long edges are marked,
+// the marking is grown by (localized_layers) layers of vertex-adjacent
+// elements (the same expansion Flooder::flood_once uses), and every
+// vertex outside the closure of that region gets its implied metric.
+// that metric only describes the mesh as it is, so it asks for
+// no change where the mesh is already reasonably uniform. it does not
+// lock anything: an edge outside the cavity whose length in the implied
+// metric is still outside the desired range can be adapted as well.
+// entities that survive are carried over by the "same entity" path of
+// the remap untouched.
+// returns false if no element needs adaptation.
+bool Adapter::localize_metric() {
+  OMEGA_H_TIME_FUNCTION;
+  auto& mesh = sim.disc.mesh;
+  auto const dim = mesh.dim();
+  auto const qualities = mesh.ask_qualities();
+  auto const lengths = mesh.ask_lengths();
+  auto const elems_are_bad = each_lt(qualities, opts.min_quality_desired);
+  auto const edges_are_long = each_gt(lengths, trigger_length_ratio);
+  auto elems_in_cavity = lor_each(elems_are_bad,
+      mark_up(&mesh, Omega_h::EDGE, dim, edges_are_long));
+  if (get_max(mesh.comm(), elems_in_cavity) != Omega_h::Byte(1)) return false;
+  for (int layer = 0; layer < localized_layers; ++layer) {
+    auto const adj_verts = mark_down(&mesh, dim, Omega_h::VERT, elems_in_cavity);
+    elems_in_cavity = mark_up(&mesh, Omega_h::VERT, dim, adj_verts);
+  }
+  auto const verts_in_cavity = mark_down(&mesh, dim, Omega_h::VERT, elems_in_cavity);
+  auto const metric_tag = mesh.get_tag<double>(Omega_h::VERT, "metric");
+  OMEGA_H_CHECK(metric_tag->ncomps() == 1);
+  auto const old_metric = metric_tag->array();
+  auto const implied_metric = get_implied_isos(&mesh);
+  auto const nverts = mesh.nverts();
+  auto const new_metric = Omega_h::Write<double>(nverts);
+  auto functor = OMEGA_H_LAMBDA(int vert) {
+    if (verts_in_cavity[vert]) {
+      new_metric[vert] = old_metric[vert];
+    } else {
+      new_metric[vert] = implied_metric[vert];
+    }
+  };
+  parallel_for("metric localization kernel", nverts, std::move(functor));
+  mesh.add_tag(Omega_h::VERT, "metric", 1, read(new_metric));
+  return true;
+}
+
 }
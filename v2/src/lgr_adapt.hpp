@@ -18,10 +18,13 @@ struct Adapter {
   double minimum_length;
   double gradation_rate;
   bool should_coarsen_with_expansion;
+  bool should_localize;
+  int localized_layers;
   Adapter(Simulation& sim);
   void setup(Teuchos::ParameterList& pl);
   bool adapt();
   void coarsen_metric_with_expansion();
+  bool localize_metric();
 };
 
 }
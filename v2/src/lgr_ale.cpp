@@ -0,0 +1,367 @@
+#include <lgr_ale.hpp>
+#include <lgr_simulation.hpp>
+#include <lgr_hydro.hpp>
+#include <lgr_scope.hpp>
+#include <lgr_for.hpp>
+#include <Omega_h_map.hpp>
+#include <Omega_h_array_ops.hpp>
+
+namespace lgr {
+
+Ale::Ale(Simulation& sim_in)
+  :sim(sim_in)
+  ,enabled(false)
+  ,step_interval(1)
+  ,smoothing_iterations(1)
+  ,smoothing_weight(0.5)
+  ,max_backtracks(4)
+{
+}
+
+void Ale::setup(Teuchos::ParameterList& pl) {
+  enabled = pl.isSublist("ALE");
+  if (!enabled) return;
+  auto& ale_pl = pl.sublist("ALE");
+  step_interval = ale_pl.get<int>("step interval", 10);
+  smoothing_iterations = ale_pl.get<int>("smoothing iterations", 1);
+  smoothing_weight = ale_pl.get<double>("smoothing weight", 0.5);
+  max_backtracks = ale_pl.get<int>("max backtracks", 4);
+  if (!sim.disc.is_simplex_ || sim.disc.has_edge_nodes() ||
+      sim.disc.points_per_ent(ELEMS) != 1) {
+    Omega_h_fail("ALE advection needs linear simplices with one point per element, not %s\n",
+        sim.elem_name.c_str());
+  }
+  // face fluxes are only computed between elements on the same rank,
+  // so partition boundaries would lose mass, momentum and energy
+  if (sim.comm->size() > 1) {
+    Omega_h_fail("ALE advection is not conservative across partitions, run it on one rank (not %d)\n",
+        sim.comm->size());
+  }
+}
+
+bool Ale::is_due() {
+  // step 0 is the initial state, there is no motion to smooth yet
+  return enabled && step_interval > 0 && sim.step > 0 &&
+      (sim.step % step_interval) == 0;
+}
+
+// Jacobi sweeps of Laplacian smoothing.
+// only nodes classified on the interior of the domain move, so the
+// boundary and any interfaces between materials stay where they are
+static Omega_h::Reals smooth_interior_nodes(Simulation& sim, Omega_h::Reals old_x) {
+  auto& mesh = sim.disc.mesh;
+  auto const dim = mesh.dim();
+  auto const verts_to_verts = mesh.ask_star(0);
+  auto const class_dims = mesh.get_array<Omega_h::I8>(0, "class_dim");
+  auto const weight = sim.ale.smoothing_weight;
+  Omega_h::Reals x = old_x;
+  for (int iteration = 0; iteration < sim.ale.smoothing_iterations; ++iteration) {
+    auto const new_x = Omega_h::Write<double>(x.size());
+    auto functor = OMEGA_H_LAMBDA(int vert) {
+      auto const begin = verts_to_verts.a2ab[vert];
+      auto const end = verts_to_verts.a2ab[vert + 1];
+      bool const is_interior = (class_dims[vert] == dim) && (end > begin);
+      for (int comp = 0; comp < dim; ++comp) {
+        auto const own = x[vert * dim + comp];
+        if (!is_interior) {
+          new_x[vert * dim + comp] = own;
+          continue;
+        }
+        double average = 0.0;
+        for (auto vert_vert = begin; vert_vert < end; ++vert_vert) {
+          average += x[verts_to_verts.ab2b[vert_vert] * dim + comp];
+        }
+        average /= (end - begin);
+        new_x[vert * dim + comp] = (1.0 - weight) * own + weight * average;
+      }
+    };
+    parallel_for("ALE smoothing kernel", mesh.nverts(), std::move(functor));
+    x = mesh.sync_array(0, Omega_h::read(new_x), dim);
+  }
+  return x;
+}
+
+template <class Elem>
+static double min_volume(Simulation& sim, Omega_h::Reals x) {
+  auto const elems_to_nodes = sim.elems_to_nodes();
+  auto const volumes = Omega_h::Write<double>(sim.elems());
+  auto functor = OMEGA_H_LAMBDA(int elem) {
+    auto const elem_nodes = getnodes<Elem>(elems_to_nodes, elem);
+    auto const shape = Elem::shape(getvecs<Elem>(x, elem_nodes));
+    volumes[elem] = shape.weights[0];
+  };
+  parallel_for("ALE volume kernel", sim.elems(), std::move(functor));
+  return Omega_h::get_min(sim.comm, Omega_h::read(volumes));
+}
+
+// the area vector of a face integrated over its linear motion from old to new
+// vertex positions, so that its dot product with the mean vertex displacement
+// is exactly the volume swept by the face
+OMEGA_H_INLINE Vector<1> swept_area_vector(Matrix<1, 1>, Matrix<1, 1>) {
+  return Vector<1>({1.0});
+}
+
+OMEGA_H_INLINE Vector<2> swept_area_vector(Matrix<2, 2> old_x, Matrix<2, 2> new_x) {
+  auto const old_edge = old_x[1] - old_x[0];
+  auto const new_edge = new_x[1] - new_x[0];
+  return Omega_h::perp((old_edge + new_edge) / 2.0);
+}
+
+OMEGA_H_INLINE Vector<3> swept_area_vector(Matrix<3, 3> old_x, Matrix<3, 3> new_x) {
+  auto const a = old_x[1] - old_x[0];
+  auto const b = old_x[2] - old_x[0];
+  auto const da = (new_x[1] - new_x[0]) - a;
+  auto const db = (new_x[2] - new_x[0]) - b;
+  return (1.0 / 2.0) * (Omega_h::cross(a, b) +
+      (1.0 / 2.0) * (Omega_h::cross(a, db) + Omega_h::cross(da, b)) +
+      (1.0 / 3.0) * Omega_h::cross(da, db));
+}
+
+// the volume each interior face sweeps into the first element adjacent to it,
+// and the two elements it separates (-1 for boundary faces)
+struct FaceFluxes {
+  Omega_h::Reals volumes;
+  Omega_h::LOs elems;
+};
+
+template <class Elem>
+static FaceFluxes compute_face_fluxes(Simulation& sim, Omega_h::Reals old_x, Omega_h::Reals new_x) {
+  constexpr int dim = Elem::dim;
+  auto& mesh = sim.disc.mesh;
+  auto const nfaces = mesh.nents(dim - 1);
+  auto const faces_to_elems = mesh.ask_up(dim - 1, dim);
+  auto const faces_to_verts = (dim == 1) ?
+    Omega_h::LOs(mesh.nverts(), 0, 1) : mesh.ask_verts_of(dim - 1);
+  auto const elems_to_nodes = sim.elems_to_nodes();
+  auto const volumes = Omega_h::Write<double>(nfaces);
+  auto const face_elems = Omega_h::Write<int>(nfaces * 2);
+  auto functor = OMEGA_H_LAMBDA(int face) {
+    auto const begin = faces_to_elems.a2ab[face];
+    auto const end = faces_to_elems.a2ab[face + 1];
+    if (end - begin != 2) {
+      volumes[face] = 0.0;
+      face_elems[face * 2 + 0] = (end > begin) ? faces_to_elems.ab2b[begin] : -1;
+      face_elems[face * 2 + 1] = -1;
+      return;
+    }
+    auto const elem = faces_to_elems.ab2b[begin];
+    face_elems[face * 2 + 0] = elem;
+    face_elems[face * 2 + 1] = faces_to_elems.ab2b[begin + 1];
+    auto const face_verts = Omega_h::gather_verts<dim>(faces_to_verts, face);
+    auto const old_face_x = Omega_h::gather_vectors<dim, dim>(old_x, face_verts);
+    auto const new_face_x = Omega_h::gather_vectors<dim, dim>(new_x, face_verts);
+    auto mean_displacement = zero_vector<dim>();
+    auto face_center = zero_vector<dim>();
+    for (int i = 0; i < dim; ++i) {
+      mean_displacement += (new_face_x[i] - old_face_x[i]) / double(dim);
+      face_center += old_face_x[i] / double(dim);
+    }
+    auto const elem_nodes = getnodes<Elem>(elems_to_nodes, elem);
+    auto const elem_x = getvecs<Elem>(old_x, elem_nodes);
+    auto elem_center = zero_vector<dim>();
+    for (int i = 0; i < Elem::nodes; ++i) elem_center += elem_x[i] / double(Elem::nodes);
+    // orient the face outward from the first element
+    auto const old_area = swept_area_vector(old_face_x, old_face_x);
+    auto const sign = ((face_center - elem_center) * old_area > 0.0) ? 1.0 : -1.0;
+    auto const area = swept_area_vector(old_face_x, new_face_x);
+    volumes[face] = sign * (area * mean_displacement);
+  };
+  parallel_for("ALE face flux kernel", nfaces, std::move(functor));
+  return {Omega_h::read(volumes), Omega_h::read(face_elems)};
+}
+
+static Omega_h::Reals get_full(Simulation& sim, Field& field) {
+  auto const data = field.get();
+  auto const& mapping = field.support->subset->mapping;
+  if (mapping.is_identity) return data;
+  auto const nents = sim.disc.count(field.entity_type);
+  auto const ncomps = Omega_h::divide_no_remainder(data.size(), mapping.things.size());
+  return Omega_h::map_onto(data, mapping.things, nents, 0.0, ncomps);
+}
+
+static void set_full(Simulation& sim, Field& field, Omega_h::Reals full_data) {
+  auto const& mapping = field.support->subset->mapping;
+  auto const ent_dim = (field.entity_type == NODES) ? 0 : sim.dim();
+  auto const ncomps = Omega_h::divide_no_remainder(full_data.size(), sim.disc.count(field.entity_type));
+  full_data = sim.disc.mesh.sync_array(ent_dim, full_data, ncomps);
+  if (mapping.is_identity) {
+    field.storage = Omega_h::deep_copy(full_data, field.long_name);
+  } else {
+    field.storage = Omega_h::unmap(mapping.things, full_data, ncomps);
+  }
+}
+
+// first order donor cell transport of element quantities across the faces:
+// each element gains (volume or mass swept across a face) times the value
+// of the element that volume came from.
+// values are densities with respect to the weights, so the new value is
+// (old total + gained total) / (old weight + gained weight)
+static Omega_h::Reals advect_elem_values(Simulation& sim, FaceFluxes const& fluxes,
+    Omega_h::Reals old_weights, Omega_h::Reals face_weights, Omega_h::Reals old_values,
+    int ncomps) {
+  auto& mesh = sim.disc.mesh;
+  auto const dim = mesh.dim();
+  auto const elems_to_faces = mesh.ask_down(dim, dim - 1).ab2b;
+  auto const faces_per_elem = dim + 1;
+  auto const flux_elems = fluxes.elems;
+  auto const new_values = Omega_h::Write<double>(old_values.size());
+  auto functor = OMEGA_H_LAMBDA(int elem) {
+    auto weight = old_weights[elem];
+    for (int elem_face = 0; elem_face < faces_per_elem; ++elem_face) {
+      auto const face = elems_to_faces[elem * faces_per_elem + elem_face];
+      auto const other = (flux_elems[face * 2 + 0] == elem) ?
+        flux_elems[face * 2 + 1] : flux_elems[face * 2 + 0];
+      if (other == -1) continue;
+      auto const sign = (flux_elems[face * 2 + 0] == elem) ? 1.0 : -1.0;
+      weight += sign * face_weights[face];
+    }
+    for (int comp = 0; comp < ncomps; ++comp) {
+      auto total = old_weights[elem] * old_values[elem * ncomps + comp];
+      for (int elem_face = 0; elem_face < faces_per_elem; ++elem_face) {
+        auto const face = elems_to_faces[elem * faces_per_elem + elem_face];
+        auto const other = (flux_elems[face * 2 + 0] == elem) ?
+          flux_elems[face * 2 + 1] : flux_elems[face * 2 + 0];
+        if (other == -1) continue;
+        auto const gained = ((flux_elems[face * 2 + 0] == elem) ? 1.0 : -1.0) * face_weights[face];
+        auto const donor = (gained > 0.0) ? other : elem;
+        total += gained * old_values[donor * ncomps + comp];
+      }
+      new_values[elem * ncomps + comp] = (weight > 0.0) ? (total / weight) :
+        old_values[elem * ncomps + comp];
+    }
+  };
+  parallel_for("ALE element advection kernel", mesh.nelems(), std::move(functor));
+  return new_values;
+}
+
+// nodal values are moved with the node by a first order Taylor expansion
+// using the volume weighted average of the adjacent element gradients
+template <class Elem>
+static Omega_h::Reals advect_node_values(Simulation& sim, Omega_h::Reals old_x,
+    Omega_h::Reals new_x, Omega_h::Reals old_values, int ncomps) {
+  constexpr int dim = Elem::dim;
+  auto const nodes_to_elems = sim.nodes_to_elems();
+  auto const elems_to_nodes = sim.elems_to_nodes();
+  auto const points_to_grads = sim.get(sim.gradient);
+  auto const points_to_w = sim.get(sim.weight);
+  auto const new_values = Omega_h::Write<double>(old_values.size());
+  auto functor = OMEGA_H_LAMBDA(int node) {
+    auto const displacement = getvec<Elem>(new_x, node) - getvec<Elem>(old_x, node);
+    for (int comp = 0; comp < ncomps; ++comp) {
+      auto value_gradient = zero_vector<dim>();
+      double weight_sum = 0.0;
+      for (auto node_elem = nodes_to_elems.a2ab[node];
+          node_elem < nodes_to_elems.a2ab[node + 1]; ++node_elem) {
+        auto const elem = nodes_to_elems.ab2b[node_elem];
+        auto const elem_nodes = getnodes<Elem>(elems_to_nodes, elem);
+        auto const grads = getgrads<Elem>(points_to_grads, elem);
+        auto const w = points_to_w[elem];
+        for (int elem_node = 0; elem_node < Elem::nodes; ++elem_node) {
+          value_gradient += (w * old_values[elem_nodes[elem_node] * ncomps + comp]) *
+            grads[elem_node];
+        }
+        weight_sum += w;
+      }
+      if (weight_sum > 0.0) value_gradient = value_gradient / weight_sum;
+      new_values[node * ncomps + comp] =
+        old_values[node * ncomps + comp] + value_gradient * displacement;
+    }
+  };
+  parallel_for("ALE nodal advection kernel", sim.nodes(), std::move(functor));
+  return new_values;
+}
+
+template <class Elem>
+bool smooth_and_advect(Simulation& sim) {
+  LGR_SCOPE(sim);
+  if (!sim.ale.is_due()) return false;
+  auto& mesh = sim.disc.mesh;
+  auto const dim = sim.dim();
+  auto const old_x = Omega_h::deep_copy(sim.get(sim.position));
+  auto const smoothed_x = smooth_interior_nodes(sim, old_x);
+  // back off towards the old positions until no element inverts
+  Omega_h::Reals new_x = smoothed_x;
+  double fraction = 1.0;
+  int backtracks = 0;
+  while (min_volume<Elem>(sim, new_x) <= 0.0) {
+    if (backtracks == sim.ale.max_backtracks) return false;
+    fraction /= 2.0;
+    new_x = Omega_h::add_each(Omega_h::multiply_each_by(old_x, 1.0 - fraction),
+        Omega_h::multiply_each_by(smoothed_x, fraction));
+    ++backtracks;
+  }
+  before_remap(sim);
+  auto const fluxes = compute_face_fluxes<Elem>(sim, old_x, new_x);
+  auto const old_volumes = get_full(sim, sim.fields[sim.weight]);
+  auto const old_density = get_full(sim, sim.fields[sim.density]);
+  auto const old_masses = Omega_h::multiply_each(old_volumes, old_density);
+  // mass swept across each face, carrying the donor element's density
+  auto const face_elems = fluxes.elems;
+  auto const face_volumes = fluxes.volumes;
+  auto const mass_fluxes = Omega_h::Write<double>(face_volumes.size());
+  auto mass_flux_functor = OMEGA_H_LAMBDA(int face) {
+    auto const donor = (face_volumes[face] > 0.0) ?
+      face_elems[face * 2 + 1] : face_elems[face * 2 + 0];
+    mass_fluxes[face] = (donor == -1) ? 0.0 : face_volumes[face] * old_density[donor];
+  };
+  parallel_for("ALE mass flux kernel", face_volumes.size(), std::move(mass_flux_functor));
+  // every transported value is computed from the old state before any is stored
+  std::vector<std::pair<Field*, Omega_h::Reals>> new_values;
+  for (auto& field_ptr : sim.fields.storage) {
+    auto& field = *field_ptr;
+    if (!field.has()) continue;
+    auto const ncomps = field.ncomps;
+    auto const old_values = get_full(sim, field);
+    switch (field.remap_type) {
+      case RemapType::NODAL:
+        new_values.push_back({&field,
+            advect_node_values<Elem>(sim, old_x, new_x, old_values, ncomps)});
+        break;
+      case RemapType::PER_UNIT_VOLUME:
+        new_values.push_back({&field,
+            advect_elem_values(sim, fluxes, old_volumes, fluxes.volumes, old_values, ncomps)});
+        break;
+      case RemapType::PER_UNIT_MASS:
+        new_values.push_back({&field,
+            advect_elem_values(sim, fluxes, old_masses, mass_fluxes, old_values, ncomps)});
+        break;
+      case RemapType::POSITIVE_DETERMINANT: {
+        auto const log_values = Omega_h::Write<double>(old_values.size());
+        auto log_functor = OMEGA_H_LAMBDA(int elem) {
+          auto const F = getfull<Elem>(old_values, elem);
+          // elements outside the field's sets hold zeros
+          auto const log_F = (determinant(F) > 0.0) ? Omega_h::log_glp(F) :
+            Omega_h::zero_matrix<Elem::dim, Elem::dim>();
+          setfull<Elem>(log_values, elem, log_F);
+        };
+        parallel_for("ALE log(F)", mesh.nelems(), std::move(log_functor));
+        auto const advected = advect_elem_values(sim, fluxes, old_volumes, fluxes.volumes,
+            Omega_h::read(log_values), ncomps);
+        auto const exp_values = Omega_h::Write<double>(advected.size());
+        auto exp_functor = OMEGA_H_LAMBDA(int elem) {
+          auto const log_F = getfull<Elem>(advected, elem);
+          setfull<Elem>(exp_values, elem, Omega_h::exp_glp(log_F));
+        };
+        parallel_for("ALE exp(F)", mesh.nelems(), std::move(exp_functor));
+        new_values.push_back({&field, Omega_h::read(exp_values)});
+        break;
+      }
+      default:
+        // SHAPE fields are recomputed below, the rest are derived each step
+        break;
+    }
+  }
+  for (auto& field_values : new_values) {
+    set_full(sim, *field_values.first, field_values.second);
+  }
+  Omega_h::copy_into(mesh.sync_array(0, new_x, dim), sim.set(sim.position));
+  initialize_configuration<Elem>(sim);
+  return true;
+}
+
+#define LGR_EXPL_INST(Elem) \
+template bool smooth_and_advect<Elem>(Simulation& sim);
+LGR_EXPL_INST_ELEMS
+#undef LGR_EXPL_INST
+
+}
@@ -0,0 +1,36 @@
+#ifndef LGR_ALE_HPP
+#define LGR_ALE_HPP
+
+#include <Omega_h_teuchos.hpp>
+#include <lgr_element_types.hpp>
+
+namespace lgr {
+
+struct Simulation;
+
+// arbitrary Lagrangian-Eulerian relaxation on a fixed topology:
+// every few steps the interior nodes are smoothed towards the average
+// of their neighbors and the fields are advected onto the moved mesh
+struct Ale {
+  Simulation& sim;
+  bool enabled;
+  int step_interval;
+  int smoothing_iterations;
+  double smoothing_weight;
+  int max_backtracks;
+  Ale(Simulation& sim_in);
+  void setup(Teuchos::ParameterList& pl);
+  bool is_due();
+};
+
+template <class Elem>
+bool smooth_and_advect(Simulation& sim);
+
+#define LGR_EXPL_INST(Elem) \
+extern template bool smooth_and_advect<Elem>(Simulation& sim);
+LGR_EXPL_INST_ELEMS
+#undef LGR_EXPL_INST
+
+}
+
+#endif
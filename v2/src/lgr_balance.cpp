@@ -0,0 +1,113 @@
+#include <lgr_balance.hpp>
+#include <lgr_simulation.hpp>
+#include <lgr_subset.hpp>
+#include <lgr_support.hpp>
+#include <lgr_for.hpp>
+#include <Omega_h_array_ops.hpp>
+
+namespace lgr {
+
+Balancer::Balancer(Simulation& sim_in)
+  :sim(sim_in)
+  ,enabled(false)
+  ,is_cost_weighted(false)
+  ,imbalance_tolerance(1.0)
+  ,imbalance(1.0)
+{
+}
+
+void Balancer::setup(Teuchos::ParameterList& pl) {
+  enabled = pl.isSublist("balance");
+  if (!enabled) return;
+  if (sim.disc.has_edge_nodes()) {
+    Omega_h_fail("load balancing can't migrate edge nodes of %s elements\n",
+        sim.elem_name.c_str());
+  }
+  auto& balance_pl = pl.sublist("balance");
+  is_cost_weighted = balance_pl.get<bool>("cost weighted", true);
+  imbalance_tolerance = balance_pl.get<double>("imbalance tolerance", 1.1);
+}
+
+// each element costs one unit for the hydrodynamics kernels plus,
+// for every model covering it, that model's measured time per element
+// relative to the time per element of the whole model pipeline.
+// times are summed over all ranks so every rank agrees on the costs.
+Omega_h::Reals Balancer::measure_element_costs() {
+  OMEGA_H_TIME_FUNCTION;
+  auto const nelems = sim.elems();
+  auto const costs = Omega_h::Write<double>(nelems, 1.0);
+  if (!is_cost_weighted) return costs;
+  std::vector<double> model_times;
+  std::vector<double> model_elems;
+  double total_time = 0.0;
+  for (auto& model : sim.models.models) {
+    auto const time = sim.comm->allreduce(model->accumulated_time, OMEGA_H_SUM);
+    auto const count = sim.comm->allreduce(
+        double(model->elem_support->count()), OMEGA_H_SUM);
+    model_times.push_back(time);
+    model_elems.push_back(count);
+    total_time += time;
+  }
+  auto const total_elems = double(sim.disc.mesh.nglobal_ents(sim.dim()));
+  if (total_time == 0.0) return costs;
+  auto const time_per_elem = total_time / total_elems;
+  for (std::size_t i = 0; i < sim.models.models.size(); ++i) {
+    if (model_elems[i] == 0.0) continue;
+    auto const model_cost = (model_times[i] / model_elems[i]) / time_per_elem;
+    auto const mapping = sim.models.models[i]->elem_support->subset->mapping;
+    auto functor = OMEGA_H_LAMBDA(int model_elem) {
+      auto const elem = mapping[model_elem];
+      costs[elem] += model_cost;
+    };
+    parallel_for("element cost kernel",
+        sim.models.models[i]->elem_support->count(), std::move(functor));
+  }
+  return costs;
+}
+
+// the load of the most loaded rank over the average load
+double Balancer::measure_imbalance(Omega_h::Reals costs) {
+  auto const local_cost = get_sum(costs);
+  auto const max_cost = sim.comm->allreduce(local_cost, OMEGA_H_MAX);
+  auto const total_cost = sim.comm->allreduce(local_cost, OMEGA_H_SUM);
+  auto const average_cost = total_cost / double(sim.comm->size());
+  return max_cost / average_cost;
+}
+
+// repartitions the mesh by element cost if the most loaded rank exceeds
+// the average load by more than the tolerance.
+// every allocated nodal and element field migrates with the mesh.
+// afterwards, imbalance is that of the new partition.
+bool Balancer::balance() {
+  OMEGA_H_TIME_FUNCTION;
+  if (!enabled) return false;
+  if (sim.comm->size() == 1) return false;
+  auto const costs = measure_element_costs();
+  imbalance = measure_imbalance(costs);
+  if (imbalance <= imbalance_tolerance) return false;
+  std::vector<FieldIndex> field_indices;
+  for (std::size_t i = 0; i < sim.fields.storage.size(); ++i) {
+    auto& field = *(sim.fields.storage[i]);
+    if (!field.has()) continue;
+    if (field.entity_type != NODES && field.entity_type != ELEMS) continue;
+    FieldIndex fi;
+    fi.storage_index = i;
+    field_indices.push_back(fi);
+  }
+  sim.disc.mesh.set_coords(sim.get(sim.position)); // linear specific!
+  sim.fields.copy_to_omega_h(sim.disc, field_indices);
+  sim.fields.forget_disc();
+  sim.subsets.forget_disc();
+  sim.disc.mesh.balance(costs);
+  sim.subsets.learn_disc();
+  sim.fields.learn_disc();
+  sim.fields.copy_from_omega_h(sim.disc, field_indices);
+  sim.fields.remove_from_omega_h(sim.disc, field_indices);
+  imbalance = measure_imbalance(measure_element_costs());
+  for (auto& model : sim.models.models) {
+    model->accumulated_time = 0.0;
+  }
+  return true;
+}
+
+}
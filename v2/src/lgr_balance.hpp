@@ -0,0 +1,26 @@
+#ifndef LGR_BALANCE_HPP
+#define LGR_BALANCE_HPP
+
+#include <Omega_h_teuchos.hpp>
+#include <Omega_h_array.hpp>
+
+namespace lgr {
+
+struct Simulation;
+
+struct Balancer {
+  Simulation& sim;
+  bool enabled;
+  bool is_cost_weighted;
+  double imbalance_tolerance;
+  double imbalance;
+  Balancer(Simulation& sim_in);
+  void setup(Teuchos::ParameterList& pl);
+  Omega_h::Reals measure_element_costs();
+  double measure_imbalance(Omega_h::Reals costs);
+  bool balance();
+};
+
+}
+
+#endif
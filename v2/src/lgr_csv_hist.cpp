@@ -15,7 +15,7 @@ struct CsvHist : public Response {
   {
     auto scalars_teuchos = pl.get<Teuchos::Array<std::string>>("scalars");
     scalars.assign(scalars_teuchos.begin(), scalars_teuchos.end());
-    auto path = pl.get<std::string>("path", "lgr_out.csv");
+    auto path = sim.output_path(pl.get<std::string>("path", "lgr_out.csv"));
     stream.open(path.c_str());
     OMEGA_H_CHECK(stream.is_open());
     std::stringstream header_stream;
@@ -10,7 +10,14 @@
 #include <Omega_h_metric.hpp>
 #include <Omega_h_array_ops.hpp>
 #include <fstream>
+#include <sstream>
+#include <functional>
 #include <limits>
+#include <vector>
+#include <cstdio>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace lgr {
 
@@ -104,7 +111,7 @@ static void change_element_count(Omega_h::Mesh& mesh, double desired_nelems) {
   }
 }
 
-void Disc::setup(Omega_h::CommPtr comm, Teuchos::ParameterList& pl) {
+void Disc::prepare_mesh(Omega_h::CommPtr comm, Teuchos::ParameterList& pl) {
   if (pl.isType<std::string>("file")) {
     mesh = Omega_h::read_mesh_file(pl.get<std::string>("file"), comm);
   } else if (pl.isSublist("box")) {
@@ -170,18 +177,6 @@ void Disc::setup(Omega_h::CommPtr comm, Teuchos::ParameterList& pl) {
     reader.repeat(result);
     mesh.set_coords(Omega_h::any_cast<Omega_h::Reals>(result));
   }
-  std::set<int> volume_ids;
-  for (auto& s : mesh.class_sets) {
-    for (auto& cp : s.second) {
-      if (cp.dim == dim()) {
-        auto it = volume_ids.lower_bound(cp.id);
-        if (it == volume_ids.end() || *it != cp.id) {
-          covering_class_names_.insert(s.first);
-          volume_ids.insert(it, cp.id);
-        }
-      }
-    }
-  }
   if (pl.isType<Teuchos::TwoDArray<std::string>>("mark closest nodes")) {
     auto markings = pl.get<Teuchos::TwoDArray<std::string>>("mark closest nodes");
     for (Teuchos::TwoDArray<std::string>::size_type i = 0;
@@ -196,33 +191,287 @@ void Disc::setup(Omega_h::CommPtr comm, Teuchos::ParameterList& pl) {
   }
 }
 
+// Omega_h::Mesh copies share their tag objects, and setting an existing tag
+// overwrites it in place.  re-adding every tag gives the copy its own tags
+// while the arrays and cached adjacencies stay shared.
+static void detach_tags(Omega_h::Mesh& mesh) {
+  for (int ent_dim = 0; ent_dim <= mesh.dim(); ++ent_dim) {
+    std::vector<Omega_h::TagBase const*> tags;
+    for (int i = 0; i < mesh.ntags(ent_dim); ++i) tags.push_back(mesh.get_tag(ent_dim, i));
+    for (auto tag : tags) {
+      auto const name = tag->name();
+      auto const ncomps = tag->ncomps();
+      switch (tag->type()) {
+        case OMEGA_H_I8: {
+          auto const array = Omega_h::as<Omega_h::I8>(tag)->array();
+          mesh.remove_tag(ent_dim, name);
+          mesh.add_tag(ent_dim, name, ncomps, array, true);
+          break;
+        }
+        case OMEGA_H_I32: {
+          auto const array = Omega_h::as<Omega_h::I32>(tag)->array();
+          mesh.remove_tag(ent_dim, name);
+          mesh.add_tag(ent_dim, name, ncomps, array, true);
+          break;
+        }
+        case OMEGA_H_I64: {
+          auto const array = Omega_h::as<Omega_h::I64>(tag)->array();
+          mesh.remove_tag(ent_dim, name);
+          mesh.add_tag(ent_dim, name, ncomps, array, true);
+          break;
+        }
+        case OMEGA_H_F64: {
+          auto const array = Omega_h::as<Omega_h::Real>(tag)->array();
+          mesh.remove_tag(ent_dim, name);
+          mesh.add_tag(ent_dim, name, ncomps, array, true);
+          break;
+        }
+      }
+    }
+  }
+}
+
+void Disc::setup(Disc const& loaded) {
+  OMEGA_H_CHECK(loaded.dim_ == dim_);
+  OMEGA_H_CHECK(loaded.is_simplex_ == is_simplex_);
+  OMEGA_H_CHECK(loaded.has_edge_nodes_ == has_edge_nodes_);
+  mesh = loaded.mesh;
+  detach_tags(mesh);
+  elems_to_nodes_ = loaded.elems_to_nodes_;
+  nodes_to_elems_ = loaded.nodes_to_elems_;
+  covering_class_names_ = loaded.covering_class_names_;
+}
+
+// everything that the prepared mesh depends on, as text.
+// building it also marks all the mesh parameters as used.
+static void append_cache_key(std::ostream& stream, Teuchos::ParameterList& pl) {
+  for (auto it = pl.begin(), end = pl.end(); it != end; ++it) {
+    auto const name = pl.name(it);
+    // the same mesh may be cached in a different place
+    if (name == "cache directory") continue;
+    if (pl.isSublist(name)) {
+      stream << name << " {\n";
+      append_cache_key(stream, pl.sublist(name));
+      stream << "}\n";
+    } else {
+      stream << name << ": " << pl.getEntry(name).getAny() << '\n';
+    }
+  }
+}
+
+static std::string mesh_cache_key(Omega_h::CommPtr comm,
+    Teuchos::ParameterList& pl, int dim, bool is_simplex) {
+  std::stringstream stream;
+  stream << "LGR mesh cache 1\n";
+  stream << "ranks: " << comm->size() << '\n';
+  stream << "dimension: " << dim << '\n';
+  stream << "simplex: " << is_simplex << '\n';
+  append_cache_key(stream, pl);
+  if (pl.isType<std::string>("file")) {
+    struct stat file_stat;
+    auto const file_path = pl.get<std::string>("file");
+    if (::stat(file_path.c_str(), &file_stat) == 0) {
+      stream << "file size: " << file_stat.st_size << '\n';
+      stream << "file modified: " << file_stat.st_mtime << '\n';
+    }
+  }
+  return stream.str();
+}
+
+static std::string read_file(std::string const& path) {
+  std::ifstream stream(path.c_str());
+  if (!stream.is_open()) return "";
+  std::stringstream contents;
+  contents << stream.rdbuf();
+  return contents.str();
+}
+
+// a cache only appears under its final name once it is complete,
+// and the key check rejects one that belongs to different parameters
+static bool read_cached_mesh(Omega_h::Mesh& mesh, Omega_h::CommPtr comm,
+    std::string const& path, std::string const& key) {
+  if (read_file(path + "/lgr_key.txt") != key) return false;
+  mesh = Omega_h::read_mesh_file(path, comm);
+  mesh.class_sets.clear();
+  std::stringstream sets_stream(read_file(path + "/lgr_sets.txt"));
+  int dim;
+  Omega_h::ClassId id;
+  std::string name;
+  while (sets_stream >> dim >> id) {
+    sets_stream.ignore(1);
+    std::getline(sets_stream, name);
+    mesh.class_sets[name].push_back({std::int8_t(dim), id});
+  }
+  if (comm->rank() == 0) std::printf("read prepared mesh from \"%s\"\n", path.c_str());
+  return true;
+}
+
+static int remove_entry(char const* entry_path, struct stat const*, int, struct FTW*) {
+  return std::remove(entry_path);
+}
+
+static void remove_directory(std::string const& path) {
+  ::nftw(path.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+// the cache is written under a name private to this run and then renamed
+// into place, so runs sharing the cache directory never see it half written
+static void write_cached_mesh(Omega_h::Mesh& mesh, Omega_h::CommPtr comm,
+    std::string const& directory, std::string const& path, std::string const& key) {
+  std::string temporary_path;
+  if (comm->rank() == 0) {
+    ::mkdir(directory.c_str(), 0755);
+    std::stringstream temporary_stream;
+    temporary_stream << path << ".partial." << ::getpid();
+    temporary_path = temporary_stream.str();
+  }
+  comm->bcast_string(temporary_path);
+  Omega_h::binary::write(temporary_path, &mesh);
+  if (comm->rank() == 0) {
+    std::ofstream sets_stream((temporary_path + "/lgr_sets.txt").c_str());
+    for (auto& s : mesh.class_sets) {
+      for (auto& cp : s.second) {
+        sets_stream << int(cp.dim) << ' ' << cp.id << ' ' << s.first << '\n';
+      }
+    }
+    sets_stream.close();
+    std::ofstream key_stream((temporary_path + "/lgr_key.txt").c_str());
+    key_stream << key;
+    key_stream.close();
+    // a directory can't be renamed over a non-empty one, so a stale cache
+    // under the same name is removed first. if another run got there in
+    // between, its copy is as good as ours.
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+      remove_directory(path);
+      if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+        remove_directory(temporary_path);
+      }
+    }
+  }
+  comm->barrier();
+}
+
+void Disc::setup(Omega_h::CommPtr comm, Teuchos::ParameterList& pl) {
+  if (pl.isType<std::string>("cache directory")) {
+    auto const directory = pl.get<std::string>("cache directory");
+    auto const key = mesh_cache_key(comm, pl, dim_, is_simplex_);
+    std::stringstream path_stream;
+    path_stream << directory << "/mesh_" << std::hex << std::hash<std::string>()(key) << ".osh";
+    auto const path = path_stream.str();
+    if (!read_cached_mesh(mesh, comm, path, key)) {
+      prepare_mesh(comm, pl);
+      write_cached_mesh(mesh, comm, directory, path, key);
+    }
+  } else {
+    prepare_mesh(comm, pl);
+  }
+  std::set<int> volume_ids;
+  for (auto& s : mesh.class_sets) {
+    for (auto& cp : s.second) {
+      if (cp.dim == dim()) {
+        auto it = volume_ids.lower_bound(cp.id);
+        if (it == volume_ids.end() || *it != cp.id) {
+          covering_class_names_.insert(s.first);
+          volume_ids.insert(it, cp.id);
+        }
+      }
+    }
+  }
+}
+
 int Disc::dim() { return mesh.dim(); }
 
 int Disc::count(EntityType type) {
   if (type == ELEMS) return mesh.nelems();
-  if (type == NODES) return mesh.nverts(); // linear specific!
+  if (type == NODES) {
+    if (has_edge_nodes_) return mesh.nverts() + mesh.nedges();
+    return mesh.nverts();
+  }
   OMEGA_H_NORETURN(-1);
 }
 
 Omega_h::LOs Disc::ents_to_nodes(EntityType type) {
-  // linear specific!
   OMEGA_H_CHECK(type == ELEMS);
-  return mesh.ask_elem_verts();
+  if (!has_edge_nodes_) return mesh.ask_elem_verts();
+  if (elems_to_nodes_.exists()) return elems_to_nodes_;
+  auto const elems_to_verts = mesh.ask_elem_verts();
+  auto const elems_to_edges = mesh.ask_down(mesh.dim(), 1).ab2b;
+  auto const nverts = mesh.nverts();
+  auto const verts_per_elem = mesh.dim() + 1;
+  auto const edges_per_elem = Omega_h::divide_no_remainder(elems_to_edges.size(), mesh.nelems());
+  auto const nodes_per_elem = verts_per_elem + edges_per_elem;
+  auto const out = Omega_h::Write<int>(mesh.nelems() * nodes_per_elem);
+  auto functor = OMEGA_H_LAMBDA(int elem) {
+    for (int i = 0; i < verts_per_elem; ++i) {
+      out[elem * nodes_per_elem + i] = elems_to_verts[elem * verts_per_elem + i];
+    }
+    for (int i = 0; i < edges_per_elem; ++i) {
+      out[elem * nodes_per_elem + verts_per_elem + i] =
+        nverts + elems_to_edges[elem * edges_per_elem + i];
+    }
+  };
+  Omega_h::parallel_for("elems to nodes", mesh.nelems(), std::move(functor));
+  elems_to_nodes_ = out;
+  return elems_to_nodes_;
 }
 
 Omega_h::Adj Disc::nodes_to_ents(EntityType type) {
-  // linear specific!
   OMEGA_H_CHECK(type == ELEMS);
-  return mesh.ask_up(0, mesh.dim());
+  if (!has_edge_nodes_) return mesh.ask_up(0, mesh.dim());
+  if (nodes_to_elems_.a2ab.exists()) return nodes_to_elems_;
+  // vertex nodes come first, then edge nodes, whose codes are shifted
+  // so that code_which_down() is the node's index in the element
+  auto const verts_to_elems = mesh.ask_up(0, mesh.dim());
+  auto const edges_to_elems = mesh.ask_up(1, mesh.dim());
+  auto const nverts = mesh.nverts();
+  auto const nedges = mesh.nedges();
+  auto const verts_per_elem = mesh.dim() + 1;
+  auto const nvert_uses = verts_to_elems.ab2b.size();
+  auto const nedge_uses = edges_to_elems.ab2b.size();
+  auto const a2ab = Omega_h::Write<int>(nverts + nedges + 1);
+  auto const ab2b = Omega_h::Write<int>(nvert_uses + nedge_uses);
+  auto const codes = Omega_h::Write<Omega_h::I8>(nvert_uses + nedge_uses);
+  auto vert_functor = OMEGA_H_LAMBDA(int vert) {
+    a2ab[vert] = verts_to_elems.a2ab[vert];
+    for (auto use = verts_to_elems.a2ab[vert]; use < verts_to_elems.a2ab[vert + 1]; ++use) {
+      ab2b[use] = verts_to_elems.ab2b[use];
+      codes[use] = verts_to_elems.codes[use];
+    }
+  };
+  Omega_h::parallel_for("vertex nodes to elems", nverts, std::move(vert_functor));
+  auto edge_functor = OMEGA_H_LAMBDA(int edge) {
+    a2ab[nverts + edge] = nvert_uses + edges_to_elems.a2ab[edge];
+    if (edge == nedges - 1) a2ab[nverts + nedges] = nvert_uses + nedge_uses;
+    for (auto use = edges_to_elems.a2ab[edge]; use < edges_to_elems.a2ab[edge + 1]; ++use) {
+      auto const code = edges_to_elems.codes[use];
+      ab2b[nvert_uses + use] = edges_to_elems.ab2b[use];
+      codes[nvert_uses + use] = Omega_h::make_code(
+          Omega_h::code_is_flipped(code), Omega_h::code_rotation(code),
+          verts_per_elem + Omega_h::code_which_down(code));
+    }
+  };
+  Omega_h::parallel_for("edge nodes to elems", nedges, std::move(edge_functor));
+  nodes_to_elems_ = Omega_h::Adj(a2ab, ab2b, codes);
+  return nodes_to_elems_;
 }
 
 Omega_h::LOs Disc::ents_on_closure(
     std::set<std::string> const& class_names,
     EntityType type) {
-  int ent_dim = -1;
-  if (type == NODES) ent_dim = 0; // linear specific!
-  else if (type == ELEMS) ent_dim = dim();
-  return Omega_h::ents_on_closure(&mesh, class_names, ent_dim);
+  if (type == ELEMS) return Omega_h::ents_on_closure(&mesh, class_names, dim());
+  OMEGA_H_CHECK(type == NODES);
+  auto const verts = Omega_h::ents_on_closure(&mesh, class_names, 0);
+  if (!has_edge_nodes_) return verts;
+  auto const edges = Omega_h::ents_on_closure(&mesh, class_names, 1);
+  auto const nverts = mesh.nverts();
+  auto const nset_verts = verts.size();
+  auto const out = Omega_h::Write<int>(nset_verts + edges.size());
+  auto functor = OMEGA_H_LAMBDA(int i) {
+    if (i < nset_verts) out[i] = verts[i];
+    else out[i] = nverts + edges[i - nset_verts];
+  };
+  Omega_h::parallel_for("nodes on closure", out.size(), std::move(functor));
+  return out;
 }
 
 ClassNames const& Disc::covering_class_names() {
@@ -241,6 +490,7 @@ template <class Elem>
 void Disc::set_elem() {
   dim_ = Elem::dim;
   is_simplex_ = Elem::is_simplex;
+  has_edge_nodes_ = Elem::is_simplex && (Elem::nodes > Elem::dim + 1);
   points_per_ent_[ELEMS] = Elem::points;
   points_per_ent_[SIDES] = Elem::side::points;
   points_per_ent_[EDGES] = -1;
@@ -252,8 +502,41 @@ void Disc::set_elem() {
 }
 
 Omega_h::Reals Disc::node_coords() {
-  //linear specific!
-  return mesh.coords();
+  if (!has_edge_nodes_) return mesh.coords();
+  // edge nodes start at the edge midpoints
+  auto const coords = mesh.coords();
+  auto const edges_to_verts = mesh.ask_verts_of(1);
+  auto const nverts = mesh.nverts();
+  auto const dim = mesh.dim();
+  auto const out = Omega_h::Write<double>(count(NODES) * dim);
+  auto functor = OMEGA_H_LAMBDA(int node) {
+    for (int comp = 0; comp < dim; ++comp) {
+      if (node < nverts) {
+        out[node * dim + comp] = coords[node * dim + comp];
+      } else {
+        auto const edge = node - nverts;
+        out[node * dim + comp] = 0.5 * (
+            coords[edges_to_verts[edge * 2 + 0] * dim + comp] +
+            coords[edges_to_verts[edge * 2 + 1] * dim + comp]);
+      }
+    }
+  };
+  Omega_h::parallel_for("node coords", count(NODES), std::move(functor));
+  return out;
+}
+
+bool Disc::has_edge_nodes() {
+  return has_edge_nodes_;
+}
+
+Omega_h::Reals Disc::vertex_values(Omega_h::Reals node_values, int ncomps) {
+  if (!has_edge_nodes_) return node_values;
+  auto const out = Omega_h::Write<double>(mesh.nverts() * ncomps);
+  auto functor = OMEGA_H_LAMBDA(int i) {
+    out[i] = node_values[i];
+  };
+  Omega_h::parallel_for("vertex values", out.size(), std::move(functor));
+  return out;
 }
 
 #define LGR_EXPL_INST(Elem) \
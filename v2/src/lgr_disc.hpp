@@ -14,6 +14,8 @@ struct Disc {
   int dim();
   int count(EntityType type);
   void setup(Omega_h::CommPtr comm, Teuchos::ParameterList& pl);
+  void setup(Disc const& loaded);
+  void prepare_mesh(Omega_h::CommPtr comm, Teuchos::ParameterList& pl);
   Omega_h::LOs ents_to_nodes(EntityType type);
   Omega_h::Adj nodes_to_ents(EntityType type);
   Omega_h::LOs ents_on_closure(
@@ -25,9 +27,15 @@ struct Disc {
   template <class Elem>
   void set_elem();
   Omega_h::Reals node_coords();
+  bool has_edge_nodes();
+  Omega_h::Reals vertex_values(Omega_h::Reals node_values, int ncomps);
   Omega_h::Mesh mesh;
   int dim_;
   bool is_simplex_;
+  // quadratic simplices number their edge nodes after the vertices
+  bool has_edge_nodes_;
+  Omega_h::LOs elems_to_nodes_;
+  Omega_h::Adj nodes_to_elems_;
   int points_per_ent_[4];
   int nodes_per_ent_[4];
   ClassNames covering_class_names_;
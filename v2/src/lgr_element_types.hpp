@@ -192,17 +192,315 @@ struct Tet4 {
   using side = Tet4Side;
 };
 
+struct CompositeTetSide {
+  static constexpr int dim = 3;
+  static constexpr int nodes = 6;
+  static constexpr int points = 1;
+  static constexpr bool is_simplex = true;
+  // the centroid lies in the central sub-triangle spanned by the edge nodes
+  static OMEGA_H_INLINE Matrix<nodes, points> basis_values() {
+    Matrix<nodes, points> out;
+    for (int i = 0; i < 3; ++i) out[0][i] = 0.0;
+    for (int i = 3; i < 6; ++i) out[0][i] = 1.0 / 3.0;
+    return out;
+  }
+};
+
+// The composite tetrahedron of Thoutireddy, Molinari, Repetto and Ortiz:
+// ten nodes (four vertices followed by the six edge nodes in Omega_h edge
+// order) split the element into twelve linear sub-tetrahedra, four at the
+// corners and eight filling the central octahedron around an implicit center
+// node which is the average of the edge nodes.
+// The piecewise constant sub-tetrahedron gradients are L2-projected onto a
+// field that is linear in the parent barycentric coordinates, which is then
+// sampled at the four point Gauss rule.
 struct CompositeTet {
   static constexpr int dim = 3;
   static constexpr int nodes = 10;
   static constexpr int points = 4;
   static constexpr bool is_simplex = true;
+  static constexpr int subtets = 12;
+  static constexpr int center_node = 10;
+  static OMEGA_H_INLINE int subtet_node(int subtet, int subtet_vert) {
+    int const table[subtets][4] = {
+      {0, 4, 6, 7},
+      {1, 5, 4, 8},
+      {2, 6, 5, 9},
+      {7, 8, 9, 3},
+      {4, 5, 6, 10},
+      {4, 7, 8, 10},
+      {5, 8, 9, 10},
+      {6, 9, 7, 10},
+      {4, 6, 7, 10},
+      {4, 8, 5, 10},
+      {5, 9, 6, 10},
+      {7, 9, 8, 10}};
+    return table[subtet][subtet_vert];
+  }
+  static OMEGA_H_INLINE int edge_vert(int edge, int edge_vert) {
+    int const table[6][2] = {{0, 1}, {1, 2}, {2, 0}, {0, 3}, {1, 3}, {2, 3}};
+    return table[edge][edge_vert];
+  }
+  // barycentric coordinates of a node (or the center node) in the parent
+  static OMEGA_H_INLINE Vector<4> node_barycentric(int node) {
+    Vector<4> out;
+    for (int i = 0; i < 4; ++i) out[i] = 0.0;
+    if (node < 4) {
+      out[node] = 1.0;
+    } else if (node < nodes) {
+      out[edge_vert(node - 4, 0)] = 0.5;
+      out[edge_vert(node - 4, 1)] = 0.5;
+    } else {
+      for (int i = 0; i < 4; ++i) out[i] = 0.25;
+    }
+    return out;
+  }
+  // the four point Gauss rule, point i is closest to vertex i
+  static OMEGA_H_INLINE Vector<4> point_barycentric(int point) {
+    Vector<4> out;
+    for (int i = 0; i < 4; ++i) out[i] = 0.1381966011250105;
+    out[point] = 0.5854101966249685;
+    return out;
+  }
+  // Gauss-Jordan elimination, the projection matrix is symmetric positive definite
+  static OMEGA_H_INLINE Matrix<4, 4> invert_projection(Matrix<4, 4> a) {
+    auto out = Omega_h::identity_matrix<4, 4>();
+    for (int j = 0; j < 4; ++j) {
+      auto const inv_pivot = 1.0 / a(j, j);
+      for (int k = 0; k < 4; ++k) {
+        a(j, k) *= inv_pivot;
+        out(j, k) *= inv_pivot;
+      }
+      for (int i = 0; i < 4; ++i) {
+        if (i == j) continue;
+        auto const factor = a(i, j);
+        for (int k = 0; k < 4; ++k) {
+          a(i, k) -= factor * a(j, k);
+          out(i, k) -= factor * out(j, k);
+        }
+      }
+    }
+    return out;
+  }
+  static OMEGA_H_INLINE
+  Shape<CompositeTet> shape(Matrix<dim, nodes> node_coords) {
+    Matrix<3, nodes + 1> x;
+    for (int i = 0; i < nodes; ++i) x[i] = node_coords[i];
+    x[center_node] = zero_vector<3>();
+    for (int i = 4; i < nodes; ++i) x[center_node] += node_coords[i] * (1.0 / 6.0);
+    Shape<CompositeTet> out;
+    out.lengths.time_step_length = Omega_h::ArithTraits<double>::max();
+    out.lengths.viscosity_length = 0.0;
+    double volume = 0.0;
+    auto projection = Omega_h::zero_matrix<4, 4>();
+    // right hand sides of the projection, one per barycentric coordinate
+    Omega_h::Few<Matrix<3, nodes>, 4> moments;
+    for (int i = 0; i < 4; ++i) moments[i] = Omega_h::zero_matrix<3, nodes>();
+    for (int subtet = 0; subtet < subtets; ++subtet) {
+      Matrix<3, 4> sub_x;
+      Matrix<4, 4> sub_lambdas;
+      auto lambda_sum = zero_vector<4>();
+      for (int i = 0; i < 4; ++i) {
+        auto const node = subtet_node(subtet, i);
+        sub_x[i] = x[node];
+        sub_lambdas[i] = node_barycentric(node);
+        lambda_sum += sub_lambdas[i];
+      }
+      auto const sub_shape = Tet4::shape(sub_x);
+      auto const sub_volume = sub_shape.weights[0];
+      volume += sub_volume;
+      out.lengths.time_step_length = Omega_h::min2(
+          out.lengths.time_step_length, sub_shape.lengths.time_step_length);
+      out.lengths.viscosity_length = Omega_h::max2(
+          out.lengths.viscosity_length, sub_shape.lengths.viscosity_length);
+      // integrals of products of linear functions over the sub-tetrahedron
+      for (int k = 0; k < 4; ++k) {
+        for (int l = 0; l < 4; ++l) {
+          double vertex_sum = 0.0;
+          for (int i = 0; i < 4; ++i) vertex_sum += sub_lambdas[i][k] * sub_lambdas[i][l];
+          projection(k, l) += (sub_volume / 20.0) * (vertex_sum + lambda_sum[k] * lambda_sum[l]);
+        }
+      }
+      // constant sub-tetrahedron gradient in terms of the ten element nodes
+      auto sub_grads = Omega_h::zero_matrix<3, nodes>();
+      for (int i = 0; i < 4; ++i) {
+        auto const node = subtet_node(subtet, i);
+        auto const grad = sub_shape.basis_gradients[0][i];
+        if (node == center_node) {
+          for (int j = 4; j < nodes; ++j) sub_grads[j] += grad * (1.0 / 6.0);
+        } else {
+          sub_grads[node] += grad;
+        }
+      }
+      for (int l = 0; l < 4; ++l) {
+        moments[l] = moments[l] + sub_grads * ((sub_volume / 4.0) * lambda_sum[l]);
+      }
+    }
+    auto const inv_projection = invert_projection(projection);
+    Omega_h::Few<Matrix<3, nodes>, 4> projected;
+    for (int k = 0; k < 4; ++k) {
+      projected[k] = Omega_h::zero_matrix<3, nodes>();
+      for (int l = 0; l < 4; ++l) projected[k] = projected[k] + moments[l] * inv_projection(k, l);
+    }
+    for (int point = 0; point < points; ++point) {
+      auto const lambda = point_barycentric(point);
+      out.basis_gradients[point] = Omega_h::zero_matrix<3, nodes>();
+      for (int k = 0; k < 4; ++k) {
+        out.basis_gradients[point] = out.basis_gradients[point] + projected[k] * lambda[k];
+      }
+      out.weights[point] = volume / 4.0;
+    }
+    return out;
+  }
+  // integrals of the piecewise linear basis functions over an element
+  // whose edge nodes are at the midpoints: vertex nodes carry V/32 and
+  // edge nodes carry 7V/48
+  static OMEGA_H_INLINE
+  constexpr double lumping_factor(int node) {
+    return (node < 4) ? (1.0 / 32.0) : (7.0 / 48.0);
+  }
+  // each Gauss point lies in the corner sub-tetrahedron of its vertex
+  static OMEGA_H_INLINE Matrix<nodes, points> basis_values() {
+    Matrix<nodes, points> out;
+    for (int point = 0; point < points; ++point) {
+      for (int node = 0; node < nodes; ++node) out[point][node] = 0.0;
+      auto const lambda = point_barycentric(point);
+      out[point][point] = 2.0 * lambda[point] - 1.0;
+      for (int edge = 0; edge < 6; ++edge) {
+        auto const other = edge_vert(edge, 0) == point ? edge_vert(edge, 1) :
+          (edge_vert(edge, 1) == point ? edge_vert(edge, 0) : -1);
+        if (other != -1) out[point][4 + edge] = 2.0 * lambda[other];
+      }
+    }
+    return out;
+  }
+  static constexpr char const* name() { return "CompositeTet"; }
+  using side = CompositeTetSide;
+};
+
+struct Hex8Side {
+  static constexpr int dim = 3;
+  static constexpr int nodes = 4;
+  static constexpr int points = 1;
+  static constexpr bool is_simplex = false;
+  static OMEGA_H_INLINE Matrix<nodes, points> basis_values() {
+    Matrix<nodes, points> out;
+    for (int i = 0; i < nodes; ++i) out[0][i] = 1.0 / 4.0;
+    return out;
+  }
+};
+
+// The trilinear hexahedron with one integration point, using the mean
+// (volume averaged) basis gradients of Flanagan and Belytschko.
+// Nodes follow the Omega_h/Exodus ordering: the bottom face counterclockwise,
+// then the top face. The zero energy modes this leaves behind are controlled
+// by the "hourglass control" modifier, see lgr_hourglass.cpp
+struct Hex8 {
+  static constexpr int dim = 3;
+  static constexpr int nodes = 8;
+  static constexpr int points = 1;
+  static constexpr bool is_simplex = false;
+  static constexpr int hourglass_modes = 4;
+  // the parent coordinate (-1 or 1) of a node along one axis
+  static OMEGA_H_INLINE double parent_coord(int node, int axis) {
+    int const table[nodes][3] = {
+      {-1, -1, -1},
+      { 1, -1, -1},
+      { 1,  1, -1},
+      {-1,  1, -1},
+      {-1, -1,  1},
+      { 1, -1,  1},
+      { 1,  1,  1},
+      {-1,  1,  1}};
+    return double(table[node][axis]);
+  }
+  // the hourglass base vectors: eta*zeta, zeta*xi, xi*eta and xi*eta*zeta
+  static OMEGA_H_INLINE double hourglass_base(int mode, int node) {
+    auto const xi = parent_coord(node, 0);
+    auto const eta = parent_coord(node, 1);
+    auto const zeta = parent_coord(node, 2);
+    if (mode == 0) return eta * zeta;
+    if (mode == 1) return zeta * xi;
+    if (mode == 2) return xi * eta;
+    return xi * eta * zeta;
+  }
+  static OMEGA_H_INLINE int face_node(int face, int face_vert) {
+    int const table[6][4] = {
+      {0, 3, 2, 1},
+      {4, 5, 6, 7},
+      {0, 1, 5, 4},
+      {1, 2, 6, 5},
+      {2, 3, 7, 6},
+      {3, 0, 4, 7}};
+    return table[face][face_vert];
+  }
+  static OMEGA_H_INLINE
+  Shape<Hex8> shape(Matrix<dim, nodes> node_coords) {
+    // the integrand of the mean gradient is at most cubic in each parent
+    // coordinate, so the 2x2x2 Gauss rule integrates it exactly
+    double const gauss = 1.0 / std::sqrt(3.0);
+    double volume = 0.0;
+    auto weighted_grads = Omega_h::zero_matrix<dim, nodes>();
+    for (int gp = 0; gp < 8; ++gp) {
+      Vector<3> xi;
+      for (int axis = 0; axis < 3; ++axis) xi[axis] = parent_coord(gp, axis) * gauss;
+      Matrix<dim, nodes> parent_grads;
+      for (int node = 0; node < nodes; ++node) {
+        for (int axis = 0; axis < 3; ++axis) {
+          double value = parent_coord(node, axis) / 8.0;
+          for (int other = 0; other < 3; ++other) {
+            if (other == axis) continue;
+            value *= 1.0 + parent_coord(node, other) * xi[other];
+          }
+          parent_grads[node][axis] = value;
+        }
+      }
+      auto const jacobian = node_coords * transpose(parent_grads);
+      auto const det_j = Omega_h::determinant(jacobian);
+      auto const inv_jacobian_t = transpose(Omega_h::invert(jacobian));
+      volume += det_j;
+      weighted_grads = weighted_grads + (inv_jacobian_t * parent_grads) * det_j;
+    }
+    Shape<Hex8> out;
+    out.weights[0] = volume;
+    out.basis_gradients[0] = weighted_grads * (1.0 / volume);
+    double max_face_area = 0.0;
+    for (int face = 0; face < 6; ++face) {
+      auto const diagonal_a = node_coords[face_node(face, 2)] - node_coords[face_node(face, 0)];
+      auto const diagonal_b = node_coords[face_node(face, 3)] - node_coords[face_node(face, 1)];
+      auto const area = Omega_h::norm(Omega_h::cross(diagonal_a, diagonal_b)) / 2.0;
+      max_face_area = Omega_h::max2(max_face_area, area);
+    }
+    out.lengths.time_step_length = volume / max_face_area;
+    double max_squared_edge_length = 0.0;
+    for (int face = 0; face < 6; ++face) {
+      for (int i = 0; i < 4; ++i) {
+        auto const edge_vector = node_coords[face_node(face, (i + 1) % 4)] -
+          node_coords[face_node(face, i)];
+        max_squared_edge_length = Omega_h::max2(
+            max_squared_edge_length, Omega_h::norm_squared(edge_vector));
+      }
+    }
+    out.lengths.viscosity_length = std::sqrt(max_squared_edge_length);
+    return out;
+  }
+  static OMEGA_H_INLINE
+  constexpr double lumping_factor(int /*node*/) { return 1.0 / 8.0; }
+  static OMEGA_H_INLINE Matrix<nodes, points> basis_values() {
+    Matrix<nodes, points> out;
+    for (int i = 0; i < nodes; ++i) out[0][i] = 1.0 / 8.0;
+    return out;
+  }
+  static constexpr char const* name() { return "Hex8"; }
+  using side = Hex8Side;
 };
 
 #define LGR_EXPL_INST_ELEMS \
 LGR_EXPL_INST(Bar2) \
 LGR_EXPL_INST(Tri3) \
-LGR_EXPL_INST(Tet4)
+LGR_EXPL_INST(Tet4) \
+LGR_EXPL_INST(CompositeTet) \
+LGR_EXPL_INST(Hex8)
 
 #define LGR_EXPL_INST_ELEMS_AND_SIDES \
 LGR_EXPL_INST(Bar2) \
@@ -210,7 +508,11 @@ LGR_EXPL_INST(Bar2::side) \
 LGR_EXPL_INST(Tri3) \
 LGR_EXPL_INST(Tri3::side) \
 LGR_EXPL_INST(Tet4) \
-LGR_EXPL_INST(Tet4::side)
+LGR_EXPL_INST(Tet4::side) \
+LGR_EXPL_INST(CompositeTet) \
+LGR_EXPL_INST(CompositeTet::side) \
+LGR_EXPL_INST(Hex8) \
+LGR_EXPL_INST(Hex8::side)
 
 }
 
@@ -0,0 +1,127 @@
+#include <lgr_ensemble.hpp>
+#include <lgr_run.hpp>
+#include <lgr_simulation.hpp>
+#include <Omega_h_stack.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace lgr {
+
+static void write_results(std::string const& path,
+    std::vector<std::string> const& member_names,
+    std::vector<std::string> const& scalars,
+    Omega_h::HostRead<double> values) {
+  std::ofstream stream(path.c_str());
+  if (!stream.is_open()) {
+    Omega_h_fail("could not open ensemble results file \"%s\"\n", path.c_str());
+  }
+  stream << "member";
+  for (auto& scalar : scalars) stream << ", " << scalar;
+  stream << '\n';
+  stream << std::scientific << std::setprecision(17);
+  auto const nscalars = int(scalars.size());
+  for (int member = 0; member < int(member_names.size()); ++member) {
+    stream << member_names[std::size_t(member)];
+    for (int i = 0; i < nscalars; ++i) {
+      stream << ", " << values[member * nscalars + i];
+    }
+    stream << '\n';
+  }
+}
+
+void run_ensemble(Omega_h::CommPtr comm, Teuchos::ParameterList& pl,
+    Factories&& factories_in) {
+  OMEGA_H_TIME_FUNCTION;
+  auto& ensemble_pl = pl.sublist("ensemble");
+  // members are distributed round-robin over groups of consecutive ranks,
+  // each group running its members one after the other
+  auto const ngroups = ensemble_pl.get<int>("groups", 1);
+  if (ngroups < 1 || ngroups > comm->size()) {
+    Omega_h_fail("ensemble \"groups\" must be between 1 and the number of ranks (%d)\n",
+        comm->size());
+  }
+  auto const path = ensemble_pl.get<std::string>("results file", "lgr_ensemble.csv");
+  std::vector<std::string> scalars;
+  if (ensemble_pl.isType<Teuchos::Array<std::string>>("scalars")) {
+    auto scalars_teuchos = ensemble_pl.get<Teuchos::Array<std::string>>("scalars");
+    scalars.assign(scalars_teuchos.begin(), scalars_teuchos.end());
+  }
+  auto& members_pl = ensemble_pl.sublist("members");
+  std::vector<std::string> member_names;
+  for (auto it = members_pl.begin(), end = members_pl.end(); it != end; ++it) {
+    auto const name = members_pl.name(it);
+    if (!members_pl.isSublist(name)) {
+      Omega_h_fail("ensemble member \"%s\" should be a sublist of overrides\n", name.c_str());
+    }
+    auto& member_pl = members_pl.sublist(name);
+    if (member_pl.isParameter("mesh") || member_pl.isParameter("element type")) {
+      Omega_h_fail("ensemble member \"%s\" can't change the shared mesh or element type\n",
+          name.c_str());
+    }
+    member_names.push_back(name);
+  }
+  if (member_names.empty()) Omega_h_fail("ensemble has no members\n");
+  Factories factories(std::move(factories_in));
+  auto const elem = pl.get<std::string>("element type");
+  if (factories.empty()) factories = Factories(elem);
+  auto const group = (comm->rank() * ngroups) / comm->size();
+  auto const group_comm = comm->split(group, comm->rank());
+  // load the mesh once and derive the adjacencies every member will ask for
+  Disc loaded_disc;
+  bool is_known_elem = false;
+#define LGR_EXPL_INST(Elem) \
+  if (elem == Elem::name()) { \
+    loaded_disc.set_elem<Elem>(); \
+    is_known_elem = true; \
+  }
+  LGR_EXPL_INST_ELEMS
+#undef LGR_EXPL_INST
+  if (!is_known_elem) Omega_h_fail("Unknown element type \"%s\"\n", elem.c_str());
+  loaded_disc.setup(group_comm, pl.sublist("mesh"));
+  loaded_disc.ents_to_nodes(ELEMS);
+  loaded_disc.nodes_to_ents(ELEMS);
+  auto base_pl = pl;
+  base_pl.remove("ensemble");
+  base_pl.remove("mesh");
+  // each member writes its outputs into a directory named after it,
+  // so neither members run one after the other nor concurrent groups
+  // overwrite each other's files
+  std::string output_prefix;
+  if (base_pl.isType<std::string>("output directory")) {
+    output_prefix = base_pl.get<std::string>("output directory") + "/";
+    if (comm->rank() == 0) ::mkdir(output_prefix.c_str(), 0755);
+    comm->barrier();
+  }
+  auto const nmembers = int(member_names.size());
+  auto const nscalars = int(scalars.size());
+  Omega_h::HostWrite<double> values(nmembers * nscalars, "ensemble values");
+  for (int i = 0; i < values.size(); ++i) values[i] = 0.0;
+  for (int member = group; member < nmembers; member += ngroups) {
+    auto const& name = member_names[std::size_t(member)];
+    // each member starts from a fresh simulation on its own copy of the mesh,
+    // so nothing from the previous member needs to be reset
+    auto member_pl = base_pl;
+    member_pl.set("output directory", output_prefix + name);
+    member_pl.setParameters(members_pl.sublist(name));
+    Simulation sim(group_comm, Factories(factories));
+#define LGR_EXPL_INST(Elem) \
+    if (elem == Elem::name()) sim.set_elem<Elem>();
+    LGR_EXPL_INST_ELEMS
+#undef LGR_EXPL_INST
+    sim.setup(member_pl, loaded_disc);
+    run(sim);
+    for (int i = 0; i < nscalars; ++i) {
+      auto const value = sim.scalars.ask_value(scalars[std::size_t(i)]);
+      if (group_comm->rank() == 0) values[member * nscalars + i] = value;
+    }
+  }
+  // only the first rank of the group that ran a member has its values
+  auto const all_values = Omega_h::HostRead<double>(
+      comm->allreduce(Omega_h::read(values.write()), OMEGA_H_SUM));
+  if (comm->rank() == 0) write_results(path, member_names, scalars, all_values);
+}
+
+}
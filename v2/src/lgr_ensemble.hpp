@@ -0,0 +1,19 @@
+#ifndef LGR_ENSEMBLE_HPP
+#define LGR_ENSEMBLE_HPP
+
+#include <lgr_factories.hpp>
+#include <Omega_h_teuchos.hpp>
+
+namespace lgr {
+
+// runs every member of the "ensemble" sublist as its own simulation.
+// the mesh is loaded and its adjacencies derived once per group of ranks,
+// each member's parameters are the rest of the list with the member's
+// overrides applied, and the final values of the requested scalars
+// of all members are written to a single CSV table.
+void run_ensemble(Omega_h::CommPtr comm, Teuchos::ParameterList& pl,
+    Factories&& model_factories = Factories());
+
+}
+
+#endif
@@ -175,15 +175,19 @@ void Fields::copy_to_omega_h(Disc& disc, std::vector<FieldIndex> field_indices)
     }
     auto& mapping = field.support->subset->mapping;
     auto const data = field.get();
+    auto const nents = disc.count(field.entity_type);
+    Omega_h::Reals full_data;
+    int ncomps;
     if (field.support->subset->mapping.is_identity) {
-      auto ncomps = divide_no_remainder(data.size(), disc.mesh.nents(entity_dim));
-      disc.mesh.add_tag(entity_dim, field.long_name, ncomps, data);
+      ncomps = divide_no_remainder(data.size(), nents);
+      full_data = data;
     } else {
-      auto ncomps = divide_no_remainder(data.size(), mapping.things.size());
-      auto full_data = Omega_h::map_onto(data, mapping.things,
-          disc.mesh.nents(entity_dim), 0.0, ncomps);
-      disc.mesh.add_tag(entity_dim, field.long_name, ncomps, full_data);
+      ncomps = divide_no_remainder(data.size(), mapping.things.size());
+      full_data = Omega_h::map_onto(data, mapping.things, nents, 0.0, ncomps);
     }
+    // Omega_h only stores values at vertices, edge nodes are left out
+    if (field.entity_type == NODES) full_data = disc.vertex_values(full_data, ncomps);
+    disc.mesh.add_tag(entity_dim, field.long_name, ncomps, full_data);
   }
 }
 
@@ -0,0 +1,90 @@
+#include <lgr_hourglass.hpp>
+#include <lgr_scope.hpp>
+#include <lgr_simulation.hpp>
+#include <lgr_for.hpp>
+
+namespace lgr {
+
+// viscous hourglass control after Flanagan and Belytschko:
+// the hourglass base vectors are made orthogonal to the linear velocity field
+// using the mean gradients, so rigid motion and uniform strain produce no force,
+// and each mode's velocity is resisted with the coefficient of Hallquist,
+// coefficient * rho * c * V^(2/3) / 4.
+// these forces do work that is not accounted for in the internal energy.
+OMEGA_H_INLINE Matrix<3, Hex8::nodes> hourglass_force(
+    double coefficient,
+    double density,
+    double wave_speed,
+    double volume,
+    Matrix<3, Hex8::nodes> x,
+    Matrix<3, Hex8::nodes> v,
+    Matrix<3, Hex8::nodes> grads) {
+  auto const damping = coefficient * density * wave_speed *
+    std::pow(volume, 2.0 / 3.0) / 4.0;
+  auto f = Omega_h::zero_matrix<3, Hex8::nodes>();
+  for (int mode = 0; mode < Hex8::hourglass_modes; ++mode) {
+    auto base_dot_x = zero_vector<3>();
+    for (int node = 0; node < Hex8::nodes; ++node) {
+      base_dot_x += x[node] * Hex8::hourglass_base(mode, node);
+    }
+    Vector<Hex8::nodes> gamma;
+    for (int node = 0; node < Hex8::nodes; ++node) {
+      gamma[node] = Hex8::hourglass_base(mode, node) - base_dot_x * grads[node];
+    }
+    auto mode_v = zero_vector<3>();
+    for (int node = 0; node < Hex8::nodes; ++node) mode_v += v[node] * gamma[node];
+    for (int node = 0; node < Hex8::nodes; ++node) {
+      f[node] -= (damping * gamma[node]) * mode_v;
+    }
+  }
+  return f;
+}
+
+struct HourglassControl : public Model<Hex8> {
+  double coefficient;
+  FieldIndex force;
+  HourglassControl(Simulation& sim_in, Teuchos::ParameterList& pl):Model<Hex8>(sim_in, pl) {
+    this->coefficient = pl.get<double>("coefficient", 0.1);
+    this->force = this->elem_define("f_hg", "hourglass force",
+        Hex8::nodes * Hex8::dim);
+    this->sim.element_forces.push_back(this->force);
+  }
+  std::uint64_t exec_stages() override final { return AFTER_MATERIAL_MODEL; }
+  char const* name() override final { return "hourglass control"; }
+  void after_material_model() override final {
+    auto const elems_to_nodes = this->get_elems_to_nodes();
+    auto const nodes_to_x = this->sim.get(this->sim.position);
+    auto const nodes_to_v = this->sim.get(this->sim.velocity);
+    auto const points_to_grad = this->points_get(this->sim.gradient);
+    auto const points_to_w = this->points_get(this->sim.weight);
+    auto const points_to_rho = this->points_get(this->sim.density);
+    auto const points_to_c = this->points_get(this->sim.wave_speed);
+    auto const elems_to_f = this->elems_set(this->force);
+    auto const coeff = this->coefficient;
+    auto functor = OMEGA_H_LAMBDA(int elem) {
+      auto const elem_nodes = getnodes<Hex8>(elems_to_nodes, elem);
+      auto const x = getvecs<Hex8>(nodes_to_x, elem_nodes);
+      auto const v = getvecs<Hex8>(nodes_to_v, elem_nodes);
+      // one point per element, so point and element indices coincide
+      auto const grads = getgrads<Hex8>(points_to_grad, elem);
+      auto const f = hourglass_force(coeff, points_to_rho[elem],
+          points_to_c[elem], points_to_w[elem], x, v, grads);
+      auto const field_elem = elems_to_f.mapping[elem];
+      for (int node = 0; node < Hex8::nodes; ++node) {
+        for (int d = 0; d < Hex8::dim; ++d) {
+          elems_to_f.data[(field_elem * Hex8::nodes + node) * Hex8::dim + d] = f[node][d];
+        }
+      }
+    };
+    parallel_for("hourglass control kernel",
+        this->points(), std::move(functor));
+  }
+};
+
+ModelBase* hourglass_control_factory(
+    Simulation& sim, std::string const&,
+    Teuchos::ParameterList& pl) {
+  return new HourglassControl(sim, pl);
+}
+
+}
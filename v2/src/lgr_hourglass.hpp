@@ -0,0 +1,17 @@
+#ifndef LGR_HOURGLASS_HPP
+#define LGR_HOURGLASS_HPP
+
+#include <lgr_element_types.hpp>
+#include <lgr_model.hpp>
+#include <string>
+
+namespace lgr {
+
+// only available for Hex8, the only element with hourglass modes
+ModelBase* hourglass_control_factory(
+    Simulation& sim, std::string const& name,
+    Teuchos::ParameterList& pl);
+
+}
+
+#endif
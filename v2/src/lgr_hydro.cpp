@@ -2,6 +2,7 @@
 #include <lgr_simulation.hpp>
 #include <lgr_scope.hpp>
 #include <Omega_h_align.hpp>
+#include <Omega_h_map.hpp>
 #include <lgr_for.hpp>
 
 namespace lgr {
@@ -38,6 +39,9 @@ void lump_masses(Simulation& sim) {
   auto points_to_w = sim.get(sim.weight);
   auto nodes_to_elems = sim.nodes_to_elems();
   auto nodes_to_mass = sim.set(sim.nodal_mass);
+  // fictitious mass, if any, is added by scaling the density at each point
+  bool const is_scaled = sim.mass_scale.is_valid() && sim.has(sim.mass_scale);
+  auto points_to_scale = is_scaled ? sim.get(sim.mass_scale) : Omega_h::Read<double>();
   auto functor = OMEGA_H_LAMBDA(int node) {
     double node_mass = 0.0;
     for (auto node_elem = nodes_to_elems.a2ab[node];
@@ -51,7 +55,8 @@ void lump_masses(Simulation& sim) {
         auto point = elem * Elem::points + elem_pt;
         auto rho = points_to_rho[point];
         auto w = points_to_w[point];
-        elem_mass += rho * w;
+        auto scale = is_scaled ? points_to_scale[point] : 1.0;
+        elem_mass += rho * w * scale;
       }
       node_mass += elem_mass * Elem::lumping_factor(elem_node);
     }
@@ -126,6 +131,33 @@ void correct_velocity(Simulation& sim) {
   parallel_for("velocity correction kernel", sim.nodes(), std::move(functor));
 }
 
+template <class Elem>
+void add_element_force(Simulation& sim, FieldIndex fi) {
+  LGR_SCOPE(sim);
+  // element nodal forces may only cover some of the elements
+  auto elems_to_f = sim.get(fi);
+  auto nodes_to_f = sim.getset(sim.force);
+  auto nodes_to_elems = sim.nodes_to_elems();
+  auto const& mapping = sim.fields[fi].support->subset->mapping;
+  auto elems_to_force_elems = mapping.is_identity ?
+    Omega_h::LOs(sim.elems(), 0, 1) :
+    Omega_h::invert_injective_map(mapping.things, sim.elems());
+  auto functor = OMEGA_H_LAMBDA(int node) {
+    auto node_f = getvec<Elem>(nodes_to_f, node);
+    for (auto node_elem = nodes_to_elems.a2ab[node];
+        node_elem < nodes_to_elems.a2ab[node + 1]; ++node_elem) {
+      auto elem = nodes_to_elems.ab2b[node_elem];
+      auto force_elem = elems_to_force_elems[elem];
+      if (force_elem == -1) continue;
+      auto code = nodes_to_elems.codes[node_elem];
+      auto elem_node = Omega_h::code_which_down(code);
+      node_f += getvec<Elem>(elems_to_f, force_elem * Elem::nodes + elem_node);
+    }
+    setvec<Elem>(nodes_to_f, node, node_f);
+  };
+  parallel_for("element force kernel", sim.nodes(), std::move(functor));
+}
+
 template <class Elem>
 void compute_stress_divergence(Simulation& sim) {
   LGR_SCOPE(sim);
@@ -154,6 +186,9 @@ void compute_stress_divergence(Simulation& sim) {
     setvec<Elem>(nodes_to_f, node, node_f);
   };
   parallel_for("stress divergence kernel", sim.nodes(), std::move(functor));
+  for (auto fi : sim.element_forces) {
+    if (sim.has(fi)) add_element_force<Elem>(sim, fi);
+  }
 }
 
 template <class Elem>
@@ -0,0 +1,67 @@
+#include <lgr_mass_scaling.hpp>
+#include <lgr_simulation.hpp>
+#include <lgr_scope.hpp>
+#include <lgr_for.hpp>
+#include <Omega_h_array_ops.hpp>
+
+namespace lgr {
+
+MassScaling::MassScaling(Simulation& sim_in)
+  :sim(sim_in)
+  ,enabled(false)
+  ,target_time_step(0.0)
+  ,added_mass_fraction(0.0)
+{
+}
+
+void MassScaling::setup(Teuchos::ParameterList& pl) {
+  enabled = pl.isSublist("mass scaling");
+  if (!enabled) return;
+  if (sim.relaxation.enabled) {
+    Omega_h_fail("mass scaling can't be combined with dynamic relaxation,"
+        " which already chooses its own fictitious masses\n");
+  }
+  auto& scaling_pl = pl.sublist("mass scaling");
+  target_time_step = scaling_pl.get<double>("target time step");
+  sim.mass_scale = sim.fields.define("m_s", "mass scale", 1, ELEMS, true,
+      sim.disc.covering_class_names());
+}
+
+// at points where CFL * h / c is below the target time step,
+// the density is scaled by the square of the ratio, which slows the
+// wave speed by the same ratio.  the point time step is raised to match,
+// so this must run after compute_point_time_steps and before update_time.
+template <class Elem>
+void compute_selective_mass_scale(Simulation& sim) {
+  LGR_SCOPE(sim);
+  auto const points_to_dt = sim.getset(sim.point_time_step);
+  auto const points_to_rho = sim.get(sim.density);
+  auto const points_to_w = sim.get(sim.weight);
+  auto const points_to_scale = sim.set(sim.mass_scale);
+  auto const points_to_mass = Omega_h::Write<double>(sim.points());
+  auto const points_to_added_mass = Omega_h::Write<double>(sim.points());
+  auto const min_point_dt = sim.mass_scaling.target_time_step / sim.cfl;
+  auto functor = OMEGA_H_LAMBDA(int point) {
+    auto const point_dt = points_to_dt[point];
+    auto scale = 1.0;
+    if (point_dt < min_point_dt) {
+      scale = square(min_point_dt / point_dt);
+      points_to_dt[point] = min_point_dt;
+    }
+    points_to_scale[point] = scale;
+    auto const mass = points_to_rho[point] * points_to_w[point];
+    points_to_mass[point] = mass;
+    points_to_added_mass[point] = mass * (scale - 1.0);
+  };
+  parallel_for("selective mass scale kernel", sim.points(), std::move(functor));
+  auto const mass = Omega_h::get_sum(sim.comm, Omega_h::read(points_to_mass));
+  auto const added_mass = Omega_h::get_sum(sim.comm, Omega_h::read(points_to_added_mass));
+  sim.mass_scaling.added_mass_fraction = added_mass / mass;
+}
+
+#define LGR_EXPL_INST(Elem) \
+template void compute_selective_mass_scale<Elem>(Simulation& sim);
+LGR_EXPL_INST_ELEMS
+#undef LGR_EXPL_INST
+
+}
@@ -0,0 +1,33 @@
+#ifndef LGR_MASS_SCALING_HPP
+#define LGR_MASS_SCALING_HPP
+
+#include <Omega_h_teuchos.hpp>
+#include <lgr_element_types.hpp>
+
+namespace lgr {
+
+struct Simulation;
+
+// selective mass scaling adds mass only at integration points whose
+// stable time step is below a target, so that the global time step
+// does not drop below that target because of a few small elements
+struct MassScaling {
+  Simulation& sim;
+  bool enabled;
+  double target_time_step;
+  double added_mass_fraction;
+  MassScaling(Simulation& sim_in);
+  void setup(Teuchos::ParameterList& pl);
+};
+
+template <class Elem>
+void compute_selective_mass_scale(Simulation& sim);
+
+#define LGR_EXPL_INST(Elem) \
+extern template void compute_selective_mass_scale<Elem>(Simulation& sim);
+LGR_EXPL_INST_ELEMS
+#undef LGR_EXPL_INST
+
+}
+
+#endif
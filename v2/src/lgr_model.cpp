@@ -10,6 +10,7 @@ void ModelBase::out_of_line_virtual_function() {}
 
 ModelBase::ModelBase(Simulation& sim_in, ClassNames const& class_names)
 :sim(sim_in)
+,accumulated_time(0.0)
 {
   elem_support = sim.supports.get_support(ELEMS, false, class_names);
   point_support = sim.supports.get_support(ELEMS, true, class_names);
@@ -26,6 +26,8 @@ struct ModelBase {
   Simulation& sim;
   Support* elem_support;
   Support* point_support;
+  // wall time spent in this model's stages, used to weight load balancing
+  double accumulated_time;
   virtual ~ModelBase() = default;
   virtual void out_of_line_virtual_function();
   ModelBase(Simulation& sim_in, ClassNames const& class_names);
@@ -6,13 +6,28 @@
 #include <lgr_mie_gruneisen.hpp>
 #include <lgr_neo_hookean.hpp>
 #include <lgr_artificial_viscosity.hpp>
+#include <lgr_hourglass.hpp>
 #include <lgr_internal_energy.hpp>
 #include <lgr_deformation_gradient.hpp>
 #include <lgr_scope.hpp>
 #include <Omega_h_stack.hpp>
+#include <Omega_h_timer.hpp>
+#include <type_traits>
 
 namespace lgr {
 
+static void run_stage(Simulation& sim, std::vector<std::unique_ptr<ModelBase>>& models,
+    std::uint64_t stage, void (ModelBase::*stage_method)()) {
+  for (auto& model : models) {
+    if ((model->exec_stages() & stage) != 0) {
+      Scope scope{sim, model->name()};
+      auto const start = Omega_h::now();
+      ((*model).*stage_method)();
+      model->accumulated_time += (Omega_h::now() - start);
+    }
+  }
+}
+
 Models::Models(Simulation& sim_in)
   :sim(sim_in)
 {
@@ -43,62 +58,32 @@ void Models::setup_field_updates() {
 
 void Models::before_position_update() {
   OMEGA_H_TIME_FUNCTION;
-  for (auto& model : models) {
-    if ((model->exec_stages() & BEFORE_POSITION_UPDATE) != 0) {
-      Scope scope{sim, model->name()};
-      model->before_position_update();
-    }
-  }
+  run_stage(sim, models, BEFORE_POSITION_UPDATE, &ModelBase::before_position_update);
 }
 
 void Models::at_field_update() {
   OMEGA_H_TIME_FUNCTION;
-  for (auto& model : models) {
-    if ((model->exec_stages() & AT_FIELD_UPDATE) != 0) {
-      Scope scope{sim, model->name()};
-      model->at_field_update();
-    }
-  }
+  run_stage(sim, models, AT_FIELD_UPDATE, &ModelBase::at_field_update);
 }
 
 void Models::after_field_update() {
   OMEGA_H_TIME_FUNCTION;
-  for (auto& model : models) {
-    if ((model->exec_stages() & AFTER_FIELD_UPDATE) != 0) {
-      Scope scope{sim, model->name()};
-      model->after_field_update();
-    }
-  }
+  run_stage(sim, models, AFTER_FIELD_UPDATE, &ModelBase::after_field_update);
 }
 
 void Models::at_material_model() {
   OMEGA_H_TIME_FUNCTION;
-  for (auto& model : models) {
-    if ((model->exec_stages() & AT_MATERIAL_MODEL) != 0) {
-      Scope scope{sim, model->name()};
-      model->at_material_model();
-    }
-  }
+  run_stage(sim, models, AT_MATERIAL_MODEL, &ModelBase::at_material_model);
 }
 
 void Models::after_material_model() {
   OMEGA_H_TIME_FUNCTION;
-  for (auto& model : models) {
-    if ((model->exec_stages() & AFTER_MATERIAL_MODEL) != 0) {
-      Scope scope{sim, model->name()};
-      model->after_material_model();
-    }
-  }
+  run_stage(sim, models, AFTER_MATERIAL_MODEL, &ModelBase::after_material_model);
 }
 
 void Models::after_correction() {
   OMEGA_H_TIME_FUNCTION;
-  for (auto& model : models) {
-    if ((model->exec_stages() & AFTER_CORRECTION) != 0) {
-      Scope scope{sim, model->name()};
-      model->after_correction();
-    }
-  }
+  run_stage(sim, models, AFTER_CORRECTION, &ModelBase::after_correction);
 }
 
 template <class Elem>
@@ -116,6 +101,9 @@ template <class Elem>
 ModelFactories get_builtin_modifier_factories() {
   ModelFactories out;
   out["artificial viscosity"] = artificial_viscosity_factory<Elem>;
+  if (std::is_same<Elem, Hex8>::value) {
+    out["hourglass control"] = hourglass_control_factory;
+  }
   return out;
 }
 
@@ -0,0 +1,69 @@
+#include <lgr_probe_hist.hpp>
+#include <lgr_probes.hpp>
+#include <lgr_response.hpp>
+#include <lgr_simulation.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace lgr {
+
+// samples fields at points carried by the material and writes one
+// CSV row per output step; see Probes for how the points are tracked.
+struct ProbeHist : public Response {
+  Probes probes;
+  std::vector<FieldIndex> fields;
+  std::ofstream stream;
+  ProbeHist(Simulation& sim_in, Teuchos::ParameterList& pl)
+    :Response(sim_in, pl)
+    ,probes(sim_in, pl.get<Teuchos::Array<std::string>>("points").toVector(),
+        pl.get<double>("tolerance", 1e-10))
+  {
+    auto fields_teuchos = pl.get<Teuchos::Array<std::string>>("fields");
+    for (auto& field_name : fields_teuchos) fields.push_back(probes.find_field(field_name));
+    std::stringstream header_stream;
+    header_stream << "time";
+    for (int probe = 0; probe < probes.size(); ++probe) {
+      for (auto& field_name : fields_teuchos) {
+        auto const ncomps = sim.fields[sim.fields.find(field_name)].ncomps;
+        for (int comp = 0; comp < ncomps; ++comp) {
+          header_stream << ", " << field_name << '_' << comp << "(p" << probe << ')';
+        }
+      }
+    }
+    header_stream << '\n';
+    auto path = sim.output_path(pl.get<std::string>("path", "lgr_probes.csv"));
+    if (sim.comm->rank() == 0) {
+      stream.open(path.c_str());
+      OMEGA_H_CHECK(stream.is_open());
+      auto header_string = header_stream.str();
+      stream.write(header_string.data(), std::streamsize(header_string.length()));
+    }
+  }
+  void before_remap() override final {
+    probes.before_remap();
+  }
+  void respond() override final {
+    auto const values = probes.sample(fields);
+    if (sim.comm->rank() != 0) return;
+    std::stringstream step_stream;
+    step_stream << std::scientific << std::setprecision(17);
+    step_stream << sim.time;
+    for (auto value : values) step_stream << ", " << value;
+    step_stream << '\n';
+    auto step_string = step_stream.str();
+    stream.write(step_string.data(), std::streamsize(step_string.length()));
+  }
+  void out_of_line_virtual_method() override;
+};
+
+void ProbeHist::out_of_line_virtual_method() {}
+
+Response* probe_hist_factory(Simulation& sim, std::string const&,
+    Teuchos::ParameterList& pl)
+{
+  return new ProbeHist(sim, pl);
+}
+
+}
@@ -0,0 +1,16 @@
+#ifndef LGR_PROBE_HIST_HPP
+#define LGR_PROBE_HIST_HPP
+
+#include <Omega_h_teuchos.hpp>
+
+namespace lgr {
+
+struct Response;
+struct Simulation;
+
+Response* probe_hist_factory(Simulation& sim, std::string const&,
+    Teuchos::ParameterList& pl);
+
+}
+
+#endif
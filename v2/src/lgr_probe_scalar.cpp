@@ -0,0 +1,40 @@
+#include <lgr_probe_scalar.hpp>
+#include <lgr_probes.hpp>
+#include <lgr_scalar.hpp>
+#include <lgr_simulation.hpp>
+
+namespace lgr {
+
+// one component of a field at a point carried by the material
+struct ProbeScalar : public Scalar {
+  Probes probes;
+  FieldIndex fi;
+  int comp;
+  ProbeScalar(Simulation& sim_in, std::string const& name_in, Teuchos::ParameterList& pl)
+    :Scalar(sim_in, name_in)
+    ,probes(sim_in, {pl.get<std::string>("point")}, pl.get<double>("tolerance", 1e-10))
+  {
+    auto field_name = pl.get<std::string>("field");
+    fi = probes.find_field(field_name);
+    comp = pl.get<int>("component", 0);
+    if (comp < 0 || comp >= sim.fields[fi].ncomps) {
+      Omega_h_fail("ProbeScalar component %d is out of range for field %s\n",
+          comp, field_name.c_str());
+    }
+  }
+  void out_of_line_virtual_method() override;
+  void before_remap() override {
+    probes.before_remap();
+  }
+  double compute_value() override {
+    return probes.sample({fi})[std::size_t(comp)];
+  }
+};
+
+void ProbeScalar::out_of_line_virtual_method() {}
+
+Scalar* probe_scalar_factory(Simulation& sim, std::string const& name, Teuchos::ParameterList& pl) {
+  return new ProbeScalar(sim, name, pl);
+}
+
+}
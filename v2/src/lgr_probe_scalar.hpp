@@ -0,0 +1,15 @@
+#ifndef LGR_PROBE_SCALAR_HPP
+#define LGR_PROBE_SCALAR_HPP
+
+#include <Omega_h_teuchos.hpp>
+
+namespace lgr {
+
+struct Simulation;
+struct Scalar;
+
+Scalar* probe_scalar_factory(Simulation& sim, std::string const&, Teuchos::ParameterList& pl);
+
+}
+
+#endif
@@ -0,0 +1,319 @@
+#include <lgr_probes.hpp>
+#include <lgr_simulation.hpp>
+#include <lgr_subset.hpp>
+#include <lgr_support.hpp>
+#include <lgr_for.hpp>
+#include <Omega_h_expr.hpp>
+#include <Omega_h_matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace lgr {
+
+using ProbePoint = std::array<double, 3>;
+using Barycentric = std::array<double, 4>;
+
+struct ProbeBox {
+  ProbePoint lo;
+  ProbePoint hi;
+  ProbeBox() {
+    lo.fill(std::numeric_limits<double>::max());
+    hi.fill(std::numeric_limits<double>::lowest());
+  }
+  void expand(ProbeBox const& other) {
+    for (int i = 0; i < 3; ++i) {
+      lo[std::size_t(i)] = std::min(lo[std::size_t(i)], other.lo[std::size_t(i)]);
+      hi[std::size_t(i)] = std::max(hi[std::size_t(i)], other.hi[std::size_t(i)]);
+    }
+  }
+  bool contains(ProbePoint const& p) const {
+    for (std::size_t i = 0; i < 3; ++i) {
+      if (p[i] < lo[i] || hi[i] < p[i]) return false;
+    }
+    return true;
+  }
+};
+
+// bounding volume hierarchy over the element boxes.
+// it is only used to find a handful of probes, so it lives on the host.
+struct ElemBvh {
+  struct Node {
+    ProbeBox box;
+    int left;
+    int right;
+    int begin;
+    int end;
+  };
+  static constexpr int leaf_size = 4;
+  std::vector<ProbeBox> boxes;
+  std::vector<int> elems;
+  std::vector<Node> nodes;
+  void build(std::vector<ProbeBox>&& boxes_in) {
+    boxes = std::move(boxes_in);
+    elems.resize(boxes.size());
+    for (std::size_t i = 0; i < elems.size(); ++i) elems[i] = int(i);
+    nodes.clear();
+    if (!elems.empty()) build_node(0, int(elems.size()));
+  }
+  double center(int elem, std::size_t axis) const {
+    auto& box = boxes[std::size_t(elem)];
+    return (box.lo[axis] + box.hi[axis]) / 2.0;
+  }
+  int build_node(int begin, int end) {
+    Node node;
+    node.left = node.right = -1;
+    node.begin = begin;
+    node.end = end;
+    for (int i = begin; i < end; ++i) node.box.expand(boxes[std::size_t(elems[std::size_t(i)])]);
+    auto const index = int(nodes.size());
+    nodes.push_back(node);
+    if (end - begin <= leaf_size) return index;
+    // split at the median of the element centers along the longest axis
+    std::size_t axis = 0;
+    for (std::size_t i = 1; i < 3; ++i) {
+      if (node.box.hi[i] - node.box.lo[i] > node.box.hi[axis] - node.box.lo[axis]) axis = i;
+    }
+    auto const middle = begin + (end - begin) / 2;
+    std::nth_element(elems.begin() + begin, elems.begin() + middle, elems.begin() + end,
+        [&](int a, int b) { return center(a, axis) < center(b, axis); });
+    auto const left = build_node(begin, middle);
+    auto const right = build_node(middle, end);
+    nodes[std::size_t(index)].left = left;
+    nodes[std::size_t(index)].right = right;
+    return index;
+  }
+  void find_candidates(ProbePoint const& p, std::vector<int>& out) const {
+    out.clear();
+    if (nodes.empty()) return;
+    std::vector<int> stack(1, 0);
+    while (!stack.empty()) {
+      auto const& node = nodes[std::size_t(stack.back())];
+      stack.pop_back();
+      if (!node.box.contains(p)) continue;
+      if (node.left == -1) {
+        for (int i = node.begin; i < node.end; ++i) {
+          auto const elem = elems[std::size_t(i)];
+          if (boxes[std::size_t(elem)].contains(p)) out.push_back(elem);
+        }
+      } else {
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+      }
+    }
+  }
+};
+
+template <int dim>
+static ProbePoint read_probe_point_dim(Omega_h::any const& value) {
+  auto const v = Omega_h::any_cast<Omega_h::Vector<dim>>(value);
+  ProbePoint p = {{0.0, 0.0, 0.0}};
+  for (int i = 0; i < dim; ++i) p[std::size_t(i)] = v[i];
+  return p;
+}
+
+static ProbePoint read_probe_point(std::string const& expr, int dim) {
+  Omega_h::ExprOpsReader reader;
+  auto op = reader.read_ops(expr);
+  Omega_h::ExprEnv env(1, dim);
+  auto const value = op->eval(env);
+  if (dim == 1) return read_probe_point_dim<1>(value);
+  if (dim == 2) return read_probe_point_dim<2>(value);
+  return read_probe_point_dim<3>(value);
+}
+
+template <int dim>
+static Barycentric barycentric_dim(Omega_h::HostRead<double> const& nodes_to_x,
+    Omega_h::HostRead<int> const& elems_to_nodes, int elem, ProbePoint const& p) {
+  Omega_h::Matrix<dim, dim> jacobian;
+  Omega_h::Vector<dim> rhs;
+  auto const node0 = elems_to_nodes[elem * (dim + 1)];
+  for (int j = 0; j < dim; ++j) {
+    auto const node = elems_to_nodes[elem * (dim + 1) + j + 1];
+    for (int i = 0; i < dim; ++i) {
+      jacobian[j][i] = nodes_to_x[node * dim + i] - nodes_to_x[node0 * dim + i];
+    }
+  }
+  for (int i = 0; i < dim; ++i) rhs[i] = p[std::size_t(i)] - nodes_to_x[node0 * dim + i];
+  auto const xi = Omega_h::invert(jacobian) * rhs;
+  Barycentric out = {{1.0, 0.0, 0.0, 0.0}};
+  for (int j = 0; j < dim; ++j) {
+    out[std::size_t(j + 1)] = xi[j];
+    out[0] -= xi[j];
+  }
+  return out;
+}
+
+static Barycentric barycentric(Omega_h::HostRead<double> const& nodes_to_x,
+    Omega_h::HostRead<int> const& elems_to_nodes, int dim, int elem, ProbePoint const& p) {
+  if (dim == 1) return barycentric_dim<1>(nodes_to_x, elems_to_nodes, elem, p);
+  if (dim == 2) return barycentric_dim<2>(nodes_to_x, elems_to_nodes, elem, p);
+  return barycentric_dim<3>(nodes_to_x, elems_to_nodes, elem, p);
+}
+
+Probes::Probes(Simulation& sim_in, std::vector<std::string> const& expressions,
+    double tolerance_in)
+  :sim(sim_in)
+  ,dim(sim_in.dim())
+  ,tolerance(tolerance_in)
+  ,is_located(false)
+{
+  if (!sim.disc.is_simplex_ || sim.disc.has_edge_nodes()) {
+    Omega_h_fail("probes need linear simplex elements, not %s\n", sim.elem_name.c_str());
+  }
+  for (auto& expr : expressions) points.push_back(read_probe_point(expr, dim));
+  locate();
+}
+
+int Probes::size() const {
+  return int(points.size());
+}
+
+FieldIndex Probes::find_field(std::string const& name) {
+  auto const fi = sim.fields.find(name);
+  if (!fi.is_valid()) {
+    Omega_h_fail("probe field \"%s\" doesn't exist\n", name.c_str());
+  }
+  auto& field = sim.fields[fi];
+  if (field.entity_type != NODES && field.entity_type != ELEMS) {
+    Omega_h_fail("probe field \"%s\" is not on nodes or elements\n", name.c_str());
+  }
+  if (!field.support->subset->mapping.is_identity) {
+    Omega_h_fail("probes don't yet support fields (%s) on a subset of the mesh!\n",
+        name.c_str());
+  }
+  return fi;
+}
+
+// the only step that copies mesh arrays to the host,
+// run at setup and after each remap
+void Probes::locate() {
+  OMEGA_H_TIME_FUNCTION;
+  auto const nodes_to_x = Omega_h::HostRead<double>(sim.get(sim.position));
+  auto const elems_to_nodes = Omega_h::HostRead<int>(sim.elems_to_nodes());
+  auto const nelems = sim.elems();
+  std::vector<ProbeBox> boxes(std::size_t(nelems), ProbeBox());
+  for (int elem = 0; elem < nelems; ++elem) {
+    auto& box = boxes[std::size_t(elem)];
+    for (int elem_node = 0; elem_node <= dim; ++elem_node) {
+      auto const node = elems_to_nodes[elem * (dim + 1) + elem_node];
+      for (int i = 0; i < 3; ++i) {
+        auto const x = (i < dim) ? nodes_to_x[node * dim + i] : 0.0;
+        box.lo[std::size_t(i)] = std::min(box.lo[std::size_t(i)], x - tolerance);
+        box.hi[std::size_t(i)] = std::max(box.hi[std::size_t(i)], x + tolerance);
+      }
+    }
+  }
+  ElemBvh bvh;
+  bvh.build(std::move(boxes));
+  auto const nprobes = size();
+  Omega_h::HostWrite<int> host_elems(nprobes, "probe elements");
+  Omega_h::HostWrite<double> host_weights(nprobes * (dim + 1), "probe weights");
+  std::vector<int> candidates;
+  for (int probe = 0; probe < nprobes; ++probe) {
+    auto const& point = points[std::size_t(probe)];
+    bvh.find_candidates(point, candidates);
+    host_elems[probe] = -1;
+    for (int i = 0; i <= dim; ++i) host_weights[probe * (dim + 1) + i] = 0.0;
+    double best = -tolerance;
+    for (auto elem : candidates) {
+      auto const lambda = barycentric(nodes_to_x, elems_to_nodes, dim, elem, point);
+      auto const min_lambda = *std::min_element(lambda.begin(), lambda.begin() + dim + 1);
+      if (min_lambda >= best) {
+        best = min_lambda;
+        host_elems[probe] = elem;
+        for (int i = 0; i <= dim; ++i) {
+          host_weights[probe * (dim + 1) + i] = lambda[std::size_t(i)];
+        }
+      }
+    }
+  }
+  elems = Omega_h::LOs(host_elems.write());
+  weights = Omega_h::Reals(host_weights.write());
+  is_located = true;
+}
+
+// adapt and ALE change the mesh under the material, which leaves
+// the cached elements and weights meaningless. the probes keep
+// following the material from where it is right before the remap.
+void Probes::before_remap() {
+  auto const positions = sample({sim.position});
+  for (int probe = 0; probe < size(); ++probe) {
+    if (std::isnan(positions[std::size_t(probe * dim)])) continue;
+    for (int i = 0; i < dim; ++i) {
+      points[std::size_t(probe)][std::size_t(i)] = positions[std::size_t(probe * dim + i)];
+    }
+  }
+  is_located = false;
+}
+
+std::vector<double> Probes::sample(std::vector<FieldIndex> const& fields) {
+  OMEGA_H_TIME_FUNCTION;
+  if (!is_located) locate();
+  auto const nprobes = size();
+  int ncolumns = 0;
+  for (auto fi : fields) ncolumns += sim.fields[fi].ncomps;
+  // the last entries count how many ranks hold each probe
+  auto const sums = Omega_h::Write<double>(nprobes * ncolumns + nprobes, 0.0, "probe sums");
+  auto const probes_to_elems = elems;
+  auto const probes_to_weights = weights;
+  auto const elems_to_nodes = sim.elems_to_nodes();
+  auto const nodes_per_elem = dim + 1;
+  int first_column = 0;
+  for (auto fi : fields) {
+    auto& field = sim.fields[fi];
+    auto const data = sim.get(fi);
+    auto const ncomps = field.ncomps;
+    if (field.entity_type == NODES) {
+      auto functor = OMEGA_H_LAMBDA(int probe) {
+        auto const elem = probes_to_elems[probe];
+        if (elem == -1) return;
+        for (int comp = 0; comp < ncomps; ++comp) {
+          double value = 0.0;
+          for (int elem_node = 0; elem_node < nodes_per_elem; ++elem_node) {
+            auto const node = elems_to_nodes[elem * nodes_per_elem + elem_node];
+            value += probes_to_weights[probe * nodes_per_elem + elem_node] *
+              data[node * ncomps + comp];
+          }
+          sums[probe * ncolumns + first_column + comp] = value;
+        }
+      };
+      parallel_for("probe nodal field kernel", nprobes, std::move(functor));
+    } else {
+      auto const npoints = field.on_points ? sim.disc.points_per_ent(ELEMS) : 1;
+      auto functor = OMEGA_H_LAMBDA(int probe) {
+        auto const elem = probes_to_elems[probe];
+        if (elem == -1) return;
+        for (int comp = 0; comp < ncomps; ++comp) {
+          double value = 0.0;
+          for (int elem_pt = 0; elem_pt < npoints; ++elem_pt) {
+            value += data[(elem * npoints + elem_pt) * ncomps + comp];
+          }
+          sums[probe * ncolumns + first_column + comp] = value / npoints;
+        }
+      };
+      parallel_for("probe element field kernel", nprobes, std::move(functor));
+    }
+    first_column += ncomps;
+  }
+  auto count_functor = OMEGA_H_LAMBDA(int probe) {
+    sums[nprobes * ncolumns + probe] = (probes_to_elems[probe] == -1) ? 0.0 : 1.0;
+  };
+  parallel_for("probe count kernel", nprobes, std::move(count_functor));
+  // probes on partition boundaries may be held by several ranks
+  auto const all_sums = Omega_h::HostRead<double>(
+      sim.comm->allreduce(Omega_h::read(sums), OMEGA_H_SUM));
+  std::vector<double> values(std::size_t(nprobes * ncolumns));
+  for (int probe = 0; probe < nprobes; ++probe) {
+    auto const count = all_sums[nprobes * ncolumns + probe];
+    for (int column = 0; column < ncolumns; ++column) {
+      values[std::size_t(probe * ncolumns + column)] = (count > 0.0) ?
+        (all_sums[probe * ncolumns + column] / count) :
+        std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+  return values;
+}
+
+}
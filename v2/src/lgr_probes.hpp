@@ -0,0 +1,43 @@
+#ifndef LGR_PROBES_HPP
+#define LGR_PROBES_HPP
+
+#include <lgr_field_index.hpp>
+#include <Omega_h_array.hpp>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace lgr {
+
+struct Simulation;
+
+// a few points carried by the material, at which fields are sampled.
+// the points are given in the initial configuration. each probe caches
+// the element holding it and its barycentric coordinates, so sampling
+// is a small kernel per field and only the probe values leave the device.
+// the cache is rebuilt only when adapt or ALE move the mesh under the
+// material, at the positions the probes had just before that remap.
+struct Probes {
+  Simulation& sim;
+  int dim;
+  double tolerance;
+  std::vector<std::array<double, 3>> points;
+  // -1 for probes not held by this rank
+  Omega_h::LOs elems;
+  // (dim + 1) barycentric coordinates per probe
+  Omega_h::Reals weights;
+  bool is_located;
+  Probes(Simulation& sim_in, std::vector<std::string> const& expressions, double tolerance_in);
+  int size() const;
+  // a nodal or element field that can be sampled at the probes
+  FieldIndex find_field(std::string const& name);
+  void locate();
+  void before_remap();
+  // values of all fields at each probe, averaged over the ranks holding
+  // the probe, NaN for probes no rank holds
+  std::vector<double> sample(std::vector<FieldIndex> const& fields);
+};
+
+}
+
+#endif
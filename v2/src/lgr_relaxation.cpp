@@ -0,0 +1,104 @@
+#include <lgr_relaxation.hpp>
+#include <lgr_simulation.hpp>
+#include <lgr_scope.hpp>
+#include <lgr_for.hpp>
+#include <Omega_h_array_ops.hpp>
+
+namespace lgr {
+
+Relaxation::Relaxation(Simulation& sim_in)
+  :sim(sim_in)
+  ,enabled(false)
+  ,time_step(1.0)
+  ,mass_update_interval(1)
+  ,relative_tolerance(0.0)
+  ,absolute_tolerance(0.0)
+  ,reference_residual(0.0)
+  ,residual(0.0)
+  ,kinetic_energy(0.0)
+  ,damping_resets(0)
+{
+}
+
+void Relaxation::setup(Teuchos::ParameterList& pl) {
+  enabled = pl.isSublist("dynamic relaxation");
+  if (!enabled) return;
+  auto& relax_pl = pl.sublist("dynamic relaxation");
+  time_step = relax_pl.get<double>("time step", 1.0);
+  mass_update_interval = relax_pl.get<int>("mass update interval", 1);
+  relative_tolerance = relax_pl.get<double>("relative tolerance", 1.0e-6);
+  absolute_tolerance = relax_pl.get<double>("absolute tolerance", 0.0);
+  sim.mass_scale = sim.fields.define("m_s", "mass scale", 1, ELEMS, true,
+      sim.disc.covering_class_names());
+}
+
+bool Relaxation::has_converged() {
+  return residual <= Omega_h::max2(absolute_tolerance,
+      relative_tolerance * reference_residual);
+}
+
+bool Relaxation::is_mass_update_due() {
+  return mass_update_interval > 0 && (sim.step % mass_update_interval) == 0;
+}
+
+// chooses the density scaling at each point that makes its
+// stable time step equal to the pseudo time step:
+// CFL * h / (c / sqrt(s)) = dt
+template <class Elem>
+void compute_relaxation_mass_scale(Simulation& sim) {
+  LGR_SCOPE(sim);
+  auto const points_to_dt = sim.get(sim.point_time_step);
+  auto const points_to_scale = sim.set(sim.mass_scale);
+  auto const ratio = sim.relaxation.time_step / sim.cfl;
+  double const max = std::numeric_limits<double>::max();
+  auto functor = OMEGA_H_LAMBDA(int point) {
+    auto const point_dt = points_to_dt[point];
+    // points without a wave speed have no stiffness to stabilize
+    points_to_scale[point] = (point_dt == max) ? 1.0 : square(ratio / point_dt);
+  };
+  parallel_for("relaxation mass scale kernel", sim.points(), std::move(functor));
+}
+
+template <class Elem>
+double compute_kinetic_energy(Simulation& sim) {
+  LGR_SCOPE(sim);
+  auto const nodes_to_v = sim.get(sim.velocity);
+  auto const nodes_to_m = sim.get(sim.nodal_mass);
+  auto const nodes_to_ke = Omega_h::Write<double>(sim.nodes());
+  auto functor = OMEGA_H_LAMBDA(int node) {
+    auto const v = getvec<Elem>(nodes_to_v, node);
+    nodes_to_ke[node] = (1.0 / 2.0) * nodes_to_m[node] * (v * v);
+  };
+  parallel_for("kinetic energy kernel", sim.nodes(), std::move(functor));
+  return Omega_h::get_sum(sim.comm, Omega_h::read(nodes_to_ke));
+}
+
+// the out-of-balance force is m * a after acceleration conditions
+// have been applied, which excludes the reactions at constrained nodes
+template <class Elem>
+double compute_residual_norm(Simulation& sim) {
+  LGR_SCOPE(sim);
+  auto const nodes_to_a = sim.get(sim.acceleration);
+  auto const nodes_to_m = sim.get(sim.nodal_mass);
+  auto const nodes_to_r2 = Omega_h::Write<double>(sim.nodes());
+  auto functor = OMEGA_H_LAMBDA(int node) {
+    auto const r = nodes_to_m[node] * getvec<Elem>(nodes_to_a, node);
+    nodes_to_r2[node] = r * r;
+  };
+  parallel_for("residual norm kernel", sim.nodes(), std::move(functor));
+  return std::sqrt(Omega_h::get_sum(sim.comm, Omega_h::read(nodes_to_r2)));
+}
+
+void zero_velocity(Simulation& sim) {
+  LGR_SCOPE(sim);
+  Omega_h::fill(sim.getset(sim.velocity), 0.0);
+}
+
+#define LGR_EXPL_INST(Elem) \
+template void compute_relaxation_mass_scale<Elem>(Simulation& sim); \
+template double compute_kinetic_energy<Elem>(Simulation& sim); \
+template double compute_residual_norm<Elem>(Simulation& sim);
+LGR_EXPL_INST_ELEMS
+#undef LGR_EXPL_INST
+
+}
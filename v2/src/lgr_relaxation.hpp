@@ -0,0 +1,51 @@
+#ifndef LGR_RELAXATION_HPP
+#define LGR_RELAXATION_HPP
+
+#include <Omega_h_teuchos.hpp>
+#include <lgr_element_types.hpp>
+
+namespace lgr {
+
+struct Simulation;
+
+// dynamic relaxation drives a quasi-static problem to equilibrium
+// by explicit pseudo-time stepping with fictitious masses (scaled so that
+// every integration point is stable at the same pseudo time step)
+// and kinetic damping (velocities are zeroed at each peak of kinetic energy)
+struct Relaxation {
+  Simulation& sim;
+  bool enabled;
+  double time_step;
+  // steps between rescaling the fictitious masses to the deformed mesh
+  int mass_update_interval;
+  double relative_tolerance;
+  double absolute_tolerance;
+  // largest residual norm seen so far, the scale for the relative tolerance
+  double reference_residual;
+  double residual;
+  double kinetic_energy;
+  int damping_resets;
+  Relaxation(Simulation& sim_in);
+  void setup(Teuchos::ParameterList& pl);
+  bool has_converged();
+  bool is_mass_update_due();
+};
+
+template <class Elem>
+void compute_relaxation_mass_scale(Simulation& sim);
+template <class Elem>
+double compute_kinetic_energy(Simulation& sim);
+template <class Elem>
+double compute_residual_norm(Simulation& sim);
+void zero_velocity(Simulation& sim);
+
+#define LGR_EXPL_INST(Elem) \
+extern template void compute_relaxation_mass_scale<Elem>(Simulation& sim); \
+extern template double compute_kinetic_energy<Elem>(Simulation& sim); \
+extern template double compute_residual_norm<Elem>(Simulation& sim);
+LGR_EXPL_INST_ELEMS
+#undef LGR_EXPL_INST
+
+}
+
+#endif
@@ -4,23 +4,121 @@
 
 namespace lgr {
 
+// the weighted remaps accumulate this many packed components per walk
+// over a key's adjacency, which covers all of them for the usual fields
+constexpr int remap_chunk_width = 32;
+
+int PackedFields::offset_of(FieldIndex fi) const {
+  for (std::size_t i = 0; i < field_indices.size(); ++i) {
+    if (field_indices[i].storage_index == fi.storage_index) return offsets[i];
+  }
+  return -1;
+}
+
 RemapBase::RemapBase(Simulation& sim_in):sim(sim_in) {
-  for (auto& field_ptr : sim.fields.storage) {
-    if (field_ptr->remap_type != RemapType::NONE) {
-      fields_to_remap[field_ptr->remap_type].push_back(field_ptr->long_name);
-      field_indices_to_remap.push_back(sim.fields.find(field_ptr->long_name));
-      if (field_ptr->remap_type == RemapType::POSITIVE_DETERMINANT) {
-        fields_to_remap[RemapType::PER_UNIT_VOLUME].push_back(field_ptr->long_name);
-      }
+  for (std::size_t i = 0; i < sim.fields.storage.size(); ++i) {
+    auto& field = *(sim.fields.storage[i]);
+    FieldIndex fi;
+    fi.storage_index = i;
+    auto packed_type = field.remap_type;
+    if (packed_type == RemapType::NONE) continue;
+    if (packed_type == RemapType::SHAPE) {
+      shape_field_indices.push_back(fi);
+      continue;
+    }
+    if (packed_type == RemapType::POSITIVE_DETERMINANT) {
+      positive_determinant_field_indices.push_back(fi);
+      packed_type = RemapType::PER_UNIT_VOLUME;
     }
+    auto& packed = packed_fields[packed_type];
+    packed.field_indices.push_back(fi);
+    packed.offsets.push_back(packed.width);
+    packed.width += field.ncomps;
   }
 }
 
 void RemapBase::out_of_line_virtual_method() {}
 
+static char const* packed_tag_name(RemapType type) {
+  switch (type) {
+    case RemapType::NODAL: return "packed nodal remap";
+    case RemapType::PER_UNIT_VOLUME: return "packed per unit volume remap";
+    case RemapType::PER_UNIT_MASS: return "packed per unit mass remap";
+    default: OMEGA_H_NORETURN(nullptr);
+  }
+}
+
+static int packed_ent_dim(Simulation& sim, RemapType type) {
+  // linear specific!
+  return (type == RemapType::NODAL) ? 0 : sim.dim();
+}
+
+static int packed_points_per_ent(Simulation& sim, RemapType type) {
+  return (type == RemapType::NODAL) ? 1 : sim.disc.points_per_ent(ELEMS);
+}
+
+// interleaves the fields into one array with (width) values per node
+// or integration point.  element fields that are not on integration points
+// are replicated at each point of their element.
+static Omega_h::Reals pack_fields(Simulation& sim, RemapType type, PackedFields const& packed) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const ent_dim = packed_ent_dim(sim, type);
+  auto const points_per_ent = packed_points_per_ent(sim, type);
+  auto const width = packed.width;
+  auto const out = Omega_h::Write<double>(
+      sim.disc.mesh.nents(ent_dim) * points_per_ent * width, 0.0);
+  for (std::size_t i = 0; i < packed.field_indices.size(); ++i) {
+    auto& field = sim.fields[packed.field_indices[i]];
+    auto const offset = packed.offsets[i];
+    auto const ncomps = field.ncomps;
+    auto const field_points = field.on_points ? points_per_ent : 1;
+    auto const mapping = field.support->subset->mapping;
+    auto const data = field.get();
+    auto functor = OMEGA_H_LAMBDA(int field_ent) {
+      auto const ent = mapping[field_ent];
+      for (int ent_pt = 0; ent_pt < points_per_ent; ++ent_pt) {
+        auto const field_pt = (field_points == 1) ? 0 : ent_pt;
+        for (int comp = 0; comp < ncomps; ++comp) {
+          out[(ent * points_per_ent + ent_pt) * width + offset + comp] =
+            data[(field_ent * field_points + field_pt) * ncomps + comp];
+        }
+      }
+    };
+    parallel_for("pack remap field", field.support->subset->count(), std::move(functor));
+  }
+  return out;
+}
+
+static void unpack_fields(Simulation& sim, RemapType type, PackedFields const& packed,
+    Omega_h::Reals packed_data) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const points_per_ent = packed_points_per_ent(sim, type);
+  auto const width = packed.width;
+  for (std::size_t i = 0; i < packed.field_indices.size(); ++i) {
+    auto& field = sim.fields[packed.field_indices[i]];
+    auto const offset = packed.offsets[i];
+    auto const ncomps = field.ncomps;
+    auto const field_points = field.on_points ? points_per_ent : 1;
+    auto const mapping = field.support->subset->mapping;
+    auto const nfield_ents = field.support->subset->count();
+    auto const data = Omega_h::Write<double>(nfield_ents * field_points * ncomps, field.long_name);
+    auto functor = OMEGA_H_LAMBDA(int field_ent) {
+      auto const ent = mapping[field_ent];
+      for (int field_pt = 0; field_pt < field_points; ++field_pt) {
+        for (int comp = 0; comp < ncomps; ++comp) {
+          data[(field_ent * field_points + field_pt) * ncomps + comp] =
+            packed_data[(ent * points_per_ent + field_pt) * width + offset + comp];
+        }
+      }
+    };
+    parallel_for("unpack remap field", nfield_ents, std::move(functor));
+    field.storage = data;
+  }
+}
+
 struct VolumeWeighter {
   Omega_h::Reals points_to_w;
-  VolumeWeighter(Omega_h::Mesh& mesh) {
+  VolumeWeighter(Omega_h::Mesh& mesh, RemapBase&) {
     points_to_w = mesh.get_array<double>(mesh.dim(), "weight");
   }
   OMEGA_H_INLINE double get_weight(int point) const {
@@ -30,13 +128,20 @@ struct VolumeWeighter {
 
 struct MassWeighter {
   Omega_h::Reals points_to_w;
-  Omega_h::Reals points_to_rho;
-  MassWeighter(Omega_h::Mesh& mesh) {
+  Omega_h::Reals points_to_packed;
+  int rho_offset;
+  int width;
+  MassWeighter(Omega_h::Mesh& mesh, RemapBase& remap) {
+    auto& packed = remap.packed_fields[RemapType::PER_UNIT_VOLUME];
     points_to_w = mesh.get_array<double>(mesh.dim(), "weight");
-    points_to_rho = mesh.get_array<double>(mesh.dim(), "density");
+    points_to_packed = mesh.get_array<double>(mesh.dim(),
+        packed_tag_name(RemapType::PER_UNIT_VOLUME));
+    rho_offset = packed.offset_of(remap.sim.density);
+    OMEGA_H_CHECK(rho_offset >= 0);
+    width = packed.width;
   }
   OMEGA_H_INLINE double get_weight(int point) const {
-    return points_to_w[point] * points_to_rho[point];
+    return points_to_w[point] * points_to_packed[point * width + rho_offset];
   }
 };
 
@@ -65,8 +170,7 @@ template <class Elem>
 struct Remap : public RemapBase {
   Remap(Simulation& sim_in):RemapBase(sim_in) {}
   void before_adapt() override final {
-    for (auto& name : fields_to_remap[RemapType::POSITIVE_DETERMINANT]) {
-      auto fi = sim.fields.find(name);
+    for (auto fi : positive_determinant_field_indices) {
       auto points_to_F = sim.getset(fi);
       auto npoints = sim.fields[fi].support->count();
       auto functor = OMEGA_H_LAMBDA(int point) {
@@ -77,7 +181,16 @@ struct Remap : public RemapBase {
       };
       parallel_for("log(F)", npoints, std::move(functor));
     }
-    sim.fields.copy_to_omega_h(sim.disc, field_indices_to_remap);
+    sim.fields.copy_to_omega_h(sim.disc, shape_field_indices);
+    for (auto& type_packed : packed_fields) {
+      auto const type = type_packed.first;
+      auto& packed = type_packed.second;
+      if (packed.width == 0) continue;
+      auto const ent_dim = packed_ent_dim(sim, type);
+      auto const ncomps = packed.width * packed_points_per_ent(sim, type);
+      sim.disc.mesh.add_tag(ent_dim, packed_tag_name(type), ncomps,
+          pack_fields(sim, type, packed));
+    }
   }
   Omega_h::Write<double> allocate_and_fill_with_same(Omega_h::Mesh& new_mesh, int ent_dim, int ncomps,
       Omega_h::LOs same_ents2old_ents, Omega_h::LOs same_ents2new_ents,
@@ -133,45 +246,49 @@ struct Remap : public RemapBase {
     new_mesh.add_tag(new_mesh.dim(), "time step length", 1, Omega_h::read(new_dt_h));
     new_mesh.add_tag(new_mesh.dim(), "viscosity length", 1, Omega_h::read(new_visc_h));
   }
-  template <class Weighter, int ncomps>
-  void refine_point_remap_ncomps(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh, int key_dim, int prod_dim,
+  template <class Weighter>
+  void refine_point_remap(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh, int key_dim, int prod_dim,
       Omega_h::LOs keys2kds, Omega_h::LOs keys2prods, Omega_h::LOs prods2new_ents,
       Omega_h::LOs same_ents2old_ents, Omega_h::LOs same_ents2new_ents,
-      Omega_h::Tag<double> const* tag) {
+      RemapType type) {
+    auto const width = packed_fields[type].width;
+    if (width == 0) return;
+    auto tag = old_mesh.get_tag<double>(prod_dim, packed_tag_name(type));
     auto old_data = tag->array();
     auto new_data = allocate_and_fill_with_same(
         new_mesh, new_mesh.dim(), tag->ncomps(), same_ents2old_ents, same_ents2new_ents, old_data);
     auto kds2doms = old_mesh.ask_graph(key_dim, prod_dim);
-    Weighter weighter(old_mesh);
+    Weighter weighter(old_mesh, *this);
     auto new_functor = OMEGA_H_LAMBDA(int key) {
       auto kd = keys2kds[key];
       auto prod = keys2prods[key];
       for (auto kd_dom = kds2doms.a2ab[kd];
            kd_dom < kds2doms.a2ab[kd + 1]; ++kd_dom) {
         auto dom = kds2doms.ab2b[kd_dom];
-        auto value = zero_vector<ncomps>();
-        auto weight_sum = 0.0;
-        for (int dom_pt = 0; dom_pt < Elem::points; ++dom_pt) {
-          auto old_point = dom * Elem::points + dom_pt;
-          auto old_weight = weighter.get_weight(old_point);
-          weight_sum += old_weight;
-          for (int comp = 0; comp < ncomps; ++comp) {
-            value[comp] += old_weight * old_data[old_point * ncomps + comp];
-          }
-        }
-        for (int comp = 0; comp < ncomps; ++comp) {
-          value[comp] /= weight_sum;
-        }
-        for (int child = 0; child < 2; ++child) {
-          auto new_elem = prods2new_ents[prod];
-          for (int child_pt = 0; child_pt < Elem::points; ++child_pt) {
-            auto new_point = new_elem * Elem::points + child_pt;
+        for (int first = 0; first < width; first += remap_chunk_width) {
+          auto const ncomps = Omega_h::min2(remap_chunk_width, width - first);
+          double values[remap_chunk_width];
+          for (int comp = 0; comp < ncomps; ++comp) values[comp] = 0.0;
+          auto weight_sum = 0.0;
+          for (int dom_pt = 0; dom_pt < Elem::points; ++dom_pt) {
+            auto old_point = dom * Elem::points + dom_pt;
+            auto const weight = weighter.get_weight(old_point);
+            weight_sum += weight;
             for (int comp = 0; comp < ncomps; ++comp) {
-              new_data[new_point * ncomps + comp] = value[comp];
+              values[comp] += weight * old_data[old_point * width + first + comp];
+            }
+          }
+          for (int child = 0; child < 2; ++child) {
+            auto new_elem = prods2new_ents[prod + child];
+            for (int child_pt = 0; child_pt < Elem::points; ++child_pt) {
+              auto new_point = new_elem * Elem::points + child_pt;
+              for (int comp = 0; comp < ncomps; ++comp) {
+                new_data[new_point * width + first + comp] = values[comp] / weight_sum;
+              }
             }
           }
-          ++prod;
         }
+        prod += 2;
       }
     };
     parallel_for("refine point remap", keys2kds.size(), std::move(new_functor));
@@ -183,13 +300,13 @@ struct Remap : public RemapBase {
       Omega_h::LOs key_doms2doms,
       Omega_h::LOs prods2new_ents,
       Omega_h::LOs same_ents2old_ents, Omega_h::LOs same_ents2new_ents,
-      std::string const& name) {
-    auto tag = old_mesh.get_tag<double>(prod_dim, name);
+      RemapType type) {
+    if (packed_fields[type].width == 0) return;
+    auto tag = old_mesh.get_tag<double>(prod_dim, packed_tag_name(type));
     auto old_data = tag->array();
-    auto ncomps = divide_no_remainder(
-        tag->ncomps(), Elem::points);
+    auto ncomps = tag->ncomps();
     auto new_data = allocate_and_fill_with_same(
-        new_mesh, new_mesh.dim(), tag->ncomps(),
+        new_mesh, new_mesh.dim(), ncomps,
         same_ents2old_ents, same_ents2new_ents, old_data);
     auto new_functor = OMEGA_H_LAMBDA(int key) {
       for (auto prod = keys2prods[key];
@@ -197,53 +314,53 @@ struct Remap : public RemapBase {
         auto const key_dom = prod;
         auto const old_elem = key_doms2doms[key_dom];
         auto const new_elem = prods2new_ents[prod];
-        for (int elem_pt = 0; elem_pt < Elem::points; ++elem_pt) {
-          auto const old_pt = old_elem * Elem::points + elem_pt;
-          auto const new_pt = new_elem * Elem::points + elem_pt;
-          for (int comp = 0; comp < ncomps; ++comp) {
-            new_data[new_pt * ncomps + comp] = old_data[old_pt * ncomps + comp];
-          }
+        for (int comp = 0; comp < ncomps; ++comp) {
+          new_data[new_elem * ncomps + comp] = old_data[old_elem * ncomps + comp];
         }
       }
     };
     parallel_for("coarsen point remap", keys2prods.size() - 1, std::move(new_functor));
     new_mesh.add_tag(new_mesh.dim(), tag->name(), tag->ncomps(), Omega_h::read(new_data));
   }
-  template <class Weighter, int ncomps>
-  void swap_point_remap_ncomps(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh, int key_dim, int prod_dim,
+  template <class Weighter>
+  void swap_point_remap(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh, int key_dim, int prod_dim,
       Omega_h::LOs keys2kds, Omega_h::LOs keys2prods, Omega_h::LOs prods2new_ents,
       Omega_h::LOs same_ents2old_ents, Omega_h::LOs same_ents2new_ents,
-      Omega_h::Tag<double> const* tag) {
+      RemapType type) {
+    auto const width = packed_fields[type].width;
+    if (width == 0) return;
+    auto tag = old_mesh.get_tag<double>(prod_dim, packed_tag_name(type));
     auto old_data = tag->array();
     auto new_data = allocate_and_fill_with_same(
         new_mesh, new_mesh.dim(), tag->ncomps(), same_ents2old_ents, same_ents2new_ents, old_data);
     auto kds2doms = old_mesh.ask_graph(key_dim, prod_dim);
-    Weighter weighter(old_mesh);
+    Weighter weighter(old_mesh, *this);
     auto new_functor = OMEGA_H_LAMBDA(int key) {
       auto kd = keys2kds[key];
-      auto value = zero_vector<ncomps>();
-      auto weight_sum = 0.0;
-      for (auto kd_dom = kds2doms.a2ab[kd];
-           kd_dom < kds2doms.a2ab[kd + 1]; ++kd_dom) {
-        auto dom = kds2doms.ab2b[kd_dom];
-        for (int dom_pt = 0; dom_pt < Elem::points; ++dom_pt) {
-          auto old_point = dom * Elem::points + dom_pt;
-          auto old_weight = weighter.get_weight(old_point);
-          weight_sum += old_weight;
-          for (int comp = 0; comp < ncomps; ++comp) {
-            value[comp] += old_weight * old_data[old_point * ncomps + comp];
+      for (int first = 0; first < width; first += remap_chunk_width) {
+        auto const ncomps = Omega_h::min2(remap_chunk_width, width - first);
+        double values[remap_chunk_width];
+        for (int comp = 0; comp < ncomps; ++comp) values[comp] = 0.0;
+        auto weight_sum = 0.0;
+        for (auto kd_dom = kds2doms.a2ab[kd];
+             kd_dom < kds2doms.a2ab[kd + 1]; ++kd_dom) {
+          auto dom = kds2doms.ab2b[kd_dom];
+          for (int dom_pt = 0; dom_pt < Elem::points; ++dom_pt) {
+            auto old_point = dom * Elem::points + dom_pt;
+            auto const weight = weighter.get_weight(old_point);
+            weight_sum += weight;
+            for (int comp = 0; comp < ncomps; ++comp) {
+              values[comp] += weight * old_data[old_point * width + first + comp];
+            }
           }
         }
-      }
-      for (int comp = 0; comp < ncomps; ++comp) {
-        value[comp] /= weight_sum;
-      }
-      for (auto prod = keys2prods[key]; prod < keys2prods[key + 1]; ++prod) {
-        auto new_elem = prods2new_ents[prod];
-        for (int prod_pt = 0; prod_pt < Elem::points; ++prod_pt) {
-          auto new_point = new_elem * Elem::points + prod_pt;
-          for (int comp = 0; comp < ncomps; ++comp) {
-            new_data[new_point * ncomps + comp] = value[comp];
+        for (auto prod = keys2prods[key]; prod < keys2prods[key + 1]; ++prod) {
+          auto new_elem = prods2new_ents[prod];
+          for (int prod_pt = 0; prod_pt < Elem::points; ++prod_pt) {
+            auto new_point = new_elem * Elem::points + prod_pt;
+            for (int comp = 0; comp < ncomps; ++comp) {
+              new_data[new_point * width + first + comp] = values[comp] / weight_sum;
+            }
           }
         }
       }
@@ -251,145 +368,92 @@ struct Remap : public RemapBase {
     parallel_for("weighted remap", keys2kds.size(), std::move(new_functor));
     new_mesh.add_tag(new_mesh.dim(), tag->name(), tag->ncomps(), Omega_h::read(new_data));
   }
-  template <class Weighter>
-  void refine_point_remap(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh, int key_dim, int prod_dim,
-      Omega_h::LOs keys2kds, Omega_h::LOs keys2prods, Omega_h::LOs prods2new_ents,
-      Omega_h::LOs same_ents2old_ents, Omega_h::LOs same_ents2new_ents,
-      std::string const& name) {
-    auto tag = old_mesh.get_tag<double>(prod_dim, name);
-    auto ncomps = divide_no_remainder(tag->ncomps(), Elem::points);
-    if (ncomps == 1) {
-      refine_point_remap_ncomps<Weighter, 1>(old_mesh, new_mesh, key_dim, prod_dim,
-          keys2kds, keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents, tag);
-    } else if (ncomps == Omega_h::symm_ncomps(Elem::dim)) {
-      refine_point_remap_ncomps<Weighter, Omega_h::symm_ncomps(Elem::dim)>(old_mesh, new_mesh, key_dim, prod_dim,
-          keys2kds, keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents, tag);
-    } else if (ncomps == Omega_h::square(Elem::dim)) {
-      refine_point_remap_ncomps<Weighter, Omega_h::square(Elem::dim)>(old_mesh, new_mesh, key_dim, prod_dim,
-          keys2kds, keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents, tag);
-    } else {
-      Omega_h_fail("unexpected refine point remap ncomps %d\n", ncomps);
-    }
-  }
-  template <class Weighter>
-  void swap_point_remap(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh, int key_dim, int prod_dim,
-      Omega_h::LOs keys2kds, Omega_h::LOs keys2prods, Omega_h::LOs prods2new_ents,
-      Omega_h::LOs same_ents2old_ents, Omega_h::LOs same_ents2new_ents,
-      std::string const& name) {
-    auto tag = old_mesh.get_tag<double>(prod_dim, name);
-    auto ncomps = divide_no_remainder(tag->ncomps(), Elem::points);
-    if (ncomps == 1) {
-      swap_point_remap_ncomps<Weighter, 1>(old_mesh, new_mesh, key_dim, prod_dim,
-          keys2kds, keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents, tag);
-    } else if (ncomps == Omega_h::symm_ncomps(Elem::dim)) {
-      swap_point_remap_ncomps<Weighter, Omega_h::symm_ncomps(Elem::dim)>(old_mesh, new_mesh, key_dim, prod_dim,
-          keys2kds, keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents, tag);
-    } else if (ncomps == Omega_h::square(Elem::dim)) {
-      swap_point_remap_ncomps<Weighter, Omega_h::square(Elem::dim)>(old_mesh, new_mesh, key_dim, prod_dim,
-          keys2kds, keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents, tag);
-    } else {
-      Omega_h_fail("unexpected weighted ncomps %d\n", ncomps);
-    }
-  }
   void refine(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh, Omega_h::LOs keys2edges, Omega_h::LOs keys2midverts,
       int prod_dim, Omega_h::LOs keys2prods, Omega_h::LOs prods2new_ents, Omega_h::LOs same_ents2old_ents,
       Omega_h::LOs same_ents2new_ents) override final {
-    if (prod_dim == 0) {
-      for (auto& name : fields_to_remap[RemapType::NODAL]) {
-        auto tag = old_mesh.get_tag<double>(0, name);
-        auto ncomps = tag->ncomps();
-        auto old_data = tag->array();
-        auto new_data = allocate_and_fill_with_same(new_mesh, 0, ncomps, same_ents2old_ents, same_ents2new_ents, old_data);
-        auto old_edges2verts = old_mesh.ask_verts_of(1);
-        auto interp_functor = OMEGA_H_LAMBDA(int key) {
-          auto new_vert = keys2midverts[key];
-          auto old_edge = keys2edges[key];
-          auto old_vert0 = old_edges2verts[old_edge * 2 + 0];
-          auto old_vert1 = old_edges2verts[old_edge * 2 + 1];
-          for (int comp = 0; comp < ncomps; ++comp) {
-            new_data[new_vert * ncomps + comp] =
-              (1.0 / 2.0) *
-              (old_data[old_vert0 * ncomps + comp] +
-               old_data[old_vert1 * ncomps + comp]);
-          }
-        };
-        parallel_for("interpolate nodal data", keys2edges.size(), std::move(interp_functor));
-        new_mesh.add_tag(0, name, ncomps, Omega_h::read(new_data));
-      }
+    if (prod_dim == 0 && packed_fields[RemapType::NODAL].width != 0) {
+      auto tag = old_mesh.get_tag<double>(0, packed_tag_name(RemapType::NODAL));
+      auto ncomps = tag->ncomps();
+      auto old_data = tag->array();
+      auto new_data = allocate_and_fill_with_same(new_mesh, 0, ncomps, same_ents2old_ents, same_ents2new_ents, old_data);
+      auto old_edges2verts = old_mesh.ask_verts_of(1);
+      auto interp_functor = OMEGA_H_LAMBDA(int key) {
+        auto new_vert = keys2midverts[key];
+        auto old_edge = keys2edges[key];
+        auto old_vert0 = old_edges2verts[old_edge * 2 + 0];
+        auto old_vert1 = old_edges2verts[old_edge * 2 + 1];
+        for (int comp = 0; comp < ncomps; ++comp) {
+          new_data[new_vert * ncomps + comp] =
+            (1.0 / 2.0) *
+            (old_data[old_vert0 * ncomps + comp] +
+             old_data[old_vert1 * ncomps + comp]);
+        }
+      };
+      parallel_for("interpolate nodal data", keys2edges.size(), std::move(interp_functor));
+      new_mesh.add_tag(0, tag->name(), ncomps, Omega_h::read(new_data));
     }
     if (prod_dim == old_mesh.dim()) {
       remap_shape(old_mesh, new_mesh, keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents);
-      for (auto& name : fields_to_remap[RemapType::PER_UNIT_VOLUME]) {
-        refine_point_remap<VolumeWeighter>(old_mesh, new_mesh, 1, prod_dim, keys2edges, keys2prods, prods2new_ents,
-            same_ents2old_ents, same_ents2new_ents, name);
-      }
-      for (auto& name : fields_to_remap[RemapType::PER_UNIT_MASS]) {
-        refine_point_remap<MassWeighter>(old_mesh, new_mesh, 1, prod_dim, keys2edges, keys2prods, prods2new_ents,
-            same_ents2old_ents, same_ents2new_ents, name);
-      }
+      refine_point_remap<MassWeighter>(old_mesh, new_mesh, 1, prod_dim, keys2edges, keys2prods, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, RemapType::PER_UNIT_MASS);
+      refine_point_remap<VolumeWeighter>(old_mesh, new_mesh, 1, prod_dim, keys2edges, keys2prods, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, RemapType::PER_UNIT_VOLUME);
       remap_old_class_id(old_mesh, new_mesh, prods2new_ents, same_ents2old_ents, same_ents2new_ents);
     }
   }
   void coarsen(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh,
       Omega_h::LOs /*keys2verts*/, Omega_h::Adj keys2doms,
       int prod_dim, Omega_h::LOs prods2new_ents, Omega_h::LOs same_ents2old_ents, Omega_h::LOs same_ents2new_ents) override final {
-    if (prod_dim == 0) {
-      for (auto& name : fields_to_remap[RemapType::NODAL]) {
-        auto tag = old_mesh.get_tag<double>(0, name);
-        auto ncomps = tag->ncomps();
-        auto old_data = tag->array();
-        auto new_data = allocate_and_fill_with_same(
-            new_mesh, 0, ncomps, same_ents2old_ents, same_ents2new_ents, old_data);
-        new_mesh.add_tag(0, name, ncomps, Omega_h::read(new_data));
-      }
+    if (prod_dim == 0 && packed_fields[RemapType::NODAL].width != 0) {
+      auto tag = old_mesh.get_tag<double>(0, packed_tag_name(RemapType::NODAL));
+      auto ncomps = tag->ncomps();
+      auto old_data = tag->array();
+      auto new_data = allocate_and_fill_with_same(
+          new_mesh, 0, ncomps, same_ents2old_ents, same_ents2new_ents, old_data);
+      new_mesh.add_tag(0, tag->name(), ncomps, Omega_h::read(new_data));
     }
     if (prod_dim == old_mesh.dim()) {
       remap_shape(old_mesh, new_mesh, keys2doms.a2ab, prods2new_ents, same_ents2old_ents, same_ents2new_ents);
-      for (auto& name : fields_to_remap[RemapType::PER_UNIT_VOLUME]) {
-        coarsen_point_remap(old_mesh, new_mesh, prod_dim,
-            keys2doms.a2ab, keys2doms.ab2b, prods2new_ents,
-            same_ents2old_ents, same_ents2new_ents,
-            name);
-      }
-      for (auto& name : fields_to_remap[RemapType::PER_UNIT_MASS]) {
+      for (auto type : {RemapType::PER_UNIT_VOLUME, RemapType::PER_UNIT_MASS}) {
         coarsen_point_remap(old_mesh, new_mesh, prod_dim,
             keys2doms.a2ab, keys2doms.ab2b, prods2new_ents,
             same_ents2old_ents, same_ents2new_ents,
-            name);
+            type);
       }
       remap_old_class_id(old_mesh, new_mesh, prods2new_ents, same_ents2old_ents, same_ents2new_ents);
     }
   }
   void swap_copy_verts(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh) override final {
-    for (auto& name : fields_to_remap[RemapType::NODAL]) {
-      auto tag = old_mesh.get_tag<double>(0, name);
-      auto ncomps = tag->ncomps();
-      auto old_data = tag->array();
-      new_mesh.add_tag(0, name, ncomps, old_data);
-    }
+    if (packed_fields[RemapType::NODAL].width == 0) return;
+    auto tag = old_mesh.get_tag<double>(0, packed_tag_name(RemapType::NODAL));
+    new_mesh.add_tag(0, tag->name(), tag->ncomps(), tag->array());
   }
   void swap(Omega_h::Mesh& old_mesh, Omega_h::Mesh& new_mesh, int prod_dim, Omega_h::LOs keys2edges,
       Omega_h::LOs keys2prods, Omega_h::LOs prods2new_ents, Omega_h::LOs same_ents2old_ents, Omega_h::LOs same_ents2new_ents) override final {
     if (prod_dim == old_mesh.dim()) {
       remap_shape(old_mesh, new_mesh, keys2prods, prods2new_ents, same_ents2old_ents, same_ents2new_ents);
-      for (auto& name : fields_to_remap[RemapType::PER_UNIT_VOLUME]) {
-        swap_point_remap<VolumeWeighter>(old_mesh, new_mesh, 1, prod_dim, keys2edges, keys2prods, prods2new_ents,
-            same_ents2old_ents, same_ents2new_ents, name);
-      }
-      for (auto& name : fields_to_remap[RemapType::PER_UNIT_MASS]) {
-        swap_point_remap<MassWeighter>(old_mesh, new_mesh, 1, prod_dim, keys2edges, keys2prods, prods2new_ents,
-            same_ents2old_ents, same_ents2new_ents, name);
-      }
+      swap_point_remap<MassWeighter>(old_mesh, new_mesh, 1, prod_dim, keys2edges, keys2prods, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, RemapType::PER_UNIT_MASS);
+      swap_point_remap<VolumeWeighter>(old_mesh, new_mesh, 1, prod_dim, keys2edges, keys2prods, prods2new_ents,
+          same_ents2old_ents, same_ents2new_ents, RemapType::PER_UNIT_VOLUME);
       remap_old_class_id(old_mesh, new_mesh, prods2new_ents, same_ents2old_ents, same_ents2new_ents);
     }
   }
   void after_adapt() override final {
     Omega_h::vtk::write_vtu("debug.vtu", &sim.disc.mesh);
     sim.fields[sim.position].storage = Omega_h::deep_copy(sim.disc.mesh.coords());
-    sim.fields.copy_from_omega_h(sim.disc, field_indices_to_remap);
-    sim.fields.remove_from_omega_h(sim.disc, field_indices_to_remap);
-    for (auto& name : fields_to_remap[RemapType::POSITIVE_DETERMINANT]) {
-      auto fi = sim.fields.find(name);
+    sim.fields.copy_from_omega_h(sim.disc, shape_field_indices);
+    sim.fields.remove_from_omega_h(sim.disc, shape_field_indices);
+    for (auto& type_packed : packed_fields) {
+      auto const type = type_packed.first;
+      if (type_packed.second.width == 0) continue;
+      auto const ent_dim = packed_ent_dim(sim, type);
+      auto const name = packed_tag_name(type);
+      unpack_fields(sim, type, type_packed.second,
+          sim.disc.mesh.get_array<double>(ent_dim, name));
+      sim.disc.mesh.remove_tag(ent_dim, name);
+    }
+    for (auto fi : positive_determinant_field_indices) {
       auto points_to_F = sim.getset(fi);
       auto npoints = sim.fields[fi].support->count();
       auto functor = OMEGA_H_LAMBDA(int point) {
@@ -10,10 +10,24 @@ namespace lgr {
 
 struct Simulation;
 
+// all fields that share a RemapType are interleaved into one
+// array (one tag on the Omega_h mesh) while adapting, so that each
+// transfer is a single traversal of the adjacency arrays
+struct PackedFields {
+  std::vector<FieldIndex> field_indices;
+  // offset of each field's components within one packed entry
+  std::vector<int> offsets;
+  // number of packed components per node or per integration point
+  int width;
+  PackedFields():width(0) {}
+  int offset_of(FieldIndex fi) const;
+};
+
 struct RemapBase : public Omega_h::UserTransfer {
   Simulation& sim;
-  std::map<RemapType, std::vector<std::string>> fields_to_remap;
-  std::vector<FieldIndex> field_indices_to_remap;
+  std::map<RemapType, PackedFields> packed_fields;
+  std::vector<FieldIndex> shape_field_indices;
+  std::vector<FieldIndex> positive_determinant_field_indices;
   RemapBase(Simulation& sim_in);
   virtual void out_of_line_virtual_method();
   virtual void before_adapt() = 0;
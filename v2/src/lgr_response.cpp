@@ -10,4 +10,6 @@ Response::Response(Simulation& sim_in, Teuchos::ParameterList& pl)
 
 void Response::out_of_line_virtual_method() {}
 
+void Response::before_remap() {}
+
 }
@@ -15,6 +15,8 @@ struct Response {
   virtual ~Response() = default;
   virtual void out_of_line_virtual_method();
   virtual void respond() = 0;
+  // called right before adapt or ALE remap the fields
+  virtual void before_remap();
 };
 
 }
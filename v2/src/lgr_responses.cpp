@@ -4,6 +4,7 @@
 #include <lgr_cmdline_hist.hpp>
 #include <lgr_csv_hist.hpp>
 #include <lgr_comparison.hpp>
+#include <lgr_probe_hist.hpp>
 
 namespace lgr {
 
@@ -20,6 +21,10 @@ void Responses::evaluate() {
   }
 }
 
+void Responses::before_remap() {
+  for (auto& response : storage) response->before_remap();
+}
+
 double Responses::next_event(double time) {
   double out = std::numeric_limits<double>::max();
   for (auto& response : storage) {
@@ -34,6 +39,7 @@ ResponseFactories get_builtin_response_factories() {
   out["command line history"] = cmdline_hist_factory;
   out["CSV history"] = csv_hist_factory;
   out["comparison"] = comparison_factory;
+  out["probe history"] = probe_hist_factory;
   return out;
 }
 
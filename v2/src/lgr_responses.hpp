@@ -14,6 +14,7 @@ struct Responses {
   Responses(Simulation& sim_in);
   void setup(Teuchos::ParameterList& pl);
   void evaluate();
+  void before_remap();
   double next_event(double time);
 };
 
@@ -3,6 +3,9 @@
 #include <lgr_hydro.hpp>
 #include <Omega_h_stack.hpp>
 #include <lgr_flood.hpp>
+#include <lgr_relaxation.hpp>
+#include <lgr_mass_scaling.hpp>
+#include <lgr_ale.hpp>
 
 namespace lgr {
 
@@ -26,22 +29,45 @@ static void initialize_state(Simulation& sim) {
 }
 
 template <class Elem>
-static void close_state(Simulation& sim) {
+static void compute_state(Simulation& sim) {
   OMEGA_H_TIME_FUNCTION;
   sim.models.at_field_update();
   sim.models.after_field_update();
   sim.models.at_material_model();
   sim.models.after_material_model();
   compute_point_time_steps<Elem>(sim);
+  if (sim.mass_scaling.enabled) {
+    compute_selective_mass_scale<Elem>(sim);
+    lump_masses<Elem>(sim);
+  }
   compute_stress_divergence<Elem>(sim);
   // tractions will go here
   apply_force_conditions(sim);
   compute_nodal_acceleration<Elem>(sim);
   apply_acceleration_conditions(sim);
+}
+
+template <class Elem>
+static void close_state(Simulation& sim) {
+  OMEGA_H_TIME_FUNCTION;
+  compute_state<Elem>(sim);
   update_cpu_time(sim);
   sim.responses.evaluate();
 }
 
+// after the mesh or the fields on it were changed in place,
+// recompute everything derived from them with a zero-length step.
+// this is not a time step, so the step counter is left alone.
+template <class Elem>
+static void close_remapped_state(Simulation& sim) {
+  OMEGA_H_TIME_FUNCTION;
+  lump_masses<Elem>(sim);
+  sim.prev_time = sim.time;
+  sim.prev_dt = sim.dt;
+  sim.dt = 0.0;
+  close_state<Elem>(sim);
+}
+
 template <class Elem>
 static void run_simulation(Simulation& sim) {
   OMEGA_H_TIME_FUNCTION;
@@ -49,13 +75,13 @@ static void run_simulation(Simulation& sim) {
   close_state<Elem>(sim);
   while (sim.time < sim.end_time && sim.step < sim.end_step) {
     if (sim.adapter.adapt()) {
+      sim.balancer.balance();
       sim.flooder.flood();
-      lump_masses<Elem>(sim);
-      sim.prev_time = sim.time;
-      sim.prev_dt = sim.dt;
-      sim.dt = 0.0;
+      // output of the adapted mesh gets its own step
       ++sim.step;
-      close_state<Elem>(sim);
+      close_remapped_state<Elem>(sim);
+    } else if (smooth_and_advect<Elem>(sim)) {
+      close_remapped_state<Elem>(sim);
     }
     update_time(sim);
     sim.models.before_position_update();
@@ -68,6 +94,76 @@ static void run_simulation(Simulation& sim) {
   }
 }
 
+// the fictitious masses follow the stable time step of the deforming mesh,
+// so they are rescaled from the latest point time steps
+template <class Elem>
+static void update_relaxation_masses(Simulation& sim) {
+  OMEGA_H_TIME_FUNCTION;
+  compute_relaxation_mass_scale<Elem>(sim);
+  lump_masses<Elem>(sim);
+  compute_nodal_acceleration<Elem>(sim);
+  apply_acceleration_conditions(sim);
+}
+
+// pseudo-time stepping towards static equilibrium.
+// sim.time advances by the pseudo time step, so conditions and responses
+// see a pseudo time; loads that ramp in time should be given in those units.
+// the responses are evaluated after the residual of each step is known.
+template <class Elem>
+static void run_dynamic_relaxation(Simulation& sim) {
+  OMEGA_H_TIME_FUNCTION;
+  auto& relaxation = sim.relaxation;
+  initialize_state<Elem>(sim);
+  compute_state<Elem>(sim);
+  update_relaxation_masses<Elem>(sim);
+  relaxation.reference_residual = compute_residual_norm<Elem>(sim);
+  relaxation.residual = relaxation.reference_residual;
+  relaxation.kinetic_energy = 0.0;
+  update_cpu_time(sim);
+  sim.responses.evaluate();
+  while (sim.time < sim.end_time && sim.step < sim.end_step &&
+         !relaxation.has_converged()) {
+    sim.prev_time = sim.time;
+    sim.prev_dt = sim.dt;
+    sim.dt = relaxation.time_step;
+    sim.time = sim.prev_time + sim.dt;
+    sim.models.before_position_update();
+    update_position<Elem>(sim);
+    update_configuration<Elem>(sim);
+    ++sim.step;
+    compute_state<Elem>(sim);
+    if (relaxation.is_mass_update_due()) update_relaxation_masses<Elem>(sim);
+    correct_velocity<Elem>(sim);
+    sim.models.after_correction();
+    auto const kinetic_energy = compute_kinetic_energy<Elem>(sim);
+    if (kinetic_energy < relaxation.kinetic_energy) {
+      zero_velocity(sim);
+      relaxation.kinetic_energy = 0.0;
+      ++relaxation.damping_resets;
+    } else {
+      relaxation.kinetic_energy = kinetic_energy;
+    }
+    relaxation.residual = compute_residual_norm<Elem>(sim);
+    relaxation.reference_residual =
+      Omega_h::max2(relaxation.reference_residual, relaxation.residual);
+    update_cpu_time(sim);
+    sim.responses.evaluate();
+  }
+}
+
+void run(Simulation& sim) {
+  OMEGA_H_TIME_FUNCTION;
+#define LGR_EXPL_INST(Elem) \
+  if (sim.elem_name == Elem::name()) { \
+    if (sim.relaxation.enabled) run_dynamic_relaxation<Elem>(sim); \
+    else run_simulation<Elem>(sim); \
+    return; \
+  }
+  LGR_EXPL_INST_ELEMS
+#undef LGR_EXPL_INST
+  Omega_h_fail("Unknown element type \"%s\"\n", sim.elem_name.c_str());
+}
+
 void run(Omega_h::CommPtr comm, Teuchos::ParameterList& pl,
     Factories&& factories_in) {
   OMEGA_H_TIME_FUNCTION;
@@ -79,7 +175,7 @@ void run(Omega_h::CommPtr comm, Teuchos::ParameterList& pl,
   if (elem == Elem::name()) { \
     sim.set_elem<Elem>(); \
     sim.setup(pl); \
-    run_simulation<Elem>(sim); \
+    run(sim); \
     return; \
   }
   LGR_EXPL_INST_ELEMS
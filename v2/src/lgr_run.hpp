@@ -6,6 +6,11 @@
 
 namespace lgr {
 
+struct Simulation;
+
+// runs a simulation that has already been set up to completion
+void run(Simulation& sim);
+
 void run(Omega_h::CommPtr comm, Teuchos::ParameterList& pl,
     Factories&& model_factories = Factories());
 
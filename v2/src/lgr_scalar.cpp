@@ -12,6 +12,8 @@ Scalar::Scalar(Simulation& sim_in, std::string const& name_in)
 
 void Scalar::out_of_line_virtual_method() {}
 
+void Scalar::before_remap() {}
+
 double Scalar::ask_value() {
   if (sim.time != cached_time_) {
     value_ = this->compute_value();
@@ -13,6 +13,8 @@ struct Scalar {
   virtual ~Scalar() = default;
   virtual void out_of_line_virtual_method();
   double ask_value();
+  // called right before adapt or ALE remap the fields
+  virtual void before_remap();
  protected:
   Simulation& sim;
   virtual double compute_value() = 0;
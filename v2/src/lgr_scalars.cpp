@@ -1,6 +1,7 @@
 #include <lgr_scalars.hpp>
 #include <lgr_simulation.hpp>
 #include <lgr_node_scalar.hpp>
+#include <lgr_probe_scalar.hpp>
 #include <lgr_l2_error.hpp>
 
 namespace lgr {
@@ -16,11 +17,20 @@ double Scalars::ask_value(std::string const& name) {
   if (name == "time") return sim.time;
   if (name == "dt") return sim.dt;
   if (name == "step") return double(sim.step);
+  if (name == "load imbalance") return sim.balancer.imbalance;
+  if (name == "residual norm") return sim.relaxation.residual;
+  if (name == "kinetic energy") return sim.relaxation.kinetic_energy;
+  if (name == "damping resets") return double(sim.relaxation.damping_resets);
+  if (name == "added mass fraction") return sim.mass_scaling.added_mass_fraction;
   auto it = by_name.find(name);
   if (it == by_name.end()) Omega_h_fail("Request for undefined scalar \"%s\"\n", name.c_str());
   return (*it)->ask_value();
 }
 
+void Scalars::before_remap() {
+  for (auto& scalar : storage) scalar->before_remap();
+}
+
 void Scalars::setup(Teuchos::ParameterList& pl) {
   ::lgr::setup(sim.factories.scalar_factories, sim, pl, storage, "scalar");
   for (auto& ptr : storage) {
@@ -31,6 +41,7 @@ void Scalars::setup(Teuchos::ParameterList& pl) {
 ScalarFactories get_builtin_scalar_factories() {
   ScalarFactories out;
   out["node"] = node_scalar_factory;
+  out["probe"] = probe_scalar_factory;
   out["L2 error"] = l2_error_factory;
   return out;
 }
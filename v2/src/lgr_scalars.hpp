@@ -20,6 +20,7 @@ struct Scalars {
   Scalars(Simulation& sim_in);
   void setup(Teuchos::ParameterList& pl);
   double ask_value(std::string const& name);
+  void before_remap();
 };
 
 ScalarFactories get_builtin_scalar_factories();
@@ -1,6 +1,7 @@
 #include <lgr_simulation.hpp>
 #include <Omega_h_array_ops.hpp>
 #include <Omega_h_stack.hpp>
+#include <sys/stat.h>
 
 namespace lgr {
 
@@ -28,6 +29,11 @@ Omega_h::Read<double> Simulation::get(FieldIndex fi) {
   return fields.get(fi);
 }
 
+std::string Simulation::output_path(std::string const& path) {
+  if (output_directory.empty()) return path;
+  return output_directory + "/" + path;
+}
+
 Omega_h::Write<double> Simulation::set(FieldIndex fi) {
   return fields.set(fi);
 }
@@ -102,12 +108,33 @@ Simulation::Simulation(Omega_h::CommPtr comm_in, Factories&& factories_in)
  ,responses(*this)
  ,adapter(*this)
  ,flooder(*this)
+ ,balancer(*this)
+ ,relaxation(*this)
+ ,mass_scaling(*this)
+ ,ale(*this)
 {
 }
 
 void Simulation::setup(Teuchos::ParameterList& pl)
 {
   OMEGA_H_TIME_FUNCTION;
+  setup_constants(pl);
+  // set up mesh
+  disc.setup(comm, pl.sublist("mesh"));
+  // done setting up mesh
+  setup_on_disc(pl);
+}
+
+void Simulation::setup(Teuchos::ParameterList& pl, Disc const& loaded_disc)
+{
+  OMEGA_H_TIME_FUNCTION;
+  setup_constants(pl);
+  disc.setup(loaded_disc);
+  setup_on_disc(pl);
+}
+
+void Simulation::setup_constants(Teuchos::ParameterList& pl)
+{
   start_cpu_time_point = Omega_h::now();
   // set up constants
   cpu_time = pl.get<double>("start CPU time", 0.0);
@@ -121,10 +148,16 @@ void Simulation::setup(Teuchos::ParameterList& pl)
   cfl = pl.get<double>("CFL", 0.9);
   step = pl.get<int>("start step", 0);
   end_step = pl.get<int>("end step", std::numeric_limits<int>::max());
+  output_directory = pl.get<std::string>("output directory", "");
+  if (!output_directory.empty()) {
+    if (comm->rank() == 0) ::mkdir(output_directory.c_str(), 0755);
+    comm->barrier();
+  }
   // done setting up constants
-  // set up mesh
-  disc.setup(comm, pl.sublist("mesh"));
-  // done setting up mesh
+}
+
+void Simulation::setup_on_disc(Teuchos::ParameterList& pl)
+{
   // start defining fields
   fields.setup(pl);
   auto& everywhere = disc.covering_class_names();
@@ -160,6 +193,8 @@ void Simulation::setup(Teuchos::ParameterList& pl)
   // done defining fields
   models.setup_material_models_and_modifiers(pl);
   flooder.setup(pl);
+  relaxation.setup(pl);
+  mass_scaling.setup(pl);
   models.setup_field_updates();
   finalize_definitions();
   // setup conditions
@@ -178,6 +213,8 @@ void Simulation::setup(Teuchos::ParameterList& pl)
   responses.setup(pl.sublist("responses"));
   // done setting up responses
   adapter.setup(pl);
+  balancer.setup(pl);
+  ale.setup(pl);
   // echo parameters
   if (pl.get<bool>("echo parameters", false)) {
     Omega_h::echo_parameters(std::cout, pl);
@@ -226,6 +263,11 @@ void update_cpu_time(Simulation& sim) {
   sim.cpu_time = now - sim.start_cpu_time_point;
 }
 
+void before_remap(Simulation& sim) {
+  sim.scalars.before_remap();
+  sim.responses.before_remap();
+}
+
 template <class Elem>
 void Simulation::set_elem() {
   elem_name = Elem::name();
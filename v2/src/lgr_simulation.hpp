@@ -13,7 +13,12 @@
 #include <lgr_responses.hpp>
 #include <lgr_adapt.hpp>
 #include <lgr_flood.hpp>
+#include <lgr_balance.hpp>
+#include <lgr_relaxation.hpp>
+#include <lgr_mass_scaling.hpp>
+#include <lgr_ale.hpp>
 #include <Omega_h_timer.hpp>
+#include <vector>
 
 namespace lgr {
 
@@ -30,10 +35,18 @@ struct Simulation {
   Responses responses;
   Adapter adapter;
   Flooder flooder;
+  Balancer balancer;
+  Relaxation relaxation;
+  MassScaling mass_scaling;
+  Ale ale;
   Simulation(Omega_h::CommPtr comm, Factories&& factories_in);
   template <class Elem>
   void set_elem();
   void setup(Teuchos::ParameterList& pl);
+  // set up on a mesh that was already loaded and prepared, e.g. by an ensemble
+  void setup(Teuchos::ParameterList& pl, Disc const& loaded_disc);
+  void setup_constants(Teuchos::ParameterList& pl);
+  void setup_on_disc(Teuchos::ParameterList& pl);
   int dim();
   int nodes();
   int elems();
@@ -43,6 +56,8 @@ struct Simulation {
   void finalize_definitions();
   bool has(FieldIndex fi);
   Omega_h::Read<double> get(FieldIndex fi);
+  // where a response should write the file it was given
+  std::string output_path(std::string const& path);
   Omega_h::Write<double> set(FieldIndex fi);
   Omega_h::Write<double> getset(FieldIndex fi);
   MappedRead get(FieldIndex fi, Subset* subset);
@@ -79,10 +94,15 @@ struct Simulation {
   FieldIndex nodal_mass;
   FieldIndex traction;
   FieldIndex point_time_step;
+  FieldIndex mass_scale;
+  // element nodal force fields registered by models, summed into force
+  std::vector<FieldIndex> element_forces;
   Omega_h::Now start_cpu_time_point;
   double prev_cpu_time;
   double cpu_time;
   double min_dt;
+  // prefixed to the paths of all outputs, empty for the working directory
+  std::string output_directory;
 };
 
 void apply_conditions(Simulation& sim,
@@ -91,6 +111,9 @@ void apply_conditions(Simulation& sim);
 
 void update_time(Simulation& sim);
 void update_cpu_time(Simulation& sim);
+// lets scalars and responses see the state right before adapt or ALE
+// move the mesh under the material
+void before_remap(Simulation& sim);
 
 #define LGR_EXPL_INST(Elem) \
 extern template void Simulation::set_elem<Elem>();
@@ -3,16 +3,21 @@
 #include <lgr_field_index.hpp>
 #include <lgr_response.hpp>
 #include <lgr_simulation.hpp>
+#include <lgr_for.hpp>
+#include <Omega_h_map.hpp>
 
 namespace lgr {
 
 struct VtkOutput : public Response {
   std::vector<FieldIndex> field_indices;
+  // fields with several integration points per element are shown
+  // as their element averages
+  std::vector<FieldIndex> averaged_field_indices;
   Omega_h::vtk::Writer writer;
   Omega_h::TagSet tags;
   VtkOutput(Simulation& sim_in, Teuchos::ParameterList& pl)
     :Response(sim_in, pl)
-    ,writer(pl.get<std::string>("path", "lgr_viz"), &sim.disc.mesh, sim.dim(), sim.time, Omega_h::vtk::dont_compress)
+    ,writer(sim_in.output_path(pl.get<std::string>("path", "lgr_viz")), &sim.disc.mesh, sim.dim(), sim.time, Omega_h::vtk::dont_compress)
   {
     auto stdim = std::size_t(sim.dim());
     std::map<std::string, std::size_t> omega_h_adapt_tags = {{"quality", stdim}, {"metric", 0}};
@@ -44,12 +49,10 @@ struct VtkOutput : public Response {
       if (support->subset->entity_type == NODES) {
         tags[0].insert(field_name);
       } else if (support->subset->entity_type == ELEMS) {
+        tags[std::size_t(sim.dim())].insert(field_name);
         if (support->on_points() && (sim.disc.points_per_ent(ELEMS) > 1)) {
-          Omega_h_fail("\"%s\" is on integration points, and there is more than one per element, "
-              "and Dan hasn't coded support for visualizing that yet!\n",
-              field_name.c_str());
-        } else {
-          tags[std::size_t(sim.dim())].insert(field_name);
+          averaged_field_indices.push_back(fi);
+          continue;
         }
       } else {
         Omega_h_fail("\"%s\" is not on nodes or elements, VTK can't visualize it!\n",
@@ -60,10 +63,37 @@ struct VtkOutput : public Response {
   }
   void out_of_line_virtual_method() override;
   void respond() override final {
-    sim.disc.mesh.set_coords(sim.get(sim.position)); // linear specific!
+    sim.disc.mesh.set_coords(sim.disc.vertex_values(sim.get(sim.position), sim.dim()));
     sim.fields.copy_to_omega_h(sim.disc, field_indices);
+    for (auto fi : averaged_field_indices) add_averaged_tag(fi);
     writer.write(sim.step, sim.time, tags);
     sim.fields.remove_from_omega_h(sim.disc, field_indices);
+    sim.fields.remove_from_omega_h(sim.disc, averaged_field_indices);
+  }
+  void add_averaged_tag(FieldIndex fi) {
+    auto& field = sim.fields[fi];
+    auto const points = sim.disc.points_per_ent(ELEMS);
+    auto const data = sim.get(fi);
+    auto const nelems = sim.disc.count(ELEMS);
+    auto& mapping = field.support->subset->mapping;
+    auto const nsubset_elems = mapping.is_identity ? nelems : mapping.things.size();
+    auto const ncomps = Omega_h::divide_no_remainder(data.size(), nsubset_elems * points);
+    auto const averages = Omega_h::Write<double>(nsubset_elems * ncomps);
+    auto functor = OMEGA_H_LAMBDA(int elem) {
+      for (int comp = 0; comp < ncomps; ++comp) {
+        double sum = 0.0;
+        for (int pt = 0; pt < points; ++pt) {
+          sum += data[(elem * points + pt) * ncomps + comp];
+        }
+        averages[elem * ncomps + comp] = sum / points;
+      }
+    };
+    parallel_for("average points", nsubset_elems, std::move(functor));
+    Omega_h::Reals full_data = averages;
+    if (!mapping.is_identity) {
+      full_data = Omega_h::map_onto(full_data, mapping.things, nelems, 0.0, ncomps);
+    }
+    sim.disc.mesh.add_tag(sim.dim(), field.long_name, ncomps, full_data);
   }
 };
 
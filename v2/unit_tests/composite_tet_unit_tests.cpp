@@ -0,0 +1,66 @@
+#include <lgr_element_types.hpp>
+#include "lgr_gtest.hpp"
+
+namespace {
+
+static lgr::Matrix<3, 10> node_coords(bool perturb_edge_nodes) {
+  lgr::Matrix<3, 10> x;
+  x[0] = lgr::Vector<3>({0.0, 0.0, 0.0});
+  x[1] = lgr::Vector<3>({1.0, 0.0, 0.0});
+  x[2] = lgr::Vector<3>({0.0, 1.0, 0.0});
+  x[3] = lgr::Vector<3>({0.0, 0.0, 1.0});
+  for (int edge = 0; edge < 6; ++edge) {
+    auto a = lgr::CompositeTet::edge_vert(edge, 0);
+    auto b = lgr::CompositeTet::edge_vert(edge, 1);
+    x[4 + edge] = (x[a] + x[b]) / 2.0;
+  }
+  if (perturb_edge_nodes) {
+    x[4][1] += 0.02;
+    x[7][0] -= 0.03;
+    x[9][2] += 0.01;
+  }
+  return x;
+}
+
+}
+
+TEST(composite_tet, volume) {
+  auto x = node_coords(false);
+  auto shape = lgr::CompositeTet::shape(x);
+  double volume = 0.0;
+  for (int pt = 0; pt < lgr::CompositeTet::points; ++pt) volume += shape.weights[pt];
+  EXPECT_TRUE(Omega_h::are_close(volume, 1.0 / 6.0));
+}
+
+TEST(composite_tet, linear_patch) {
+  auto x = node_coords(true);
+  auto shape = lgr::CompositeTet::shape(x);
+  lgr::Matrix<3, 3> grad_u;
+  grad_u[0] = lgr::Vector<3>({0.1, 0.2, 0.3});
+  grad_u[1] = lgr::Vector<3>({-0.4, 0.5, 0.6});
+  grad_u[2] = lgr::Vector<3>({0.7, -0.8, 0.9});
+  for (int pt = 0; pt < lgr::CompositeTet::points; ++pt) {
+    auto computed = Omega_h::zero_matrix<3, 3>();
+    for (int node = 0; node < lgr::CompositeTet::nodes; ++node) {
+      auto u = grad_u * x[node];
+      computed = computed + Omega_h::outer_product(u, shape.basis_gradients[pt][node]);
+    }
+    EXPECT_TRUE(Omega_h::are_close(computed, grad_u, 1e-12, 1e-12));
+  }
+}
+
+TEST(composite_tet, partition_of_unity) {
+  double lumped = 0.0;
+  for (int node = 0; node < lgr::CompositeTet::nodes; ++node) {
+    lumped += lgr::CompositeTet::lumping_factor(node);
+  }
+  EXPECT_TRUE(Omega_h::are_close(lumped, 1.0));
+  auto values = lgr::CompositeTet::basis_values();
+  for (int pt = 0; pt < lgr::CompositeTet::points; ++pt) {
+    double sum = 0.0;
+    for (int node = 0; node < lgr::CompositeTet::nodes; ++node) sum += values[pt][node];
+    EXPECT_TRUE(Omega_h::are_close(sum, 1.0));
+  }
+}
+
+ALEXA_END_TESTS
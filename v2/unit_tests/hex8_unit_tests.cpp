@@ -0,0 +1,53 @@
+#include <lgr_element_types.hpp>
+#include "lgr_gtest.hpp"
+
+namespace {
+
+static lgr::Matrix<3, 8> distorted_node_coords() {
+  lgr::Matrix<3, 8> x;
+  for (int node = 0; node < 8; ++node) {
+    for (int axis = 0; axis < 3; ++axis) {
+      x[node][axis] = (lgr::Hex8::parent_coord(node, axis) + 1.0) / 2.0;
+    }
+  }
+  x[6] = x[6] + lgr::Vector<3>({0.1, 0.05, 0.2});
+  x[1][1] -= 0.1;
+  return x;
+}
+
+}
+
+TEST(hex8, unit_cube) {
+  lgr::Matrix<3, 8> x;
+  for (int node = 0; node < 8; ++node) {
+    for (int axis = 0; axis < 3; ++axis) {
+      x[node][axis] = (lgr::Hex8::parent_coord(node, axis) + 1.0) / 2.0;
+    }
+  }
+  auto shape = lgr::Hex8::shape(x);
+  EXPECT_TRUE(Omega_h::are_close(shape.weights[0], 1.0));
+  EXPECT_TRUE(Omega_h::are_close(shape.lengths.time_step_length, 1.0));
+  for (int node = 0; node < 8; ++node) {
+    for (int axis = 0; axis < 3; ++axis) {
+      EXPECT_TRUE(Omega_h::are_close(shape.basis_gradients[0][node][axis],
+            lgr::Hex8::parent_coord(node, axis) / 4.0));
+    }
+  }
+}
+
+TEST(hex8, linear_patch) {
+  auto x = distorted_node_coords();
+  auto shape = lgr::Hex8::shape(x);
+  lgr::Matrix<3, 3> grad_u;
+  grad_u[0] = lgr::Vector<3>({0.1, 0.2, 0.3});
+  grad_u[1] = lgr::Vector<3>({-0.4, 0.5, 0.6});
+  grad_u[2] = lgr::Vector<3>({0.7, -0.8, 0.9});
+  auto computed = Omega_h::zero_matrix<3, 3>();
+  for (int node = 0; node < 8; ++node) {
+    auto u = grad_u * x[node];
+    computed = computed + Omega_h::outer_product(u, shape.basis_gradients[0][node]);
+  }
+  EXPECT_TRUE(Omega_h::are_close(computed, grad_u, 1e-12, 1e-12));
+}
+
+ALEXA_END_TESTS